@@ -0,0 +1,163 @@
+/**
+ * ***README***
+ * Compares two access patterns on a few million particles stored in a std::vector (array of
+ * structures), a soa_vector (examples/soa-vector.hpp) and an aosoa_vector with blocks of 8 and
+ * 16 (examples/aosoa-vector.hpp): a simulation step, which updates the positions of every
+ * particle from their velocities, and updates of all members of particles at random indices.
+ */
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "aosoa-vector.hpp"
+#include "soa-vector.hpp"
+
+struct Particle
+{
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    float charge;
+};
+
+REFL_AUTO(type(Particle), field(x), field(y), field(z), field(vx), field(vy), field(vz), field(mass), field(charge))
+
+template <size_t I>
+using member = refl::trait::get_t<I, refl::member_list<Particle>>;
+
+static constexpr float dt = 0.01f;
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; i++) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() / 10;
+}
+
+void Step(std::vector<Particle>& particles)
+{
+    for (Particle& p : particles) {
+        p.x += p.vx * dt;
+        p.y += p.vy * dt;
+        p.z += p.vz * dt;
+    }
+}
+
+void Step(soa_vector<Particle>& particles)
+{
+    float* x = particles.data(member<0>{});
+    float* y = particles.data(member<1>{});
+    float* z = particles.data(member<2>{});
+    const float* vx = particles.data(member<3>{});
+    const float* vy = particles.data(member<4>{});
+    const float* vz = particles.data(member<5>{});
+    for (size_t i = 0; i < particles.size(); i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        z[i] += vz[i] * dt;
+    }
+}
+
+template <size_t N>
+void Step(aosoa_vector<Particle, N>& particles)
+{
+    for (size_t b = 0; b < particles.block_count(); b++) {
+        auto& block = particles.block(b);
+        for (size_t i = 0; i < N; i++) {
+            block.template get<0>()[i] += block.template get<3>()[i] * dt;
+            block.template get<1>()[i] += block.template get<4>()[i] * dt;
+            block.template get<2>()[i] += block.template get<5>()[i] * dt;
+        }
+    }
+}
+
+// a kick: every member of the particle at each index is read and written
+template <typename Vector>
+void Kick(Vector& particles, const std::vector<uint32_t>& indices)
+{
+    for (uint32_t index : indices) {
+        auto p = particles[index];
+        float scale = p.charge() / p.mass();
+        p.vx(p.vx() + p.x() * scale);
+        p.vy(p.vy() + p.y() * scale);
+        p.vz(p.vz() + p.z() * scale);
+        p.mass(p.mass() + 1);
+    }
+}
+
+void Kick(std::vector<Particle>& particles, const std::vector<uint32_t>& indices)
+{
+    for (uint32_t index : indices) {
+        Particle& p = particles[index];
+        float scale = p.charge / p.mass;
+        p.vx += p.x * scale;
+        p.vy += p.y * scale;
+        p.vz += p.z * scale;
+        p.mass += 1;
+    }
+}
+
+template <typename Vector>
+double Checksum(const Vector& particles)
+{
+    double sum = 0;
+    for (size_t i = 0; i < particles.size(); i++) {
+        Particle p = particles[i];
+        sum += p.x + p.y + p.z + p.vx + p.vy + p.vz + p.mass;
+    }
+    return sum;
+}
+
+int main()
+{
+    const size_t count = 2000000;
+    std::vector<Particle> aos;
+    soa_vector<Particle> soa;
+    aosoa_vector<Particle, 8> aosoa8;
+    aosoa_vector<Particle, 16> aosoa16;
+    for (size_t i = 0; i < count; i++) {
+        float f = static_cast<float>(i % 1000) / 1000;
+        Particle particle{ f, -f, 1, 0.5f, 0.25f, -f, 1 + f, 0.001f };
+        aos.push_back(particle);
+        soa.push_back(particle);
+        aosoa8.push_back(particle);
+        aosoa16.push_back(particle);
+    }
+
+    std::vector<uint32_t> indices;
+    uint32_t state = 12345;
+    for (size_t i = 0; i < count / 4; i++) {
+        state = state * 1664525 + 1013904223;
+        indices.push_back(state % count);
+    }
+
+    double step_seconds[4] = {
+        Measure([&] { Step(aos); }),
+        Measure([&] { Step(soa); }),
+        Measure([&] { Step(aosoa8); }),
+        Measure([&] { Step(aosoa16); }),
+    };
+    double kick_seconds[4] = {
+        Measure([&] { Kick(aos, indices); }),
+        Measure([&] { Kick(soa, indices); }),
+        Measure([&] { Kick(aosoa8, indices); }),
+        Measure([&] { Kick(aosoa16, indices); }),
+    };
+
+    double checksum = Checksum(aos);
+    if (Checksum(soa) != checksum || Checksum(aosoa8) != checksum || Checksum(aosoa16) != checksum) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    const char* names[4] = { "std::vector<Particle>:       ", "soa_vector:                  ", "aosoa_vector, blocks of 8:   ", "aosoa_vector, blocks of 16:  " };
+    std::cout << count << " particles of " << sizeof(Particle) << " bytes, " << indices.size() << " random kicks\n";
+    for (int i = 0; i < 4; i++) {
+        std::cout << names[i] << " step " << static_cast<double>(count) / step_seconds[i] / 1e6 << " M elements/s, "
+            << "kick " << static_cast<double>(indices.size()) / kick_seconds[i] / 1e6 << " M elements/s\n";
+    }
+}
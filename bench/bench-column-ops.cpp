@@ -0,0 +1,146 @@
+/**
+ * ***README***
+ * Compares element-wise operations (scale, add, clamp and sum) on members of a few million
+ * particles, done through their member descriptors (member(value)) on a std::vector (array of
+ * structures), with transform_columns on a soa_vector, and with the SSE/AVX kernels of
+ * examples/column-kernels.hpp (build with -mavx2 for the AVX versions).
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "column-kernels.hpp"
+
+struct Particle
+{
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    float charge;
+    uint64_t id;
+};
+
+REFL_AUTO(type(Particle), field(x), field(y), field(z), field(vx), field(vy), field(vz), field(mass), field(charge), field(id))
+
+template <size_t I>
+using member = refl::trait::get_t<I, refl::member_list<Particle>>;
+
+using x_member = member<0>;
+using vx_member = member<3>;
+using mass_member = member<6>;
+using charge_member = member<7>;
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20; i++) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() / 20;
+}
+
+template <typename Member, typename V>
+column_span<V> Column(soa_vector<Particle>& particles, Member member)
+{
+    return column_span<V>(particles.data(member), particles.size());
+}
+
+int main()
+{
+    const size_t count = 4000000;
+    std::vector<Particle> aos;
+    soa_vector<Particle> lambdas;
+    soa_vector<Particle> kernels;
+    for (uint64_t i = 0; i < count; i++) {
+        float f = static_cast<float>(i % 1000) / 250 - 2;
+        Particle particle{ f, 2, 3, -f, 0.2f, 0.3f, 1 + f / 4, f, i };
+        aos.push_back(particle);
+        lambdas.push_back(particle);
+        kernels.push_back(particle);
+    }
+
+    // the values stay the same after an even number of runs (the factor is volatile, so that
+    // the compiler cannot fold consecutive runs)
+    static volatile float factor_source = -1.0f;
+    double scale[3] = {
+        Measure([&] {
+            float factor = factor_source;
+            for (Particle& particle : aos) mass_member{}(particle) *= factor;
+        }),
+        Measure([&] {
+            float factor = factor_source;
+            transform_columns(lambdas, refl::type_list<mass_member>{}, [=](float& mass) { mass *= factor; });
+        }),
+        Measure([&] {
+            column_kernels::scale(Column<mass_member, float>(kernels, mass_member{}), static_cast<float>(factor_source));
+        }),
+    };
+    double add[3] = {
+        Measure([&] {
+            for (Particle& particle : aos) x_member{}(particle) += vx_member{}(particle);
+        }),
+        Measure([&] {
+            transform_columns(lambdas, refl::type_list<x_member, vx_member>{}, [](float& x, float vx) { x += vx; });
+        }),
+        Measure([&] {
+            column_kernels::add(Column<x_member, float>(kernels, x_member{}), Column<vx_member, float>(kernels, vx_member{}));
+        }),
+    };
+    double clamp[3] = {
+        Measure([&] {
+            for (Particle& particle : aos) {
+                float& charge = charge_member{}(particle);
+                charge = charge < -1 ? -1 : 1 < charge ? 1 : charge;
+            }
+        }),
+        Measure([&] {
+            transform_columns(lambdas, refl::type_list<charge_member>{}, [](float& charge) { charge = charge < -1 ? -1 : 1 < charge ? 1 : charge; });
+        }),
+        Measure([&] {
+            column_kernels::clamp(Column<charge_member, float>(kernels, charge_member{}), -1.0f, 1.0f);
+        }),
+    };
+    float sums[3] = {};
+    double sum[3] = {
+        Measure([&] {
+            float total = 0;
+            for (const Particle& particle : aos) total += mass_member{}(particle);
+            sums[0] = total;
+        }),
+        Measure([&] {
+            float total = 0;
+            transform_columns(lambdas, refl::type_list<mass_member>{}, [&](float mass) { total += mass; });
+            sums[1] = total;
+        }),
+        Measure([&] {
+            sums[2] = column_kernels::sum(Column<mass_member, float>(kernels, mass_member{}));
+        }),
+    };
+
+    for (size_t i = 0; i < count; i++) {
+        Particle a = aos[i], b = lambdas[i], c = kernels[i];
+        if (a.x != b.x || a.x != c.x || a.mass != b.mass || a.mass != c.mass || a.charge != b.charge || a.charge != c.charge) {
+            std::cerr << "Output mismatch!\n";
+            return 1;
+        }
+    }
+    // the kernel adds in a different order
+    if (sums[0] != sums[1] || std::fabs(sums[2] - sums[0]) > 1e-3 * std::fabs(sums[0])) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    auto print = [&](const char* name, const double (&seconds)[3]) {
+        std::cout << name << static_cast<double>(count) / seconds[0] / 1e6 << " / "
+            << static_cast<double>(count) / seconds[1] / 1e6 << " / "
+            << static_cast<double>(count) / seconds[2] / 1e6 << " M elements/s\n";
+    };
+    std::cout << count << " particles, member(value) on std::vector / transform_columns / kernel\n";
+    print("scale: ", scale);
+    print("add:   ", add);
+    print("clamp: ", clamp);
+    print("sum:   ", sum);
+}
@@ -0,0 +1,101 @@
+/**
+ * ***README***
+ * Compares to_columnar and from_columnar from examples/columnar.hpp with copying the rows
+ * into one std::vector per member, row by row, through member(value) (and back), on a few
+ * million rows of numbers, strings and optional values.
+ */
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "columnar.hpp"
+
+struct Tick
+{
+    uint64_t id;
+    uint32_t instrument;
+    double price;
+    double size;
+    int64_t timestamp;
+    std::string venue;
+    std::optional<double> implied_volatility;
+};
+
+REFL_AUTO(type(Tick), field(id), field(instrument), field(price), field(size), field(timestamp), field(venue), field(implied_volatility))
+
+template <typename Member>
+struct make_vector
+{
+    using type = std::vector<columnar_detail::value_type<Member>>;
+};
+
+using row_columns = refl::trait::as_tuple_t<refl::trait::map_t<make_vector, columnar_detail::members_t<Tick>>>;
+
+row_columns CopyRowByRow(const std::vector<Tick>& ticks)
+{
+    row_columns columns;
+    for (const Tick& tick : ticks) {
+        refl::util::for_each(columnar_detail::members<Tick>, [&](auto member) {
+            constexpr auto index = refl::trait::index_of_v<decltype(member), columnar_detail::members_t<Tick>>;
+            std::get<index>(columns).push_back(member(tick));
+        });
+    }
+    return columns;
+}
+
+std::vector<Tick> CopyBackRowByRow(const row_columns& columns)
+{
+    std::vector<Tick> ticks;
+    for (size_t i = 0; i < std::get<0>(columns).size(); i++) {
+        Tick& tick = ticks.emplace_back();
+        refl::util::for_each(columnar_detail::members<Tick>, [&](auto member) {
+            constexpr auto index = refl::trait::index_of_v<decltype(member), columnar_detail::members_t<Tick>>;
+            member(tick) = std::get<index>(columns)[i];
+        });
+    }
+    return ticks;
+}
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<Tick> ticks;
+    for (uint64_t i = 0; i < 4000000; i++) {
+        ticks.push_back(Tick{ i, static_cast<uint32_t>(i % 3000), 100 + static_cast<double>(i % 1000) / 64,
+            static_cast<double>(i % 77) * 0.25, 1600000000000000 + static_cast<int64_t>(i) * 7, i % 2 ? "XNAS" : "BATS",
+            i % 3 ? std::optional<double>(0.2 + static_cast<double>(i % 50) / 100) : std::nullopt });
+    }
+
+    row_columns by_rows;
+    columnar_batch<Tick> batch;
+    std::vector<Tick> rows_back;
+    std::vector<Tick> columns_back;
+    double rows_seconds = Measure([&] { by_rows = CopyRowByRow(ticks); });
+    double columnar_seconds = Measure([&] { batch = to_columnar(ticks); });
+    double rows_back_seconds = Measure([&] { rows_back = CopyBackRowByRow(by_rows); });
+    double columnar_back_seconds = Measure([&] { columns_back = from_columnar(batch); });
+
+    if (batch.get<2>()[123456] != std::get<2>(by_rows)[123456] || batch.get<5>()[777] != ticks[777].venue
+        || batch.get<6>().null_count() != (ticks.size() + 2) / 3 || rows_back.back().venue != columns_back.back().venue
+        || columns_back[123456].implied_volatility != ticks[123456].implied_volatility) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    double rows = static_cast<double>(ticks.size());
+    std::cout << ticks.size() << " rows\n";
+    std::cout << "export, row by row:   " << rows / rows_seconds / 1e6 << " M rows/s\n";
+    std::cout << "to_columnar:          " << rows / columnar_seconds / 1e6 << " M rows/s\n";
+    std::cout << "import, row by row:   " << rows / rows_back_seconds / 1e6 << " M rows/s\n";
+    std::cout << "from_columnar:        " << rows / columnar_back_seconds / 1e6 << " M rows/s\n";
+}
@@ -0,0 +1,91 @@
+/**
+ * ***README***
+ * Compares read_csv and write_csv from examples/csv.hpp on one thread and on all cores
+ * with a hand-written single-threaded parser (std::getline and std::strtod/strtoull),
+ * on a few million rows of numbers and short strings.
+ */
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "csv.hpp"
+
+struct Tick
+{
+    uint64_t id;
+    uint32_t instrument;
+    double price;
+    double size;
+    int64_t timestamp;
+    std::string venue;
+};
+
+REFL_AUTO(type(Tick), field(id), field(instrument), field(price), field(size), field(timestamp), field(venue))
+
+std::vector<Tick> ParseByHand(const std::string& text)
+{
+    std::vector<Tick> ticks;
+    std::istringstream in(text);
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        Tick& tick = ticks.emplace_back();
+        char* pos = line.data();
+        tick.id = std::strtoull(pos, &pos, 10);
+        tick.instrument = static_cast<uint32_t>(std::strtoul(pos + 1, &pos, 10));
+        tick.price = std::strtod(pos + 1, &pos);
+        tick.size = std::strtod(pos + 1, &pos);
+        tick.timestamp = std::strtoll(pos + 1, &pos, 10);
+        tick.venue.assign(pos + 1, line.data() + line.size());
+    }
+    return ticks;
+}
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<Tick> ticks;
+    for (uint64_t i = 0; i < 4000000; i++) {
+        ticks.push_back(Tick{ i, static_cast<uint32_t>(i % 3000), 100 + static_cast<double>(i % 1000) / 64,
+            static_cast<double>(i % 77) * 0.25, 1600000000000000 + static_cast<int64_t>(i) * 7, i % 2 ? "XNAS" : "BATS" });
+    }
+
+    std::string text;
+    double write_single = Measure([&] { write_csv(ticks, text, 1); });
+    std::string parallel_text;
+    double write_parallel = Measure([&] { write_csv(ticks, parallel_text); });
+
+    std::vector<Tick> by_hand;
+    std::vector<Tick> single;
+    std::vector<Tick> parallel;
+    double hand_seconds = Measure([&] { by_hand = ParseByHand(text); });
+    double single_seconds = Measure([&] { single = read_csv<Tick>(text, 1); });
+    double parallel_seconds = Measure([&] { parallel = read_csv<Tick>(text); });
+
+    for (const auto* result : { &by_hand, &single, &parallel }) {
+        if (text != parallel_text || result->size() != ticks.size() || (*result)[123456].price != ticks[123456].price
+            || result->back().timestamp != ticks.back().timestamp || result->back().venue != ticks.back().venue) {
+            std::cerr << "Output mismatch!\n";
+            return 1;
+        }
+    }
+
+    double rows = static_cast<double>(ticks.size());
+    std::cout << ticks.size() << " rows, " << text.size() << " bytes, " << std::thread::hardware_concurrency() << " threads\n";
+    std::cout << "read, hand-written:   " << rows / hand_seconds / 1e6 << " M rows/s\n";
+    std::cout << "read_csv, 1 thread:   " << rows / single_seconds / 1e6 << " M rows/s\n";
+    std::cout << "read_csv, all cores:  " << rows / parallel_seconds / 1e6 << " M rows/s\n";
+    std::cout << "write_csv, 1 thread:  " << rows / write_single / 1e6 << " M rows/s\n";
+    std::cout << "write_csv, all cores: " << rows / write_parallel / 1e6 << " M rows/s\n";
+}
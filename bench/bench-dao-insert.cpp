@@ -0,0 +1,96 @@
+/**
+ * ***README***
+ * Compares inserting rows through examples/dao.hpp one row per statement with inserting them
+ * in batches of 64 and 512 rows, bound column by column. The driver is an in-process fake which
+ * reads every bound value, so the numbers only include the binding and the per-statement overhead
+ * on the client (a real database adds a round trip per statement).
+ */
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "dao.hpp"
+
+struct Order
+{
+    uint64_t id;
+    uint32_t customer;
+    double price;
+    int32_t quantity;
+    std::string note;
+};
+
+REFL_AUTO(
+    type(Order, Table{"Orders"}),
+    field(id, Column{"ID", DataType::ID}),
+    field(customer, Column{"Customer", DataType::INTEGER}),
+    field(price, Column{"Price", DataType::REAL}),
+    field(quantity, Column{"Quantity", DataType::INTEGER}),
+    field(note, Column{"Note", DataType::TEXT})
+)
+
+// Checksums the parameters, as a driver copying them to its send buffer would touch them.
+struct ChecksumDriver
+{
+    uint64_t checksum = 0;
+    size_t statements = 0;
+
+    void execute(std::string_view sql, const column_binding* columns, size_t column_count, size_t rows)
+    {
+        statements++;
+        checksum += sql.size();
+        for (size_t j = 0; j < column_count; j++) {
+            const column_binding& column = columns[j];
+            if (column.data_type == DataType::TEXT) {
+                const char* text = static_cast<const char*>(column.values);
+                for (size_t i = 0; i < rows; i++) {
+                    checksum += column.offsets[i + 1] - column.offsets[i];
+                    checksum += column.offsets[i + 1] != column.offsets[i] ? static_cast<unsigned char>(text[column.offsets[i]]) : 0;
+                }
+            }
+            else {
+                uint64_t bits;
+                for (size_t i = 0; i < rows; i++) {
+                    std::memcpy(&bits, static_cast<const char*>(column.values) + i * 8, 8);
+                    checksum += bits;
+                }
+            }
+        }
+    }
+};
+
+template <size_t BatchSize>
+double Measure(const std::vector<Order>& orders, ChecksumDriver& driver)
+{
+    dao<Order, BatchSize> order_dao;
+    auto start = std::chrono::steady_clock::now();
+    order_dao.insert(driver, orders);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<Order> orders;
+    for (uint64_t i = 0; i < 2000000; i++) {
+        orders.push_back(Order{ i, static_cast<uint32_t>(i % 5000), 10 + static_cast<double>(i % 300) / 4,
+            static_cast<int32_t>(i % 40), i % 3 ? "standard delivery" : "" });
+    }
+
+    ChecksumDriver single, batched, large;
+    double single_seconds = Measure<1>(orders, single);
+    double batched_seconds = Measure<64>(orders, batched);
+    double large_seconds = Measure<512>(orders, large);
+
+    if (single.statements != orders.size() || batched.statements != (orders.size() + 63) / 64 || large.statements != (orders.size() + 511) / 512) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    double rows = static_cast<double>(orders.size());
+    std::cout << orders.size() << " rows\n";
+    std::cout << "1 row per statement:    " << rows / single_seconds / 1e6 << " M rows/s, " << single.statements << " statements\n";
+    std::cout << "64 rows per statement:  " << rows / batched_seconds / 1e6 << " M rows/s, " << batched.statements << " statements\n";
+    std::cout << "512 rows per statement: " << rows / large_seconds / 1e6 << " M rows/s, " << large.statements << " statements\n";
+}
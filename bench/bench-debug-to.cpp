@@ -0,0 +1,75 @@
+/**
+ * ***README***
+ * Compares the throughput of runtime::debug_str, which goes through an std::stringstream,
+ * with runtime::debug_to, which writes into a reusable std::string.
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "refl.hpp"
+
+struct Vec3
+{
+    float x, y, z;
+};
+
+REFL_AUTO(type(Vec3), field(x), field(y), field(z))
+
+struct Entity
+{
+    unsigned id;
+    std::string name;
+    Vec3 position;
+    Vec3 velocity;
+    double mass;
+    bool active;
+    std::vector<int> tags;
+};
+
+REFL_AUTO(type(Entity), field(id), field(name), field(position), field(velocity), field(mass), field(active), field(tags))
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<Entity> entities;
+    for (unsigned i = 0; i < 1000; i++) {
+        entities.push_back(Entity{ i, "entity_" + std::to_string(i), { i * 0.5f, 1.25f, -3.0f }, { 0.1f, 0.2f, 0.3f }, 70.5 + i, i % 2 == 0, { 1, 2, 3 } });
+    }
+
+    constexpr int rounds = 50;
+    for (bool compact : { false, true }) {
+        size_t str_bytes = 0;
+        double str_seconds = Measure([&] {
+            for (int r = 0; r < rounds; r++) {
+                for (const auto& entity : entities) {
+                    str_bytes += refl::runtime::debug_str(entity, compact).size();
+                }
+            }
+        });
+
+        size_t to_bytes = 0;
+        std::string buffer;
+        double to_seconds = Measure([&] {
+            for (int r = 0; r < rounds; r++) {
+                for (const auto& entity : entities) {
+                    buffer.clear();
+                    refl::runtime::debug_to(buffer, entity, compact);
+                    to_bytes += buffer.size();
+                }
+            }
+        });
+
+        std::cout << (compact ? "compact" : "detailed") << ":\n";
+        std::cout << "  debug_str: " << str_bytes / str_seconds / 1e6 << " MB/s\n";
+        std::cout << "  debug_to:  " << to_bytes / to_seconds / 1e6 << " MB/s\n";
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * ***README***
+ * Compares reading a couple of fields from serialized messages with deserialize_binary
+ * (which decodes and copies the whole message) and with the zero-copy binary_view
+ * from examples/binary-serialization.hpp.
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "binary-serialization.hpp"
+
+struct Envelope
+{
+    uint64_t id;
+    uint32_t route;
+    uint32_t flags;
+    std::string sender;
+    std::string topic;
+    std::vector<float> payload;
+    std::vector<std::string> headers;
+};
+
+REFL_AUTO(
+    type(Envelope),
+    field(id),
+    field(route),
+    field(flags),
+    field(sender),
+    field(topic),
+    field(payload),
+    field(headers)
+)
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    constexpr size_t message_count = 10000;
+    std::vector<std::vector<unsigned char>> messages(message_count);
+    for (size_t i = 0; i < message_count; i++) {
+        Envelope envelope{ i, static_cast<uint32_t>(i % 16), 0, "service-" + std::to_string(i % 7),
+            "orders.created.region-" + std::to_string(i % 3), std::vector<float>(256, 1.0f), { "content-type: binary", "trace-id: " + std::to_string(i) } };
+        serialize_binary(envelope, messages[i]);
+    }
+
+    constexpr int rounds = 20;
+
+    size_t owning_matches = 0;
+    double owning_seconds = Measure([&] {
+        Envelope envelope;
+        for (int r = 0; r < rounds; r++) {
+            for (const auto& message : messages) {
+                deserialize_binary(message.data(), message.size(), envelope);
+                owning_matches += envelope.route == 3 && envelope.topic.back() == '1';
+            }
+        }
+    });
+
+    size_t view_matches = 0;
+    double view_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (const auto& message : messages) {
+                binary_view<Envelope> envelope(message.data(), message.size());
+                view_matches += envelope.route() == 3 && envelope.topic().back() == '1';
+            }
+        }
+    });
+
+    if (owning_matches != view_matches) {
+        std::cerr << "Result mismatch!\n";
+        return 1;
+    }
+
+    double messages_read = static_cast<double>(message_count) * rounds;
+    std::cout << "deserialize_binary: " << owning_seconds * 1e9 / messages_read << " ns/message\n";
+    std::cout << "binary_view:        " << view_seconds * 1e9 / messages_read << " ns/message\n";
+}
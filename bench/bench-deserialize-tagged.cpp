@@ -0,0 +1,93 @@
+/**
+ * ***README***
+ * Compares deserialize_tagged from examples/tagged-binary.hpp (tag/varint format, decoded
+ * through a jump table indexed by tag) with deserialize_binary from
+ * examples/binary-serialization.hpp, which reads the fields in declaration order with
+ * memcpy and cannot skip or reorder anything.
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "binary-serialization.hpp"
+#include "tagged-binary.hpp"
+
+struct Trade
+{
+    uint64_t id;
+    uint32_t instrument;
+    int32_t quantity;
+    double price;
+    int64_t timestamp;
+    uint8_t side;
+    bool aggressive;
+    std::string venue;
+    std::vector<uint32_t> fills;
+};
+
+REFL_AUTO(
+    type(Trade),
+    field(id, tag(1)),
+    field(instrument, tag(2)),
+    field(quantity, tag(3)),
+    field(price, tag(4)),
+    field(timestamp, tag(5)),
+    field(side, tag(6)),
+    field(aggressive, tag(7)),
+    field(venue, tag(8)),
+    field(fills, tag(9))
+)
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<std::vector<unsigned char>> tagged;
+    std::vector<std::vector<unsigned char>> binary;
+    for (uint64_t i = 0; i < 10000; i++) {
+        Trade trade{ 1000000 + i, static_cast<uint32_t>(i % 500), static_cast<int32_t>(i % 1000) - 500, 101.25 + static_cast<double>(i % 7),
+            1600000000000 + static_cast<int64_t>(i), static_cast<uint8_t>(i % 2), i % 3 == 0, "XNAS", { 10, 20, 30 } };
+        serialize_tagged(trade, tagged.emplace_back());
+        serialize_binary(trade, binary.emplace_back());
+    }
+
+    constexpr int rounds = 100;
+    Trade trade{};
+    uint64_t checksum = 0;
+
+    double binary_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (const auto& message : binary) {
+                deserialize_binary(message.data(), message.size(), trade);
+                checksum += trade.id + trade.fills.size();
+            }
+        }
+    });
+    uint64_t expected = checksum;
+
+    checksum = 0;
+    double tagged_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (const auto& message : tagged) {
+                deserialize_tagged(message.data(), message.size(), trade);
+                checksum += trade.id + trade.fills.size();
+            }
+        }
+    });
+
+    if (checksum != expected) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    double messages = static_cast<double>(tagged.size()) * rounds;
+    std::cout << "deserialize_binary: " << binary_seconds / messages * 1e9 << " ns/msg (" << binary[0].size() << " bytes)\n";
+    std::cout << "deserialize_tagged: " << tagged_seconds / messages * 1e9 << " ns/msg (" << tagged[0].size() << " bytes)\n";
+}
@@ -0,0 +1,109 @@
+/**
+ * ***README***
+ * Compares the time needed to open a large data set and run one query over it, with the flat
+ * layout of examples/flat-layout.hpp (view_flat checks the header only, and fields are read
+ * in place) and with examples/binary-serialization.hpp (deserialize_binary builds the objects,
+ * view_binary validates the whole buffer before fields can be read in place).
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "binary-serialization.hpp"
+#include "flat-layout.hpp"
+
+struct Quote
+{
+    uint64_t id;
+    double bid;
+    double ask;
+    uint32_t volume;
+    std::string symbol;
+    std::vector<uint32_t> sizes;
+};
+
+REFL_AUTO(type(Quote), field(id), field(bid), field(ask), field(volume), field(symbol), field(sizes))
+
+struct Dataset
+{
+    std::vector<Quote> quotes;
+};
+
+REFL_AUTO(type(Dataset), field(quotes))
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    Dataset dataset;
+    for (uint64_t i = 0; i < 1000000; i++) {
+        dataset.quotes.push_back(Quote{ i, 100 + static_cast<double>(i % 100) / 8, 100.5 + static_cast<double>(i % 100) / 8,
+            static_cast<uint32_t>(i % 10000), "SYM" + std::to_string(i % 5000), { 1, 2, 3 } });
+    }
+
+    std::vector<unsigned char> binary;
+    std::vector<unsigned char> flat;
+    serialize_binary(dataset, binary);
+    serialize_flat(dataset, flat);
+
+    // opening the data, then looking up a single record
+    uint64_t lookup = 0;
+    double deserialize_seconds = Measure([&] {
+        Dataset copy;
+        deserialize_binary(binary.data(), binary.size(), copy);
+        lookup += copy.quotes[654321].volume;
+    });
+    double binary_view_seconds = Measure([&] {
+        auto view = view_binary<Dataset>(binary.data(), binary.size());
+        // records have different sizes, so the sequence must be walked
+        auto it = view.quotes().begin();
+        for (size_t i = 0; i < 654321; i++) ++it;
+        lookup += (*it).volume();
+    });
+    double flat_view_seconds = Measure([&] {
+        auto view = view_flat<Dataset>(flat.data(), flat.size());
+        lookup += view.quotes()[654321].volume();
+    });
+    double verify_seconds = Measure([&] {
+        verify_flat<Dataset>(flat.data(), flat.size());
+    });
+
+    if (lookup != 3 * dataset.quotes[654321].volume) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    // one pass over a field of all records
+    double flat_sum = 0;
+    double flat_scan_seconds = Measure([&] {
+        for (auto quote : view_flat<Dataset>(flat.data(), flat.size()).quotes()) {
+            flat_sum += quote.ask() - quote.bid();
+        }
+    });
+    double object_sum = 0;
+    double object_scan_seconds = Measure([&] {
+        for (const auto& quote : dataset.quotes) {
+            object_sum += quote.ask - quote.bid;
+        }
+    });
+
+    if (flat_sum != object_sum) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    std::cout << "binary: " << binary.size() << " bytes, flat: " << flat.size() << " bytes, " << dataset.quotes.size() << " records\n";
+    std::cout << "open + lookup, deserialize_binary: " << deserialize_seconds * 1e3 << " ms\n";
+    std::cout << "open + lookup, view_binary:        " << binary_view_seconds * 1e3 << " ms\n";
+    std::cout << "open + lookup, view_flat:          " << flat_view_seconds * 1e6 << " us\n";
+    std::cout << "verify_flat:                       " << verify_seconds * 1e3 << " ms\n";
+    std::cout << "scan, flat_view:                   " << flat_scan_seconds * 1e3 << " ms\n";
+    std::cout << "scan, objects in memory:           " << object_scan_seconds * 1e3 << " ms\n";
+}
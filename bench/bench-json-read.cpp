@@ -0,0 +1,185 @@
+/**
+ * ***README***
+ * Compares read_json from examples/json.hpp, which parses straight into the fields of a reflected
+ * type, with the usual approach of parsing the message into a DOM first and then copying the values
+ * of the DOM into the fields (by looking up the display name of each member in the DOM object).
+ * Both use the same tokenizer. The input contains a few unknown keys, which both readers skip.
+ */
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+#include "json.hpp"
+
+struct Order
+{
+    uint64_t id;
+    std::string customer;
+    std::string email;
+    std::string street;
+    std::string city;
+    std::string country;
+    double total;
+    double tax;
+    int quantity;
+    int priority;
+    bool paid;
+    bool shipped;
+    std::vector<int> items;
+};
+
+REFL_AUTO(
+    type(Order),
+    field(id),
+    field(customer),
+    field(email),
+    field(street),
+    field(city),
+    field(country),
+    field(total),
+    field(tax),
+    field(quantity),
+    field(priority),
+    field(paid),
+    field(shipped),
+    field(items)
+)
+
+namespace dom
+{
+    struct value;
+    using object = std::map<std::string, value, std::less<>>;
+    using array = std::vector<value>;
+
+    struct value
+    {
+        std::variant<std::nullptr_t, bool, double, std::string, array, std::unique_ptr<object>> data;
+    };
+
+    value parse(json_detail::parser& in)
+    {
+        std::string buffer;
+        char ch = in.peek();
+        if (ch == '{') {
+            auto result = std::make_unique<object>();
+            in.expect('{');
+            if (!in.consume('}')) {
+                do {
+                    std::string key(in.read_string(buffer));
+                    in.expect(':');
+                    result->emplace(std::move(key), parse(in));
+                } while (in.consume(','));
+                in.expect('}');
+            }
+            return value{ std::move(result) };
+        }
+        if (ch == '[') {
+            array result;
+            in.expect('[');
+            if (!in.consume(']')) {
+                do {
+                    result.push_back(parse(in));
+                } while (in.consume(','));
+                in.expect(']');
+            }
+            return value{ std::move(result) };
+        }
+        if (ch == '"') return value{ std::string(in.read_string(buffer)) };
+        if (in.consume_literal("true")) return value{ true };
+        if (in.consume_literal("false")) return value{ false };
+        if (in.consume_literal("null")) return value{ nullptr };
+        double number;
+        in.read_number(number);
+        return value{ number };
+    }
+
+    template <typename T>
+    void copy(const value& from, T& to)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            to = std::get<bool>(from.data);
+        }
+        else if constexpr (std::is_arithmetic_v<T>) {
+            to = static_cast<T>(std::get<double>(from.data));
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            to = std::get<std::string>(from.data);
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            const auto& elements = std::get<array>(from.data);
+            to.resize(elements.size());
+            for (size_t i = 0; i < elements.size(); i++) {
+                copy(elements[i], to[i]);
+            }
+        }
+        else {
+            const auto& members = *std::get<std::unique_ptr<object>>(from.data);
+            for_each(json_detail::writable_members<T>, [&](auto member) {
+                auto it = members.find(get_display_name_view(member));
+                if (it != members.end()) {
+                    copy(it->second, member(to));
+                }
+            });
+        }
+    }
+}
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<std::string> messages;
+    for (uint64_t i = 0; i < 10000; i++) {
+        Order order{ i, "customer " + std::to_string(i), "customer" + std::to_string(i) + "@example.com",
+            "Main Street " + std::to_string(i % 100), "Springfield", "US",
+            19.99 * static_cast<double>(i % 100), 0.2, static_cast<int>(i % 10), 1, i % 2 == 0, i % 3 == 0, { 1, 2, 3, 4 } };
+        std::string json = to_json(order);
+        // fields of a newer version of Order
+        json.insert(1, R"("coupon":{"code":"SUMMER","discount":[5,10]},"notes":"leave at the door",)");
+        messages.push_back(std::move(json));
+    }
+
+    constexpr int rounds = 20;
+    Order order{};
+    uint64_t checksum = 0;
+
+    double dom_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (const auto& json : messages) {
+                json_detail::parser in(json.data(), json.data() + json.size());
+                dom::copy(dom::parse(in), order);
+                checksum += order.id;
+            }
+        }
+    });
+    uint64_t expected = checksum;
+
+    checksum = 0;
+    double direct_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (const auto& json : messages) {
+                read_json(json, order);
+                checksum += order.id;
+            }
+        }
+    });
+
+    if (checksum != expected) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    double count = static_cast<double>(messages.size()) * rounds;
+    std::cout << "DOM:       " << count / dom_seconds / 1e6 << " M msg/s\n";
+    std::cout << "read_json: " << count / direct_seconds / 1e6 << " M msg/s\n";
+}
@@ -0,0 +1,106 @@
+/**
+ * ***README***
+ * Compares write_json from examples/json.hpp (compile-time key fragments and std::to_chars)
+ * with a generic reflection-based JSON writer built on std::ostream, in the style of
+ * examples/example-serialization.cpp.
+ */
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+struct Order
+{
+    uint64_t id;
+    std::string customer;
+    std::string email;
+    double total;
+    int quantity;
+    bool paid;
+    std::vector<int> items;
+};
+
+REFL_AUTO(type(Order), field(id), field(customer), field(email), field(total), field(quantity), field(paid), field(items))
+
+namespace stream
+{
+    template <typename T>
+    void write(std::ostream& os, const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            os << (value ? "true" : "false");
+        }
+        else if constexpr (std::is_arithmetic_v<T>) {
+            os << value;
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            os << std::quoted(value);
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            os << '[';
+            bool first = true;
+            for (const auto& element : value) {
+                if (!first) os << ',';
+                first = false;
+                write(os, element);
+            }
+            os << ']';
+        }
+        else {
+            os << '{';
+            for_each(refl::reflect<T>().members, [&](auto member, size_t index) {
+                if (index != 0) os << ',';
+                os << '"' << get_display_name(member) << "\":";
+                write(os, member(value));
+            });
+            os << '}';
+        }
+    }
+}
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<Order> orders;
+    for (uint64_t i = 0; i < 10000; i++) {
+        orders.push_back(Order{ i, "customer " + std::to_string(i), "customer" + std::to_string(i) + "@example.com",
+            19.99 * static_cast<double>(i % 100), static_cast<int>(i % 10), i % 2 == 0, { 1, 2, 3, 4 } });
+    }
+
+    constexpr int rounds = 20;
+
+    double stream_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (const auto& order : orders) {
+                std::ostringstream os;
+                stream::write(os, order);
+                if (os.tellp() == 0) std::abort();
+            }
+        }
+    });
+
+    std::string buffer;
+    double json_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            for (const auto& order : orders) {
+                buffer.clear();
+                write_json(order, buffer);
+                if (buffer.empty()) std::abort();
+            }
+        }
+    });
+
+    double messages = static_cast<double>(orders.size()) * rounds;
+    std::cout << "std::ostream: " << messages / stream_seconds / 1e6 << " M msg/s\n";
+    std::cout << "write_json:   " << messages / json_seconds / 1e6 << " M msg/s\n";
+}
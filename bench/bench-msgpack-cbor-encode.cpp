@@ -0,0 +1,126 @@
+/**
+ * ***README***
+ * Compares write_msgpack from examples/msgpack-cbor.hpp (compile-time encoded keys) with an
+ * encoder which encodes the display name of each member when it writes it, like the dynamic
+ * MessagePack writers do, and with write_msgpack in object_mode::array, which drops the keys.
+ */
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "msgpack-cbor.hpp"
+
+struct Order
+{
+    uint64_t id;
+    std::string customer;
+    std::string email;
+    double total;
+    int32_t quantity;
+    int32_t discount;
+    uint16_t warehouse;
+    bool paid;
+    bool shipped;
+    std::vector<int32_t> items;
+};
+
+REFL_AUTO(
+    type(Order),
+    field(id),
+    field(customer),
+    field(email),
+    field(total),
+    field(quantity),
+    field(discount),
+    field(warehouse),
+    field(paid),
+    field(shipped),
+    field(items)
+)
+
+namespace dynamic
+{
+    using msgpack_cbor_detail::byte;
+    using msgpack_cbor_detail::msgpack;
+
+    template <typename T>
+    void write(std::vector<byte>& out, const T& value)
+    {
+        if constexpr (std::is_class_v<T> && !refl::trait::is_container_v<T>) {
+            byte header[9];
+            msgpack_cbor_detail::append(out, header, msgpack::map_header(header, refl::member_list<T>::size));
+            for_each(refl::reflect<T>().members, [&](auto member) {
+                const char* name = get_display_name(member);
+                size_t size = std::strlen(name);
+                msgpack_cbor_detail::append(out, header, msgpack::string_header(header, size));
+                msgpack_cbor_detail::append(out, reinterpret_cast<const byte*>(name), size);
+                write(out, member(value));
+            });
+        }
+        else {
+            write_msgpack(value, out);
+        }
+    }
+}
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<Order> orders;
+    for (uint64_t i = 0; i < 10000; i++) {
+        orders.push_back(Order{ i * 1000, "customer " + std::to_string(i), "customer" + std::to_string(i) + "@example.com",
+            19.99 * static_cast<double>(i % 100), static_cast<int32_t>(i % 10), -static_cast<int32_t>(i % 200),
+            static_cast<uint16_t>(i % 5), i % 2 == 0, i % 3 == 0, { 1, 200, 30000, -4 } });
+    }
+
+    constexpr int rounds = 50;
+    std::vector<unsigned char> buffer;
+
+    double dynamic_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            buffer.clear();
+            for (const auto& order : orders) {
+                dynamic::write(buffer, order);
+            }
+        }
+    });
+    std::vector<unsigned char> expected = buffer;
+
+    double map_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            buffer.clear();
+            for (const auto& order : orders) {
+                write_msgpack(order, buffer);
+            }
+        }
+    });
+
+    if (buffer != expected) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+    size_t map_size = buffer.size();
+
+    double array_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            buffer.clear();
+            for (const auto& order : orders) {
+                write_msgpack<object_mode::array>(order, buffer);
+            }
+        }
+    });
+
+    double messages = static_cast<double>(orders.size()) * rounds;
+    std::cout << "runtime keys:      " << messages / dynamic_seconds / 1e6 << " M msg/s\n";
+    std::cout << "compile-time keys: " << messages / map_seconds / 1e6 << " M msg/s (" << map_size / orders.size() << " bytes/msg)\n";
+    std::cout << "array mode:        " << messages / array_seconds / 1e6 << " M msg/s (" << buffer.size() / orders.size() << " bytes/msg)\n";
+}
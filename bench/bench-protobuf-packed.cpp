@@ -0,0 +1,135 @@
+/**
+ * ***README***
+ * Compares the packed repeated fields of encode_protobuf and decode_protobuf from
+ * examples/protobuf.hpp, which work in blocks of 8 elements, with the straightforward
+ * implementation which encodes and decodes one varint at a time (the same wire format).
+ */
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "protobuf.hpp"
+
+struct Series
+{
+    std::vector<uint32_t> counts;
+    std::vector<int64_t> deltas;
+};
+
+REFL_AUTO(
+    type(Series),
+    field(counts, tag(1)),
+    field(deltas, tag(2), protobuf::zigzag())
+)
+
+using Bytes = std::vector<unsigned char>;
+
+template <typename T, protobuf_detail::encoding E>
+void EncodeScalar(Bytes& out, uint32_t tag, const std::vector<T>& values)
+{
+    using namespace protobuf_detail;
+    size_t size = 0;
+    for (T value : values) {
+        size += varint_size(to_varint<T, E>(value));
+    }
+    tagged_detail::write_varint(out, (tag << 3) | tagged_detail::length_delimited);
+    tagged_detail::write_varint(out, size);
+    for (T value : values) {
+        tagged_detail::write_varint(out, to_varint<T, E>(value));
+    }
+}
+
+template <typename T, protobuf_detail::encoding E>
+void DecodeScalar(tagged_detail::reader& in, std::vector<T>& values)
+{
+    tagged_detail::reader contents = in.read_delimited();
+    while (!contents.at_end()) {
+        values.push_back(protobuf_detail::from_varint<T, E>(contents.read_varint()));
+    }
+}
+
+void EncodeScalar(const Series& series, Bytes& out)
+{
+    EncodeScalar<uint32_t, protobuf_detail::encoding::varint>(out, 1, series.counts);
+    EncodeScalar<int64_t, protobuf_detail::encoding::zigzag>(out, 2, series.deltas);
+}
+
+void DecodeScalar(const Bytes& data, Series& series)
+{
+    series.counts.clear();
+    series.deltas.clear();
+    tagged_detail::reader in(data.data(), data.data(), data.data() + data.size());
+    while (!in.at_end()) {
+        uint64_t key = in.read_varint();
+        if ((key >> 3) == 1) DecodeScalar<uint32_t, protobuf_detail::encoding::varint>(in, series.counts);
+        else DecodeScalar<int64_t, protobuf_detail::encoding::zigzag>(in, series.deltas);
+    }
+}
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    // mostly small counts (single-byte varints) and deltas of varying magnitude
+    Series series;
+    uint64_t state = 12345;
+    for (int i = 0; i < 100000; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        series.counts.push_back(i % 64 == 0 ? static_cast<uint32_t>(state >> 40) : static_cast<uint32_t>(state >> 58));
+        series.deltas.push_back(static_cast<int64_t>(state >> 48) - 32768);
+    }
+
+    constexpr int rounds = 200;
+    Bytes scalar;
+    Bytes blocked;
+
+    double scalar_encode = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            scalar.clear();
+            EncodeScalar(series, scalar);
+        }
+    });
+    double blocked_encode = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            blocked.clear();
+            encode_protobuf(series, blocked);
+        }
+    });
+
+    if (scalar != blocked) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    Series scalar_copy;
+    Series blocked_copy;
+    double scalar_decode = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            DecodeScalar(scalar, scalar_copy);
+        }
+    });
+    double blocked_decode = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            decode_protobuf(blocked.data(), blocked.size(), blocked_copy);
+        }
+    });
+
+    if (scalar_copy.counts != series.counts || scalar_copy.deltas != series.deltas
+        || blocked_copy.counts != series.counts || blocked_copy.deltas != series.deltas) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    double elements = static_cast<double>(series.counts.size() + series.deltas.size()) * rounds;
+    std::cout << "message: " << blocked.size() << " bytes, " << series.counts.size() + series.deltas.size() << " elements\n";
+    std::cout << "encode, one varint at a time: " << scalar_encode / elements * 1e9 << " ns/element\n";
+    std::cout << "encode, blocks of 8:          " << blocked_encode / elements * 1e9 << " ns/element\n";
+    std::cout << "decode, one varint at a time: " << scalar_decode / elements * 1e9 << " ns/element\n";
+    std::cout << "decode, blocks of 8:          " << blocked_decode / elements * 1e9 << " ns/element\n";
+}
@@ -0,0 +1,136 @@
+/**
+ * ***README***
+ * Compares binary_push_parser from examples/push-parser.hpp, which decodes messages straight
+ * from the fragments in which they arrive, with the usual approach of copying the fragments into
+ * a reassembly buffer (with a length prefix per message) and calling deserialize_binary once
+ * a message is complete. The fragments have the size of a TCP segment.
+ * Besides the throughput, it measures the latency which each approach adds: the time spent on a
+ * message after its last fragment has arrived (decoding the whole message with reassembly,
+ * only the rest of the last fragment with binary_push_parser).
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "push-parser.hpp"
+
+struct Order
+{
+    uint64_t id;
+    std::string account;
+    std::string symbol;
+    std::vector<double> prices;
+    std::vector<uint32_t> quantities;
+};
+
+REFL_AUTO(type(Order), field(id), field(account), field(symbol), field(prices), field(quantities))
+
+struct Batch
+{
+    uint64_t sequence;
+    std::vector<Order> orders;
+};
+
+REFL_AUTO(type(Batch), field(sequence), field(orders))
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    constexpr size_t fragment_size = 1448;
+    constexpr size_t messages = 2000;
+
+    // the same messages, with and without length prefixes
+    std::vector<unsigned char> framed;
+    std::vector<unsigned char> stream;
+    for (uint64_t i = 0; i < messages; i++) {
+        Batch batch{ i, {} };
+        for (uint64_t j = 0; j < 8; j++) {
+            batch.orders.push_back(Order{ i * 8 + j, "account-" + std::to_string(j), "SYM" + std::to_string(i % 100),
+                std::vector<double>(20 + j * 4, 101.5), std::vector<uint32_t>(20 + j * 4, 100) });
+        }
+        std::vector<unsigned char> message;
+        serialize_binary(batch, message);
+        uint32_t length = static_cast<uint32_t>(message.size());
+        framed.insert(framed.end(), reinterpret_cast<unsigned char*>(&length), reinterpret_cast<unsigned char*>(&length) + sizeof(length));
+        framed.insert(framed.end(), message.begin(), message.end());
+        stream.insert(stream.end(), message.begin(), message.end());
+    }
+
+    constexpr int rounds = 20;
+    Batch batch;
+    uint64_t checksum = 0;
+
+    // latency is only accumulated when it is not null, since measuring it slows everything down
+    auto reassemble = [&](double* latency) {
+        std::vector<unsigned char> buffer;
+        for (int r = 0; r < rounds; r++) {
+            for (size_t pos = 0; pos < framed.size(); pos += fragment_size) {
+                buffer.insert(buffer.end(), framed.begin() + pos, framed.begin() + std::min(pos + fragment_size, framed.size()));
+                size_t used = 0;
+                uint32_t length;
+                while (buffer.size() - used >= sizeof(length)
+                    && (std::memcpy(&length, buffer.data() + used, sizeof(length)), buffer.size() - used - sizeof(length) >= length)) {
+                    auto decode = [&] { deserialize_binary(buffer.data() + used + sizeof(length), length, batch); };
+                    if (latency) *latency += Measure(decode);
+                    else decode();
+                    checksum += batch.sequence + batch.orders.back().prices.size();
+                    used += sizeof(length) + length;
+                }
+                buffer.erase(buffer.begin(), buffer.begin() + used);
+            }
+        }
+    };
+
+    auto push = [&](double* latency) {
+        binary_push_parser<Batch> parser(batch);
+        for (int r = 0; r < rounds; r++) {
+            for (size_t pos = 0; pos < stream.size(); pos += fragment_size) {
+                const unsigned char* fragment = stream.data() + pos;
+                size_t length = std::min(fragment_size, stream.size() - pos);
+                while (length != 0) {
+                    size_t used = 0;
+                    auto feed = [&] { used = parser.feed(fragment, length); };
+                    double seconds = latency ? Measure(feed) : (feed(), 0.0);
+                    fragment += used;
+                    length -= used;
+                    if (parser.done()) {
+                        if (latency) *latency += seconds;
+                        checksum += batch.sequence + batch.orders.back().prices.size();
+                        parser.reset();
+                    }
+                }
+            }
+        }
+    };
+
+    double reassembly_seconds = Measure([&] { reassemble(nullptr); });
+    uint64_t expected = checksum;
+    checksum = 0;
+    double push_seconds = Measure([&] { push(nullptr); });
+    if (checksum != expected) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    double reassembly_latency = 0;
+    double push_latency = 0;
+    reassemble(&reassembly_latency);
+    push(&push_latency);
+
+    double total = static_cast<double>(messages) * rounds;
+    std::cout << "message: " << stream.size() / messages << " bytes, fragments of " << fragment_size << " bytes\n";
+    std::cout << "reassembly + deserialize_binary: " << reassembly_seconds / total * 1e9 << " ns/msg, "
+              << reassembly_latency / total * 1e9 << " ns/msg after the last fragment\n";
+    std::cout << "binary_push_parser:              " << push_seconds / total * 1e9 << " ns/msg, "
+              << push_latency / total * 1e9 << " ns/msg after the last fragment\n";
+}
@@ -0,0 +1,398 @@
+/**
+ * ***README***
+ * Measures the runtime cost of refl::runtime::invoke on a type with
+ * 160 reflected fields, where the member is looked up by name, and compares
+ * it to a linear search over the names of the members.
+ *
+ * runtime::invoke looks the member up in a perfect hash table built at
+ * compile-time. invoke_linear below is the previous implementation, which
+ * compares the name against every member in turn, and is kept here for comparison.
+ */
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "refl.hpp"
+
+template <typename U, typename T, typename... Args>
+U invoke_linear(T&& target, const char* name, Args&&... args)
+{
+    using type = std::remove_reference_t<T>;
+    typedef refl::type_descriptor<type> type_descriptor;
+
+    std::optional<U> result{};
+
+    for_each(type_descriptor::members, [&](auto member) {
+        if (result) return;
+
+        if constexpr (std::is_invocable_r_v<U, decltype(member), T, Args...>) {
+            if (std::strcmp(member.name.c_str(), name) == 0) {
+                result.emplace(member(target, std::forward<Args>(args)...));
+            }
+        }
+    });
+
+    if (!result) {
+        throw std::runtime_error(std::string("The member ") + name + " does not exist!");
+    }
+    return std::move(*result);
+}
+
+struct LargePod
+{
+    int Field0 = 0;
+    int Field1 = 1;
+    int Field2 = 2;
+    int Field3 = 3;
+    int Field4 = 4;
+    int Field5 = 5;
+    int Field6 = 6;
+    int Field7 = 7;
+    int Field8 = 8;
+    int Field9 = 9;
+    int Field10 = 10;
+    int Field11 = 11;
+    int Field12 = 12;
+    int Field13 = 13;
+    int Field14 = 14;
+    int Field15 = 15;
+    int Field16 = 16;
+    int Field17 = 17;
+    int Field18 = 18;
+    int Field19 = 19;
+    int Field20 = 20;
+    int Field21 = 21;
+    int Field22 = 22;
+    int Field23 = 23;
+    int Field24 = 24;
+    int Field25 = 25;
+    int Field26 = 26;
+    int Field27 = 27;
+    int Field28 = 28;
+    int Field29 = 29;
+    int Field30 = 30;
+    int Field31 = 31;
+    int Field32 = 32;
+    int Field33 = 33;
+    int Field34 = 34;
+    int Field35 = 35;
+    int Field36 = 36;
+    int Field37 = 37;
+    int Field38 = 38;
+    int Field39 = 39;
+    int Field40 = 40;
+    int Field41 = 41;
+    int Field42 = 42;
+    int Field43 = 43;
+    int Field44 = 44;
+    int Field45 = 45;
+    int Field46 = 46;
+    int Field47 = 47;
+    int Field48 = 48;
+    int Field49 = 49;
+    int Field50 = 50;
+    int Field51 = 51;
+    int Field52 = 52;
+    int Field53 = 53;
+    int Field54 = 54;
+    int Field55 = 55;
+    int Field56 = 56;
+    int Field57 = 57;
+    int Field58 = 58;
+    int Field59 = 59;
+    int Field60 = 60;
+    int Field61 = 61;
+    int Field62 = 62;
+    int Field63 = 63;
+    int Field64 = 64;
+    int Field65 = 65;
+    int Field66 = 66;
+    int Field67 = 67;
+    int Field68 = 68;
+    int Field69 = 69;
+    int Field70 = 70;
+    int Field71 = 71;
+    int Field72 = 72;
+    int Field73 = 73;
+    int Field74 = 74;
+    int Field75 = 75;
+    int Field76 = 76;
+    int Field77 = 77;
+    int Field78 = 78;
+    int Field79 = 79;
+    int Field80 = 80;
+    int Field81 = 81;
+    int Field82 = 82;
+    int Field83 = 83;
+    int Field84 = 84;
+    int Field85 = 85;
+    int Field86 = 86;
+    int Field87 = 87;
+    int Field88 = 88;
+    int Field89 = 89;
+    int Field90 = 90;
+    int Field91 = 91;
+    int Field92 = 92;
+    int Field93 = 93;
+    int Field94 = 94;
+    int Field95 = 95;
+    int Field96 = 96;
+    int Field97 = 97;
+    int Field98 = 98;
+    int Field99 = 99;
+    int Field100 = 100;
+    int Field101 = 101;
+    int Field102 = 102;
+    int Field103 = 103;
+    int Field104 = 104;
+    int Field105 = 105;
+    int Field106 = 106;
+    int Field107 = 107;
+    int Field108 = 108;
+    int Field109 = 109;
+    int Field110 = 110;
+    int Field111 = 111;
+    int Field112 = 112;
+    int Field113 = 113;
+    int Field114 = 114;
+    int Field115 = 115;
+    int Field116 = 116;
+    int Field117 = 117;
+    int Field118 = 118;
+    int Field119 = 119;
+    int Field120 = 120;
+    int Field121 = 121;
+    int Field122 = 122;
+    int Field123 = 123;
+    int Field124 = 124;
+    int Field125 = 125;
+    int Field126 = 126;
+    int Field127 = 127;
+    int Field128 = 128;
+    int Field129 = 129;
+    int Field130 = 130;
+    int Field131 = 131;
+    int Field132 = 132;
+    int Field133 = 133;
+    int Field134 = 134;
+    int Field135 = 135;
+    int Field136 = 136;
+    int Field137 = 137;
+    int Field138 = 138;
+    int Field139 = 139;
+    int Field140 = 140;
+    int Field141 = 141;
+    int Field142 = 142;
+    int Field143 = 143;
+    int Field144 = 144;
+    int Field145 = 145;
+    int Field146 = 146;
+    int Field147 = 147;
+    int Field148 = 148;
+    int Field149 = 149;
+    int Field150 = 150;
+    int Field151 = 151;
+    int Field152 = 152;
+    int Field153 = 153;
+    int Field154 = 154;
+    int Field155 = 155;
+    int Field156 = 156;
+    int Field157 = 157;
+    int Field158 = 158;
+    int Field159 = 159;
+};
+
+REFL_TYPE(LargePod)
+    REFL_FIELD(Field0)
+    REFL_FIELD(Field1)
+    REFL_FIELD(Field2)
+    REFL_FIELD(Field3)
+    REFL_FIELD(Field4)
+    REFL_FIELD(Field5)
+    REFL_FIELD(Field6)
+    REFL_FIELD(Field7)
+    REFL_FIELD(Field8)
+    REFL_FIELD(Field9)
+    REFL_FIELD(Field10)
+    REFL_FIELD(Field11)
+    REFL_FIELD(Field12)
+    REFL_FIELD(Field13)
+    REFL_FIELD(Field14)
+    REFL_FIELD(Field15)
+    REFL_FIELD(Field16)
+    REFL_FIELD(Field17)
+    REFL_FIELD(Field18)
+    REFL_FIELD(Field19)
+    REFL_FIELD(Field20)
+    REFL_FIELD(Field21)
+    REFL_FIELD(Field22)
+    REFL_FIELD(Field23)
+    REFL_FIELD(Field24)
+    REFL_FIELD(Field25)
+    REFL_FIELD(Field26)
+    REFL_FIELD(Field27)
+    REFL_FIELD(Field28)
+    REFL_FIELD(Field29)
+    REFL_FIELD(Field30)
+    REFL_FIELD(Field31)
+    REFL_FIELD(Field32)
+    REFL_FIELD(Field33)
+    REFL_FIELD(Field34)
+    REFL_FIELD(Field35)
+    REFL_FIELD(Field36)
+    REFL_FIELD(Field37)
+    REFL_FIELD(Field38)
+    REFL_FIELD(Field39)
+    REFL_FIELD(Field40)
+    REFL_FIELD(Field41)
+    REFL_FIELD(Field42)
+    REFL_FIELD(Field43)
+    REFL_FIELD(Field44)
+    REFL_FIELD(Field45)
+    REFL_FIELD(Field46)
+    REFL_FIELD(Field47)
+    REFL_FIELD(Field48)
+    REFL_FIELD(Field49)
+    REFL_FIELD(Field50)
+    REFL_FIELD(Field51)
+    REFL_FIELD(Field52)
+    REFL_FIELD(Field53)
+    REFL_FIELD(Field54)
+    REFL_FIELD(Field55)
+    REFL_FIELD(Field56)
+    REFL_FIELD(Field57)
+    REFL_FIELD(Field58)
+    REFL_FIELD(Field59)
+    REFL_FIELD(Field60)
+    REFL_FIELD(Field61)
+    REFL_FIELD(Field62)
+    REFL_FIELD(Field63)
+    REFL_FIELD(Field64)
+    REFL_FIELD(Field65)
+    REFL_FIELD(Field66)
+    REFL_FIELD(Field67)
+    REFL_FIELD(Field68)
+    REFL_FIELD(Field69)
+    REFL_FIELD(Field70)
+    REFL_FIELD(Field71)
+    REFL_FIELD(Field72)
+    REFL_FIELD(Field73)
+    REFL_FIELD(Field74)
+    REFL_FIELD(Field75)
+    REFL_FIELD(Field76)
+    REFL_FIELD(Field77)
+    REFL_FIELD(Field78)
+    REFL_FIELD(Field79)
+    REFL_FIELD(Field80)
+    REFL_FIELD(Field81)
+    REFL_FIELD(Field82)
+    REFL_FIELD(Field83)
+    REFL_FIELD(Field84)
+    REFL_FIELD(Field85)
+    REFL_FIELD(Field86)
+    REFL_FIELD(Field87)
+    REFL_FIELD(Field88)
+    REFL_FIELD(Field89)
+    REFL_FIELD(Field90)
+    REFL_FIELD(Field91)
+    REFL_FIELD(Field92)
+    REFL_FIELD(Field93)
+    REFL_FIELD(Field94)
+    REFL_FIELD(Field95)
+    REFL_FIELD(Field96)
+    REFL_FIELD(Field97)
+    REFL_FIELD(Field98)
+    REFL_FIELD(Field99)
+    REFL_FIELD(Field100)
+    REFL_FIELD(Field101)
+    REFL_FIELD(Field102)
+    REFL_FIELD(Field103)
+    REFL_FIELD(Field104)
+    REFL_FIELD(Field105)
+    REFL_FIELD(Field106)
+    REFL_FIELD(Field107)
+    REFL_FIELD(Field108)
+    REFL_FIELD(Field109)
+    REFL_FIELD(Field110)
+    REFL_FIELD(Field111)
+    REFL_FIELD(Field112)
+    REFL_FIELD(Field113)
+    REFL_FIELD(Field114)
+    REFL_FIELD(Field115)
+    REFL_FIELD(Field116)
+    REFL_FIELD(Field117)
+    REFL_FIELD(Field118)
+    REFL_FIELD(Field119)
+    REFL_FIELD(Field120)
+    REFL_FIELD(Field121)
+    REFL_FIELD(Field122)
+    REFL_FIELD(Field123)
+    REFL_FIELD(Field124)
+    REFL_FIELD(Field125)
+    REFL_FIELD(Field126)
+    REFL_FIELD(Field127)
+    REFL_FIELD(Field128)
+    REFL_FIELD(Field129)
+    REFL_FIELD(Field130)
+    REFL_FIELD(Field131)
+    REFL_FIELD(Field132)
+    REFL_FIELD(Field133)
+    REFL_FIELD(Field134)
+    REFL_FIELD(Field135)
+    REFL_FIELD(Field136)
+    REFL_FIELD(Field137)
+    REFL_FIELD(Field138)
+    REFL_FIELD(Field139)
+    REFL_FIELD(Field140)
+    REFL_FIELD(Field141)
+    REFL_FIELD(Field142)
+    REFL_FIELD(Field143)
+    REFL_FIELD(Field144)
+    REFL_FIELD(Field145)
+    REFL_FIELD(Field146)
+    REFL_FIELD(Field147)
+    REFL_FIELD(Field148)
+    REFL_FIELD(Field149)
+    REFL_FIELD(Field150)
+    REFL_FIELD(Field151)
+    REFL_FIELD(Field152)
+    REFL_FIELD(Field153)
+    REFL_FIELD(Field154)
+    REFL_FIELD(Field155)
+    REFL_FIELD(Field156)
+    REFL_FIELD(Field157)
+    REFL_FIELD(Field158)
+    REFL_FIELD(Field159)
+REFL_END
+
+template <typename F>
+void Measure(const char* label, const std::vector<std::string>& names, size_t iterations, F&& f)
+{
+    long long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        checksum += f(names[i % names.size()].c_str());
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::cout << label << ": " << ns / iterations << " ns/call (checksum " << checksum << ")\n";
+}
+
+int main()
+{
+    LargePod pod;
+    std::vector<std::string> names;
+    for_each(refl::reflect<LargePod>().members, [&](auto member) {
+        names.push_back(member.name.str());
+    });
+
+    constexpr size_t iterations = 10'000'000;
+    Measure("linear scan", names, iterations, [&](const char* name) {
+        return invoke_linear<int>(pod, name);
+    });
+    Measure("perfect hash", names, iterations, [&](const char* name) {
+        return refl::runtime::invoke<int>(pod, name);
+    });
+}
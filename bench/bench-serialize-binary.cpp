@@ -0,0 +1,123 @@
+/**
+ * ***README***
+ * Compares serialize_binary from examples/binary-serialization.hpp (coalesced memcpy runs
+ * and bulk copies of trivial vectors) with a serializer which writes one field and one
+ * vector element at a time, like the reflection-based serializers usually do.
+ */
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "binary-serialization.hpp"
+
+struct Vec3
+{
+    float x, y, z;
+};
+
+REFL_AUTO(type(Vec3), field(x), field(y), field(z))
+
+struct Particle
+{
+    uint64_t id;
+    Vec3 position;
+    Vec3 velocity;
+    float mass;
+    float charge;
+    int32_t flags;
+    std::string name;
+    std::vector<float> history;
+};
+
+REFL_AUTO(
+    type(Particle),
+    field(id),
+    field(position),
+    field(velocity),
+    field(mass),
+    field(charge),
+    field(flags),
+    field(name),
+    field(history)
+)
+
+namespace per_field
+{
+    template <typename T>
+    void write(std::vector<unsigned char>& out, const T& value);
+
+    template <typename T>
+    void write_bytes(std::vector<unsigned char>& out, const T& value)
+    {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    void write(std::vector<unsigned char>& out, const T& value)
+    {
+        if constexpr (std::is_arithmetic_v<T>) {
+            write_bytes(out, value);
+        }
+        else if constexpr (binary_detail::is_string<T>::value || binary_detail::is_vector<T>::value) {
+            write_bytes(out, static_cast<uint64_t>(value.size()));
+            for (const auto& element : value) {
+                write(out, element);
+            }
+        }
+        else {
+            for_each(binary_detail::fields<T>, [&](auto member) {
+                write(out, member(value));
+            });
+        }
+    }
+}
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    std::vector<Particle> particles;
+    for (uint64_t i = 0; i < 10000; i++) {
+        Particle p{ i, { 1, 2, 3 }, { 4, 5, 6 }, 1.5f, -1.0f, 7, "particle_" + std::to_string(i), std::vector<float>(64, 0.25f) };
+        particles.push_back(std::move(p));
+    }
+
+    constexpr int rounds = 100;
+    std::vector<unsigned char> buffer;
+
+    size_t per_field_bytes = 0;
+    double per_field_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            buffer.clear();
+            per_field::write(buffer, particles);
+            per_field_bytes += buffer.size();
+        }
+    });
+    std::vector<unsigned char> expected = buffer;
+
+    size_t coalesced_bytes = 0;
+    double coalesced_seconds = Measure([&] {
+        for (int r = 0; r < rounds; r++) {
+            buffer.clear();
+            serialize_binary(particles, buffer);
+            coalesced_bytes += buffer.size();
+        }
+    });
+
+    if (buffer != expected) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    std::cout << "per field:        " << per_field_bytes / per_field_seconds / 1e6 << " MB/s\n";
+    std::cout << "serialize_binary: " << coalesced_bytes / coalesced_seconds / 1e6 << " MB/s\n";
+}
@@ -0,0 +1,82 @@
+/**
+ * ***README***
+ * Compares scanning one field of a few million particles stored in a std::vector (array of
+ * structures) with scanning the same field of a soa_vector from examples/soa-vector.hpp,
+ * through its column and through its iterators (proxies).
+ */
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "soa-vector.hpp"
+
+struct Particle
+{
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    float charge;
+    uint64_t id;
+    uint32_t flags;
+};
+
+REFL_AUTO(type(Particle), field(x), field(y), field(z), field(vx), field(vy), field(vz), field(mass), field(charge), field(id), field(flags))
+
+using mass_member = refl::trait::get_t<6, refl::member_list<Particle>>;
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20; i++) {
+        f();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() / 20;
+}
+
+int main()
+{
+    std::vector<Particle> aos;
+    soa_vector<Particle> soa;
+    for (uint64_t i = 0; i < 4000000; i++) {
+        Particle particle{ 1, 2, 3, 0.1f, 0.2f, 0.3f, static_cast<float>(i % 100) / 8, -1, i, 0 };
+        aos.push_back(particle);
+        soa.push_back(particle);
+    }
+
+    float aos_sum = 0, column_sum = 0, proxy_sum = 0;
+    double aos_seconds = Measure([&] {
+        float sum = 0;
+        for (const Particle& particle : aos) {
+            sum += particle.mass;
+        }
+        aos_sum = sum;
+    });
+    double column_seconds = Measure([&] {
+        const float* masses = soa.data(mass_member{});
+        float sum = 0;
+        for (size_t i = 0; i < soa.size(); i++) {
+            sum += masses[i];
+        }
+        column_sum = sum;
+    });
+    double proxy_seconds = Measure([&] {
+        float sum = 0;
+        for (auto particle : soa) {
+            sum += particle.mass();
+        }
+        proxy_sum = sum;
+    });
+
+    if (aos_sum != column_sum || aos_sum != proxy_sum) {
+        std::cerr << "Output mismatch!\n";
+        return 1;
+    }
+
+    double elements = static_cast<double>(aos.size());
+    std::cout << aos.size() << " particles of " << sizeof(Particle) << " bytes\n";
+    std::cout << "std::vector<Particle>:          " << elements / aos_seconds / 1e6 << " M elements/s\n";
+    std::cout << "soa_vector, column:             " << elements / column_seconds / 1e6 << " M elements/s\n";
+    std::cout << "soa_vector, iterators (proxies): " << elements / proxy_seconds / 1e6 << " M elements/s\n";
+}
@@ -0,0 +1,78 @@
+/**
+ * ***README***
+ * Measures the startup cost of registering 1024 distinct reflected types with the
+ * TypeRegistry from examples/type-registry.hpp, as well as the cost of
+ * looking them up by id and by name afterwards.
+ */
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "type-registry.hpp"
+
+template <int N>
+struct Component
+{
+    int value;
+    float weight;
+};
+
+REFL_AUTO(template((int N), (Component<N>)), field(value), field(weight))
+
+constexpr int batch_size = 32;
+constexpr int type_count = batch_size * batch_size;
+
+// Registration is split into batches, since a single huge fold expression is very slow to compile.
+template <int Batch, int... Idx>
+void RegisterBatch(TypeRegistry& registry, const std::vector<std::string>& names, std::integer_sequence<int, Idx...>)
+{
+    (registry.Register<Component<Batch * batch_size + Idx>>(names[Batch * batch_size + Idx]), ...);
+}
+
+template <int... Batch>
+void RegisterAll(TypeRegistry& registry, const std::vector<std::string>& names, std::integer_sequence<int, Batch...>)
+{
+    (RegisterBatch<Batch>(registry, names, std::make_integer_sequence<int, batch_size>{}), ...);
+}
+
+template <typename F>
+double Measure(F&& f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main()
+{
+    std::vector<std::string> names;
+    names.reserve(type_count);
+    for (int i = 0; i < type_count; i++) {
+        names.push_back("Component<" + std::to_string(i) + ">");
+    }
+
+    TypeRegistry& registry = TypeRegistry::Instance();
+    double register_ms = Measure([&] {
+        RegisterAll(registry, names, std::make_integer_sequence<int, batch_size>{});
+    });
+    std::cout << "register " << registry.Size() << " types: " << register_ms << " ms\n";
+
+    constexpr int lookups = 10'000'000;
+    size_t checksum = 0;
+    double by_id_ms = Measure([&] {
+        for (int i = 0; i < lookups; i++) {
+            checksum += registry.Find(static_cast<uint32_t>(i % type_count))->size;
+        }
+    });
+    double by_name_ms = Measure([&] {
+        for (int i = 0; i < lookups; i++) {
+            checksum += registry.Find(names[i % type_count])->size;
+        }
+    });
+
+    std::cout << "lookup by id: " << by_id_ms * 1e6 / lookups << " ns\n";
+    std::cout << "lookup by name: " << by_name_ms * 1e6 / lookups << " ns\n";
+    std::cout << "(checksum " << checksum << ")\n";
+}
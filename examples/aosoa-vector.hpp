@@ -0,0 +1,243 @@
+/**
+ * ***README***
+ * A tiled (array of structures of arrays) vector, for code which updates several members of
+ * each element and also processes single members of many elements.
+ * Used by example-aosoa.cpp.
+ *
+ * aosoa_vector<T, N> stores its elements in blocks of N. A block has one std::array<V, N> per
+ * readable member of T (field or getter property, of type V), generated from the member list of T,
+ * and blocks are 64-byte aligned. The members of one element are at most one block apart, which
+ * keeps updates of several members of an element local, while loops over the arrays of a block
+ * have a constant trip count of N, which compilers unroll and vectorize.
+ *
+ * Blocks are accessed with block(b) (and block_count()), and their arrays with block[member] or
+ * block.get<I>(). The last block can be partially used: elements past size() are default values.
+ * Elements are accessed through proxies of T, and iterated over, as in soa-vector.hpp (with the
+ * same reference and iterator types).
+ */
+#ifndef REFL_EXAMPLES_AOSOA_VECTOR_HPP
+#define REFL_EXAMPLES_AOSOA_VECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "refl.hpp"
+#include "soa-vector.hpp"
+
+namespace aosoa_detail
+{
+    static constexpr size_t block_alignment = 64;
+
+    template <size_t N>
+    struct make_array
+    {
+        template <typename ReadableMember>
+        struct apply
+        {
+            using type = std::array<soa_detail::underlying_type<ReadableMember>, N>;
+        };
+    };
+
+    template <typename T, size_t N>
+    using block_arrays = refl::trait::as_tuple_t<refl::trait::map_t<make_array<N>::template apply, soa_detail::members_t<T>>>;
+}
+
+/**
+ * A block of N elements of T: one array per readable member of T.
+ */
+template <typename T, size_t N>
+struct alignas(aosoa_detail::block_alignment) aosoa_block
+{
+    using members = soa_detail::members_t<T>;
+
+    static constexpr size_t size = N;
+
+    /** The array of the member (a descriptor from members). */
+    template <typename Member>
+    auto& operator[](Member) noexcept
+    {
+        return std::get<soa_detail::column_index<T, Member>()>(arrays);
+    }
+
+    template <typename Member>
+    const auto& operator[](Member) const noexcept
+    {
+        return std::get<soa_detail::column_index<T, Member>()>(arrays);
+    }
+
+    /** The array of the I-th member. */
+    template <size_t I>
+    auto& get() noexcept
+    {
+        return std::get<I>(arrays);
+    }
+
+    template <size_t I>
+    const auto& get() const noexcept
+    {
+        return std::get<I>(arrays);
+    }
+
+    aosoa_detail::block_arrays<T, N> arrays;
+};
+
+/**
+ * A sequence container of T, stored in blocks of N elements, each of which is stored as one
+ * array per readable member of T.
+ *
+ * \code{.cpp}
+ * aosoa_vector<Particle, 8> particles(1000);
+ * for (size_t b = 0; b < particles.block_count(); b++) {
+ *     auto& block = particles.block(b);
+ *     for (size_t i = 0; i < 8; i++) {          // vectorized
+ *         block.get<0>()[i] += block.get<3>()[i] * dt;
+ *     }
+ * }
+ * particles[42].x(0.0f);                        // through a proxy
+ * \endcode
+ */
+template <typename T, size_t N>
+class aosoa_vector
+{
+public:
+    static_assert(N > 0, "The block size must be positive!");
+
+    using members = soa_detail::members_t<T>;
+    static_assert(members::size > 0, "Type has no readable members!");
+
+    using block_type = aosoa_block<T, N>;
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    static constexpr size_t block_size = N;
+
+    using reference = soa_detail::proxy_reference<aosoa_vector>;
+    using const_reference = soa_detail::proxy_reference<const aosoa_vector>;
+    using iterator = soa_detail::proxy_iterator<aosoa_vector>;
+    using const_iterator = soa_detail::proxy_iterator<const aosoa_vector>;
+
+    // The element at an index, which references access through get<I>() (see soa_detail::proxy_reference).
+    template <typename Vector>
+    class position
+    {
+    public:
+        position(Vector* vector, size_t index) noexcept
+            : block_(&vector->blocks_[index / N]), lane_(index % N)
+        {
+        }
+
+        template <size_t I>
+        auto& get() const noexcept
+        {
+            return std::get<I>(block_->arrays)[lane_];
+        }
+
+    private:
+        std::conditional_t<std::is_const_v<Vector>, const block_type, block_type>* block_;
+        size_t lane_;
+    };
+
+    aosoa_vector() = default;
+
+    explicit aosoa_vector(size_t count)
+    {
+        resize(count);
+    }
+
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return blocks_.capacity() * N; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /** The number of blocks, the last of which can be partially used. */
+    size_t block_count() const noexcept { return blocks_.size(); }
+
+    block_type& block(size_t index) noexcept { return blocks_[index]; }
+    const block_type& block(size_t index) const noexcept { return blocks_[index]; }
+
+    void reserve(size_t count)
+    {
+        blocks_.reserve((count + N - 1) / N);
+    }
+
+    /** Adds or removes elements at the end (added elements are default values). */
+    void resize(size_t count)
+    {
+        shrink((std::min)(count, size_));
+        blocks_.resize((count + N - 1) / N);
+        size_ = count;
+    }
+
+    /** Adds or removes elements at the end (added elements are copies of value). */
+    void resize(size_t count, const T& value)
+    {
+        size_t old_size = size_;
+        resize(count);
+        for (size_t i = old_size; i < count; i++) {
+            (*this)[i] = value;
+        }
+    }
+
+    void push_back(const T& value)
+    {
+        resize(size_ + 1, value);
+    }
+
+    void pop_back()
+    {
+        resize(size_ - 1);
+    }
+
+    void clear() noexcept
+    {
+        blocks_.clear();
+        size_ = 0;
+    }
+
+    reference operator[](size_t index) noexcept { return reference(this, index); }
+    const_reference operator[](size_t index) const noexcept { return const_reference(this, index); }
+
+    /** Returns a copy of the element at index. Throws std::out_of_range if there is none. */
+    T at(size_t index) const
+    {
+        if (index >= size_) {
+            throw std::out_of_range("aosoa_vector::at");
+        }
+        return (*this)[index];
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+    const_reference front() const noexcept { return (*this)[0]; }
+    reference back() noexcept { return (*this)[size_ - 1]; }
+    const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size_); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, size_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    // Resets the elements from count to the end of their block (the blocks after it are removed by resize).
+    void shrink(size_t count)
+    {
+        size_t end = (std::min)(size_, (count + N - 1) / N * N);
+        for (size_t i = count; i < end; i++) {
+            refl::util::for_each(members{}, [&](auto member) {
+                blocks_[i / N][member][i % N] = soa_detail::underlying_type<decltype(member)>();
+            });
+        }
+    }
+
+    std::vector<block_type> blocks_;
+    size_t size_ = 0;
+};
+
+#endif // REFL_EXAMPLES_AOSOA_VECTOR_HPP
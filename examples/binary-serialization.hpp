@@ -0,0 +1,851 @@
+/**
+ * ***README***
+ * A compact binary serializer driven by refl-cpp field descriptors.
+ * Used by example-binary-serialization.cpp and bench/bench-serialize-binary.cpp.
+ *
+ * serialize_binary(value, out) appends the non-static fields of value to out in declaration
+ * order, in native byte order, without names or padding. Strings and vectors are prefixed
+ * with their size as a uint64_t. Reflected field types are serialized recursively.
+ *
+ * Types whose object representation is exactly their serialized representation are called
+ * blittable here (arithmetic types, enum classes, arrays of those and reflected trivially-copyable
+ * types without padding or unreflected fields). bool is not blittable: not every byte is a valid
+ * bool, so bools are written as one byte and checked to be 0 or 1 when they are read. Unscoped
+ * enums are not supported, since they may not be able to hold every value of their underlying type. Adjacent blittable fields are grouped into runs
+ * at compile-time and each run is written with a single memcpy of constant size, provided that
+ * the fields are also adjacent in memory. That last check compares the addresses of the fields
+ * (obtained through field_descriptor::pointer) and is folded into a constant by the compiler.
+ * Vectors and arrays of blittable types are written with a single memcpy as well.
+ *
+ * deserialize_binary(data, size, value) reads the value back (reusing the same memcpy runs),
+ * while binary_view<T> decodes fields on demand straight from the buffer, without copying
+ * or allocating anything. Both validate their input, so they can be used on untrusted data.
+ */
+#ifndef REFL_EXAMPLES_BINARY_SERIALIZATION_HPP
+#define REFL_EXAMPLES_BINARY_SERIALIZATION_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "refl.hpp"
+
+namespace binary_detail
+{
+    // the type of the size prefix of strings and vectors
+    using size_type = uint64_t;
+
+    template <typename T>
+    struct is_vector : std::false_type {};
+
+    template <typename T, typename Allocator>
+    struct is_vector<std::vector<T, Allocator>> : std::true_type {};
+
+    template <typename T>
+    struct is_string : std::false_type {};
+
+    template <typename Traits, typename Allocator>
+    struct is_string<std::basic_string<char, Traits, Allocator>> : std::true_type {};
+
+    template <typename T>
+    struct is_std_array : std::false_type {};
+
+    template <typename T, size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    // the members which are serialized (non-static fields)
+    template <typename T>
+    static constexpr auto fields = filter(refl::member_list<T>{}, [](auto member) {
+        if constexpr (refl::descriptor::is_field(member)) {
+            return !refl::descriptor::is_static(member);
+        }
+        else {
+            return false;
+        }
+    });
+
+    template <typename T>
+    using fields_t = std::remove_const_t<decltype(fields<T>)>;
+
+    template <typename Member>
+    using field_type = std::remove_cv_t<typename Member::value_type>;
+
+    template <typename T>
+    constexpr bool is_blittable();
+
+    template <typename T, typename... Members>
+    constexpr bool are_fields_blittable(refl::type_list<Members...>)
+    {
+        // the sizes must add up, otherwise there is padding or some fields are not reflected
+        return (is_blittable<field_type<Members>>() && ...)
+            && (sizeof(field_type<Members>) + ... + 0) == sizeof(T);
+    }
+
+    template <typename T>
+    constexpr bool is_blittable()
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return false;
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            static_assert(!std::is_convertible_v<T, std::underlying_type_t<T>>,
+                "Unscoped enums are not supported by the binary format (use an enum class)!");
+            return true;
+        }
+        else if constexpr (std::is_arithmetic_v<T>) {
+            return true;
+        }
+        else if constexpr (std::is_array_v<T>) {
+            return is_blittable<std::remove_extent_t<T>>();
+        }
+        else if constexpr (is_std_array<T>::value) {
+            return is_blittable<typename T::value_type>()
+                && sizeof(T) == sizeof(typename T::value_type) * std::tuple_size_v<T>;
+        }
+        else if constexpr (refl::trait::is_reflectable_v<T> && std::is_trivially_copyable_v<T>) {
+            return are_fields_blittable<T>(fields<T>);
+        }
+        else {
+            return false;
+        }
+    }
+
+    template <typename T>
+    constexpr bool is_blittable_vector()
+    {
+        if constexpr (is_vector<T>::value) {
+            return is_blittable<typename T::value_type>();
+        }
+        else {
+            return false;
+        }
+    }
+
+    struct field_layout
+    {
+        size_t size;
+        size_t align;
+        bool blittable;
+    };
+
+    // A group of adjacent fields written with a single memcpy (or a single non-blittable field, when size is 0).
+    struct run
+    {
+        size_t first;
+        size_t count;
+        size_t size;
+    };
+
+    template <typename... Members>
+    constexpr std::array<field_layout, sizeof...(Members)> make_field_layouts(refl::type_list<Members...>)
+    {
+        return { { field_layout{ sizeof(field_type<Members>), alignof(field_type<Members>), is_blittable<field_type<Members>>() }... } };
+    }
+
+    // Finds the run starting at fields[first]. A blittable field is added to the current run
+    // when its natural position (right after the previous field) is suitably aligned.
+    template <size_t N>
+    constexpr run next_run(const std::array<field_layout, N>& fields, size_t first)
+    {
+        if (!fields[first].blittable) {
+            return { first, 1, 0 };
+        }
+
+        size_t size = fields[first].size;
+        size_t last = first + 1;
+        while (last < N && fields[last].blittable
+            && fields[last].align <= fields[first].align && size % fields[last].align == 0) {
+            size += fields[last].size;
+            last++;
+        }
+        return { first, last - first, size };
+    }
+
+    template <size_t N>
+    constexpr size_t count_runs(const std::array<field_layout, N>& fields)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < N; i += next_run(fields, i).count) {
+            count++;
+        }
+        return count;
+    }
+
+    template <size_t R, size_t N>
+    constexpr std::array<run, R> make_runs(const std::array<field_layout, N>& fields)
+    {
+        std::array<run, R> runs{};
+        for (size_t i = 0, r = 0; i < N; i += runs[r++].count) {
+            runs[r] = next_run(fields, i);
+        }
+        return runs;
+    }
+
+    template <typename T>
+    struct field_runs
+    {
+        static constexpr auto layouts = make_field_layouts(fields<T>);
+        static constexpr size_t count = count_runs(layouts);
+        static constexpr std::array<run, count> runs = make_runs<count>(layouts);
+    };
+
+    template <size_t I, typename T>
+    using field_at = refl::trait::get_t<I, fields_t<T>>;
+
+    template <size_t I, typename T>
+    auto address_of(T& value)
+    {
+        using byte_type = std::conditional_t<std::is_const_v<T>, const unsigned char, unsigned char>;
+        return reinterpret_cast<byte_type*>(&(value.*field_at<I, std::remove_const_t<T>>::pointer));
+    }
+
+    // Checks whether the fields of a run are laid out back-to-back in memory.
+    // The member pointers are constants, so this whole function is folded into a constant.
+    template <size_t First, typename T, size_t... Idx>
+    bool is_contiguous(const T& value, std::index_sequence<Idx...>)
+    {
+        const unsigned char* base = address_of<First>(value);
+        size_t offset = 0;
+        bool contiguous = true;
+        ((contiguous = contiguous && address_of<First + Idx>(value) == base + offset,
+            offset += sizeof(field_type<field_at<First + Idx, T>>)), ...);
+        return contiguous;
+    }
+
+    template <typename T>
+    size_t size_of(const T& value);
+
+    template <typename T>
+    void write(unsigned char*& out, const T& value);
+
+    inline void write_bytes(unsigned char*& out, const void* data, size_t size)
+    {
+        // data is null for empty vectors
+        if (size == 0) return;
+        std::memcpy(out, data, size);
+        out += size;
+    }
+
+    template <size_t R, typename T>
+    size_t size_of_run(const T& value)
+    {
+        constexpr run current = field_runs<T>::runs[R];
+        if constexpr (current.size == 0) {
+            return size_of(value.*field_at<current.first, T>::pointer);
+        }
+        else {
+            return current.size;
+        }
+    }
+
+    template <typename T, size_t... R>
+    size_t size_of_fields(const T& value, std::index_sequence<R...>)
+    {
+        return (size_of_run<R>(value) + ... + 0);
+    }
+
+    template <size_t R, typename T, size_t... Idx>
+    void write_run(unsigned char*& out, const T& value, std::index_sequence<Idx...> indices)
+    {
+        constexpr run current = field_runs<T>::runs[R];
+        if constexpr (current.size == 0) {
+            write(out, value.*field_at<current.first, T>::pointer);
+        }
+        else if (is_contiguous<current.first>(value, indices)) {
+            write_bytes(out, address_of<current.first>(value), current.size);
+        }
+        else {
+            (write_bytes(out, address_of<current.first + Idx>(value), sizeof(field_type<field_at<current.first + Idx, T>>)), ...);
+        }
+    }
+
+    template <typename T, size_t... R>
+    void write_fields(unsigned char*& out, const T& value, std::index_sequence<R...>)
+    {
+        (write_run<R>(out, value, std::make_index_sequence<field_runs<T>::runs[R].count>{}), ...);
+    }
+
+    template <typename T>
+    size_t size_of(const T& value)
+    {
+        if constexpr (is_blittable<T>()) {
+            return sizeof(T);
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            return 1;
+        }
+        else if constexpr (is_string<T>::value) {
+            return sizeof(size_type) + value.size();
+        }
+        else if constexpr (is_blittable_vector<T>()) {
+            return sizeof(size_type) + value.size() * sizeof(typename T::value_type);
+        }
+        else if constexpr (is_vector<T>::value || is_std_array<T>::value) {
+            size_t size = is_vector<T>::value ? sizeof(size_type) : 0;
+            for (const auto& element : value) {
+                size += size_of(element);
+            }
+            return size;
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by serialize_binary!");
+            return size_of_fields(value, std::make_index_sequence<field_runs<T>::count>{});
+        }
+    }
+
+    template <typename T>
+    void write(unsigned char*& out, const T& value)
+    {
+        if constexpr (is_blittable<T>()) {
+            write_bytes(out, &value, sizeof(T));
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            unsigned char byte = value;
+            write_bytes(out, &byte, 1);
+        }
+        else if constexpr (is_string<T>::value || is_blittable_vector<T>()) {
+            size_type size = value.size();
+            write_bytes(out, &size, sizeof(size));
+            write_bytes(out, value.data(), value.size() * sizeof(typename T::value_type));
+        }
+        else if constexpr (is_vector<T>::value || is_std_array<T>::value) {
+            if constexpr (is_vector<T>::value) {
+                size_type size = value.size();
+                write_bytes(out, &size, sizeof(size));
+            }
+            for (const auto& element : value) {
+                write(out, element);
+            }
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by serialize_binary!");
+            write_fields(out, value, std::make_index_sequence<field_runs<T>::count>{});
+        }
+    }
+}
+
+/** Returns the number of bytes serialize_binary(value, out) appends to out. */
+template <typename T>
+size_t serialized_binary_size(const T& value)
+{
+    return binary_detail::size_of(value);
+}
+
+/**
+ * Appends the binary representation of value to out (a std::string, std::vector<char>,
+ * std::vector<unsigned char> or any other contiguous container of bytes).
+ * out is grown only once, by the exact size of the representation.
+ */
+template <typename T, typename Buffer>
+void serialize_binary(const T& value, Buffer& out)
+{
+    static_assert(sizeof(typename Buffer::value_type) == 1, "serialize_binary requires a buffer of bytes!");
+
+    size_t offset = out.size();
+    out.resize(offset + binary_detail::size_of(value));
+    unsigned char* pos = reinterpret_cast<unsigned char*>(out.data()) + offset;
+    binary_detail::write(pos, value);
+}
+
+template <typename T>
+class binary_view;
+
+namespace binary_detail
+{
+    struct reader
+    {
+        const unsigned char* pos;
+        const unsigned char* end;
+
+        const unsigned char* take(size_t size)
+        {
+            if (static_cast<size_t>(end - pos) < size) {
+                throw std::runtime_error("Unexpected end of binary input!");
+            }
+            const unsigned char* data = pos;
+            pos += size;
+            return data;
+        }
+
+        const unsigned char* take_array(size_t count, size_t element_size)
+        {
+            if (count > static_cast<size_t>(end - pos) / element_size) {
+                throw std::runtime_error("Unexpected end of binary input!");
+            }
+            return take(count * element_size);
+        }
+
+        void read_bytes(void* out, size_t size)
+        {
+            std::memcpy(out, take(size), size);
+        }
+
+        size_t read_size()
+        {
+            size_type size;
+            read_bytes(&size, sizeof(size));
+            return static_cast<size_t>(size);
+        }
+
+        bool read_bool()
+        {
+            unsigned char byte = *take(1);
+            if (byte > 1) {
+                throw std::runtime_error("Invalid bool in binary input!");
+            }
+            return byte != 0;
+        }
+    };
+
+    // The smallest possible serialized size of a T. Used to reject impossible element counts early.
+    template <typename T>
+    constexpr size_t min_size()
+    {
+        if constexpr (is_blittable<T>()) {
+            return sizeof(T);
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            return 1;
+        }
+        else if constexpr (is_string<T>::value || is_vector<T>::value) {
+            return sizeof(size_type);
+        }
+        else if constexpr (is_std_array<T>::value) {
+            return min_size<typename T::value_type>() * std::tuple_size_v<T>;
+        }
+        else {
+            return refl::util::accumulate(fields<T>, [](size_t size, auto member) {
+                return size + min_size<field_type<decltype(member)>>();
+            }, size_t(0));
+        }
+    }
+
+    template <typename T>
+    size_t read_count(reader& in)
+    {
+        size_t count = in.read_size();
+        if constexpr (min_size<T>() > 0) {
+            if (count > static_cast<size_t>(in.end - in.pos) / min_size<T>()) {
+                throw std::runtime_error("Unexpected end of binary input!");
+            }
+        }
+        return count;
+    }
+
+    template <typename T>
+    void read(reader& in, T& value);
+
+    template <size_t R, typename T, size_t... Idx>
+    void read_run(reader& in, T& value, std::index_sequence<Idx...> indices)
+    {
+        constexpr run current = field_runs<T>::runs[R];
+        if constexpr (current.size == 0) {
+            read(in, value.*field_at<current.first, T>::pointer);
+        }
+        else if (is_contiguous<current.first>(value, indices)) {
+            in.read_bytes(address_of<current.first>(value), current.size);
+        }
+        else {
+            (in.read_bytes(address_of<current.first + Idx>(value), sizeof(field_type<field_at<current.first + Idx, T>>)), ...);
+        }
+    }
+
+    template <typename T, size_t... R>
+    void read_fields(reader& in, T& value, std::index_sequence<R...>)
+    {
+        (read_run<R>(in, value, std::make_index_sequence<field_runs<T>::runs[R].count>{}), ...);
+    }
+
+    template <typename T>
+    void read(reader& in, T& value)
+    {
+        if constexpr (is_blittable<T>()) {
+            in.read_bytes(&value, sizeof(T));
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            value = in.read_bool();
+        }
+        else if constexpr (is_string<T>::value) {
+            size_t size = in.read_size();
+            value.assign(reinterpret_cast<const char*>(in.take(size)), size);
+        }
+        else if constexpr (is_blittable_vector<T>()) {
+            using element_type = typename T::value_type;
+            size_t size = in.read_size();
+            const unsigned char* data = in.take_array(size, sizeof(element_type));
+            value.resize(size);
+            // data() is null for empty vectors
+            if (size != 0) {
+                std::memcpy(value.data(), data, size * sizeof(element_type));
+            }
+        }
+        else if constexpr (is_vector<T>::value || is_std_array<T>::value) {
+            if constexpr (is_vector<T>::value) {
+                value.resize(read_count<typename T::value_type>(in));
+            }
+            for (auto& element : value) {
+                read(in, element);
+            }
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by deserialize_binary!");
+            static_assert(refl::util::accumulate(fields<T>, [](bool writable, auto member) { return writable && is_writable(member); }, true),
+                "deserialize_binary requires all fields to be writable!");
+            read_fields(in, value, std::make_index_sequence<field_runs<T>::count>{});
+        }
+    }
+
+    // Validates a serialized T and moves past it.
+    template <typename T>
+    void skip(reader& in)
+    {
+        if constexpr (is_blittable<T>()) {
+            in.take(sizeof(T));
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            in.read_bool();
+        }
+        else if constexpr (is_string<T>::value) {
+            in.take(in.read_size());
+        }
+        else if constexpr (is_blittable_vector<T>()) {
+            in.take_array(in.read_size(), sizeof(typename T::value_type));
+        }
+        else if constexpr (is_vector<T>::value || is_std_array<T>::value) {
+            size_t count;
+            if constexpr (is_vector<T>::value) {
+                count = read_count<typename T::value_type>(in);
+            }
+            else {
+                count = std::tuple_size_v<T>;
+            }
+            for (size_t i = 0; i < count; i++) {
+                skip<typename T::value_type>(in);
+            }
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by binary_view!");
+            for_each(fields<T>, [&](auto member) {
+                skip<field_type<decltype(member)>>(in);
+            });
+        }
+    }
+
+    // Returns the end of a serialized T, which has been validated by skip (so nothing is checked).
+    template <typename T>
+    const unsigned char* end_of(const unsigned char* pos) noexcept
+    {
+        if constexpr (is_blittable<T>()) {
+            return pos + sizeof(T);
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            return pos + 1;
+        }
+        else if constexpr (is_string<T>::value || is_blittable_vector<T>()) {
+            size_type size;
+            std::memcpy(&size, pos, sizeof(size));
+            return pos + sizeof(size) + static_cast<size_t>(size) * sizeof(typename T::value_type);
+        }
+        else if constexpr (is_vector<T>::value || is_std_array<T>::value) {
+            size_t count;
+            if constexpr (is_vector<T>::value) {
+                size_type size;
+                std::memcpy(&size, pos, sizeof(size));
+                pos += sizeof(size);
+                count = static_cast<size_t>(size);
+            }
+            else {
+                count = std::tuple_size_v<T>;
+            }
+            for (size_t i = 0; i < count; i++) {
+                pos = end_of<typename T::value_type>(pos);
+            }
+            return pos;
+        }
+        else {
+            for_each(fields<T>, [&](auto member) {
+                pos = end_of<field_type<decltype(member)>>(pos);
+            });
+            return pos;
+        }
+    }
+
+    // Selects the constructor of binary_view for nested values of data which has already been validated.
+    struct validated_t {};
+
+    template <typename T>
+    auto view_at(const unsigned char* data, const unsigned char* end);
+}
+
+/**
+ * A read-only view of a vector of blittable elements inside a binary buffer.
+ * The elements are not necessarily aligned, so they are returned by value.
+ */
+template <typename T>
+class binary_span
+{
+public:
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = T;
+
+        explicit iterator(const unsigned char* pos = nullptr) noexcept : pos_(pos) {}
+
+        T operator*() const noexcept
+        {
+            T value;
+            std::memcpy(&value, pos_, sizeof(T));
+            return value;
+        }
+
+        iterator& operator++() noexcept { pos_ += sizeof(T); return *this; }
+        iterator operator++(int) noexcept { iterator it = *this; ++*this; return it; }
+        bool operator==(const iterator& other) const noexcept { return pos_ == other.pos_; }
+        bool operator!=(const iterator& other) const noexcept { return pos_ != other.pos_; }
+
+    private:
+        const unsigned char* pos_;
+    };
+
+    binary_span(const unsigned char* data, size_t size) noexcept
+        : data_(data), size_(size)
+    {
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /** The serialized elements. */
+    const unsigned char* bytes() const noexcept { return data_; }
+
+    T operator[](size_t index) const noexcept
+    {
+        return *iterator(data_ + index * sizeof(T));
+    }
+
+    iterator begin() const noexcept { return iterator(data_); }
+    iterator end() const noexcept { return iterator(data_ + size_ * sizeof(T)); }
+
+private:
+    const unsigned char* data_;
+    size_t size_;
+};
+
+/**
+ * A read-only view of a vector or array of non-blittable elements inside a binary buffer.
+ * Elements have different sizes, so they can only be visited in order.
+ */
+template <typename T>
+class binary_sequence
+{
+public:
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = decltype(binary_detail::view_at<T>(nullptr, nullptr));
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        iterator(const unsigned char* pos, const unsigned char* end, size_t index) noexcept
+            : pos_(pos), end_(end), index_(index)
+        {
+        }
+
+        value_type operator*() const noexcept
+        {
+            value_type value = binary_detail::view_at<T>(pos_, end_);
+            if constexpr (std::is_same_v<value_type, binary_view<T>>) {
+                // the view has found the end of the element, so operator++ does not walk it again
+                next_ = pos_ + value.byte_size();
+            }
+            return value;
+        }
+
+        iterator& operator++() noexcept
+        {
+            pos_ = next_ != nullptr ? next_ : binary_detail::end_of<T>(pos_);
+            next_ = nullptr;
+            index_++;
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const noexcept { return index_ == other.index_; }
+        bool operator!=(const iterator& other) const noexcept { return index_ != other.index_; }
+
+    private:
+        const unsigned char* pos_;
+        const unsigned char* end_;
+        size_t index_;
+        mutable const unsigned char* next_ = nullptr;
+    };
+
+    binary_sequence(const unsigned char* data, const unsigned char* end, size_t size) noexcept
+        : data_(data), end_(end), size_(size)
+    {
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    iterator begin() const noexcept { return iterator(data_, end_, 0); }
+    iterator end() const noexcept { return iterator(nullptr, nullptr, size_); }
+
+private:
+    const unsigned char* data_;
+    const unsigned char* end_;
+    size_t size_;
+};
+
+/**
+ * A zero-copy view of a T serialized by serialize_binary. Nothing is copied or allocated:
+ * binary_view<T> has a member function for each field of T, which decodes the field on demand
+ * straight from the buffer (which must outlive the view). Fields are returned as:
+ * <ul>
+ * <li>blittable types - by value</li>
+ * <li>std::string - std::string_view</li>
+ * <li>std::vector of blittable types - binary_span</li>
+ * <li>std::vector or std::array of other types - binary_sequence</li>
+ * <li>other reflected types - binary_view</li>
+ * </ul>
+ * The whole serialized value is validated when the view is created, and the views of its
+ * fields and elements are created without validating them again.
+ */
+template <typename T>
+class binary_view : public refl::runtime::proxy<binary_view<T>, T>
+{
+public:
+
+    /** Throws std::runtime_error when the data does not contain a complete T. */
+    binary_view(const void* data, size_t size)
+        : bytes_(static_cast<const unsigned char*>(data))
+        , end_(bytes_ + size)
+    {
+        binary_detail::reader in{ bytes_, end_ };
+        for_each(binary_detail::fields<T>, [&](auto member, size_t index) {
+            offsets_[index] = static_cast<size_t>(in.pos - bytes_);
+            binary_detail::skip<binary_detail::field_type<decltype(member)>>(in);
+        });
+        offsets_.back() = static_cast<size_t>(in.pos - bytes_);
+    }
+
+    /** Creates a view of data which is part of a validated value, which is not validated again. */
+    binary_view(const unsigned char* data, const unsigned char* end, binary_detail::validated_t) noexcept
+        : bytes_(data)
+        , end_(end)
+    {
+        const unsigned char* pos = bytes_;
+        for_each(binary_detail::fields<T>, [&](auto member, size_t index) {
+            offsets_[index] = static_cast<size_t>(pos - bytes_);
+            pos = binary_detail::end_of<binary_detail::field_type<decltype(member)>>(pos);
+        });
+        offsets_.back() = static_cast<size_t>(pos - bytes_);
+    }
+
+    /** The number of bytes occupied by the serialized value. */
+    size_t byte_size() const noexcept
+    {
+        return offsets_.back();
+    }
+
+    template <typename Member, typename Self>
+    static auto invoke_impl(Self&& self)
+    {
+        constexpr ptrdiff_t index = refl::trait::index_of_v<Member, binary_detail::fields_t<T>>;
+        static_assert(index != -1, "Only non-static fields are available in a binary_view!");
+        using value_type = binary_detail::field_type<Member>;
+        return binary_detail::view_at<value_type>(self.bytes_ + self.offsets_[index], self.end_);
+    }
+
+private:
+    const unsigned char* bytes_;
+    const unsigned char* end_;
+    std::array<size_t, binary_detail::fields<T>.size + 1> offsets_;
+};
+
+namespace binary_detail
+{
+    template <typename T>
+    auto view_at(const unsigned char* data, const unsigned char* end)
+    {
+        if constexpr (is_blittable<T>()) {
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            // checked when the enclosing value was validated
+            return *data != 0;
+        }
+        else if constexpr (is_string<T>::value) {
+            size_type size;
+            std::memcpy(&size, data, sizeof(size));
+            return std::string_view(reinterpret_cast<const char*>(data + sizeof(size)), static_cast<size_t>(size));
+        }
+        else if constexpr (is_blittable_vector<T>()) {
+            size_type size;
+            std::memcpy(&size, data, sizeof(size));
+            return binary_span<typename T::value_type>(data + sizeof(size), static_cast<size_t>(size));
+        }
+        else if constexpr (is_vector<T>::value) {
+            size_type size;
+            std::memcpy(&size, data, sizeof(size));
+            return binary_sequence<typename T::value_type>(data + sizeof(size), end, static_cast<size_t>(size));
+        }
+        else if constexpr (is_std_array<T>::value) {
+            return binary_sequence<typename T::value_type>(data, end, std::tuple_size_v<T>);
+        }
+        else {
+            return binary_view<T>(data, end, validated_t{});
+        }
+    }
+}
+
+/**
+ * Validates the T serialized in the first size bytes at data and returns a zero-copy view of it
+ * (a binary_view<T> for reflected types, see binary_view for the other types).
+ * Throws std::runtime_error when the data does not contain a complete T.
+ */
+template <typename T>
+auto view_binary(const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    if constexpr (!binary_detail::is_blittable<T>() && refl::trait::is_reflectable_v<T>
+        && !binary_detail::is_string<T>::value && !binary_detail::is_vector<T>::value && !binary_detail::is_std_array<T>::value) {
+        return binary_view<T>(bytes, size);
+    }
+    else {
+        binary_detail::reader in{ bytes, bytes + size };
+        binary_detail::skip<T>(in);
+        return binary_detail::view_at<T>(bytes, bytes + size);
+    }
+}
+
+/**
+ * Reads a T written by serialize_binary from the first size bytes at data into value
+ * and returns the number of bytes read. Existing strings and vectors are reused.
+ * Throws std::runtime_error when the data does not contain a complete T.
+ */
+template <typename T>
+size_t deserialize_binary(const void* data, size_t size, T& value)
+{
+    binary_detail::reader in{ static_cast<const unsigned char*>(data), static_cast<const unsigned char*>(data) + size };
+    binary_detail::read(in, value);
+    return static_cast<size_t>(in.pos - static_cast<const unsigned char*>(data));
+}
+
+#endif // REFL_EXAMPLES_BINARY_SERIALIZATION_HPP
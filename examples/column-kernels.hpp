@@ -0,0 +1,323 @@
+/**
+ * ***README***
+ * Element-wise kernels over the columns of a soa_vector (see soa-vector.hpp).
+ * Used by example-column-kernels.cpp and bench/bench-column-ops.cpp.
+ *
+ * The columns are exposed as column_span<V>, a pointer and a size, where the pointer is known to be
+ * 64-byte aligned and not to alias any other column (each member of the vector has its own array):
+ * <ul>
+ * <li>for_each_column(vector, f) calls f(member, span) for each arithmetic column</li>
+ * <li>transform_columns(vector, members, f) calls f(values...) for each element, with references
+ *     to the values of the given members, e.g. [](float& x, float vx) { x += vx * dt; }. The loop
+ *     runs over restrict-qualified, aligned pointers, which compilers vectorize.</li>
+ * <li>column_kernels::scale, add, clamp and sum, which are written with SSE or AVX intrinsics
+ *     for float and double columns (whichever the compiler targets, e.g. with -mavx2), and fall
+ *     back to plain loops for other types and targets</li>
+ * </ul>
+ * The vectorized sum adds the values in a different order than a plain loop, so the results of
+ * float columns can differ in the last bits.
+ */
+#ifndef REFL_EXAMPLES_COLUMN_KERNELS_HPP
+#define REFL_EXAMPLES_COLUMN_KERNELS_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include "refl.hpp"
+#include "soa-vector.hpp"
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define REFL_EXAMPLES_RESTRICT __restrict
+#else
+#define REFL_EXAMPLES_RESTRICT
+#endif
+
+namespace column_detail
+{
+    template <typename V>
+    V* assume_aligned(V* data) noexcept
+    {
+#if defined(__GNUC__)
+        return static_cast<V*>(__builtin_assume_aligned(data, soa_detail::column_alignment));
+#else
+        return data;
+#endif
+    }
+
+    // The vector instructions for columns of V (width is 0 when there are none).
+    template <typename V>
+    struct simd
+    {
+        static constexpr size_t width = 0;
+    };
+
+#if defined(__AVX__)
+    template <>
+    struct simd<float>
+    {
+        using type = __m256;
+        static constexpr size_t width = 8;
+        static type load(const float* data) noexcept { return _mm256_load_ps(data); }
+        static void store(float* data, type value) noexcept { _mm256_store_ps(data, value); }
+        static type set1(float value) noexcept { return _mm256_set1_ps(value); }
+        static type zero() noexcept { return _mm256_setzero_ps(); }
+        static type add(type a, type b) noexcept { return _mm256_add_ps(a, b); }
+        static type mul(type a, type b) noexcept { return _mm256_mul_ps(a, b); }
+        static type min(type a, type b) noexcept { return _mm256_min_ps(a, b); }
+        static type max(type a, type b) noexcept { return _mm256_max_ps(a, b); }
+        static float reduce(type value) noexcept
+        {
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+            return _mm_cvtss_f32(sum);
+        }
+    };
+
+    template <>
+    struct simd<double>
+    {
+        using type = __m256d;
+        static constexpr size_t width = 4;
+        static type load(const double* data) noexcept { return _mm256_load_pd(data); }
+        static void store(double* data, type value) noexcept { _mm256_store_pd(data, value); }
+        static type set1(double value) noexcept { return _mm256_set1_pd(value); }
+        static type zero() noexcept { return _mm256_setzero_pd(); }
+        static type add(type a, type b) noexcept { return _mm256_add_pd(a, b); }
+        static type mul(type a, type b) noexcept { return _mm256_mul_pd(a, b); }
+        static type min(type a, type b) noexcept { return _mm256_min_pd(a, b); }
+        static type max(type a, type b) noexcept { return _mm256_max_pd(a, b); }
+        static double reduce(type value) noexcept
+        {
+            __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+        }
+    };
+#elif defined(__SSE2__) || defined(_M_X64)
+    template <>
+    struct simd<float>
+    {
+        using type = __m128;
+        static constexpr size_t width = 4;
+        static type load(const float* data) noexcept { return _mm_load_ps(data); }
+        static void store(float* data, type value) noexcept { _mm_store_ps(data, value); }
+        static type set1(float value) noexcept { return _mm_set1_ps(value); }
+        static type zero() noexcept { return _mm_setzero_ps(); }
+        static type add(type a, type b) noexcept { return _mm_add_ps(a, b); }
+        static type mul(type a, type b) noexcept { return _mm_mul_ps(a, b); }
+        static type min(type a, type b) noexcept { return _mm_min_ps(a, b); }
+        static type max(type a, type b) noexcept { return _mm_max_ps(a, b); }
+        static float reduce(type value) noexcept
+        {
+            __m128 sum = _mm_add_ps(value, _mm_movehl_ps(value, value));
+            sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+            return _mm_cvtss_f32(sum);
+        }
+    };
+
+    template <>
+    struct simd<double>
+    {
+        using type = __m128d;
+        static constexpr size_t width = 2;
+        static type load(const double* data) noexcept { return _mm_load_pd(data); }
+        static void store(double* data, type value) noexcept { _mm_store_pd(data, value); }
+        static type set1(double value) noexcept { return _mm_set1_pd(value); }
+        static type zero() noexcept { return _mm_setzero_pd(); }
+        static type add(type a, type b) noexcept { return _mm_add_pd(a, b); }
+        static type mul(type a, type b) noexcept { return _mm_mul_pd(a, b); }
+        static type min(type a, type b) noexcept { return _mm_min_pd(a, b); }
+        static type max(type a, type b) noexcept { return _mm_max_pd(a, b); }
+        static double reduce(type value) noexcept
+        {
+            return _mm_cvtsd_f64(_mm_add_sd(value, _mm_unpackhi_pd(value, value)));
+        }
+    };
+#endif
+
+    template <typename T, typename... Members>
+    constexpr bool are_distinct_columns() noexcept
+    {
+        size_t indices[] = { soa_detail::column_index<T, Members>()... };
+        for (size_t i = 0; i < sizeof...(Members); i++) {
+            for (size_t j = 0; j < i; j++) {
+                if (indices[i] == indices[j]) return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename F, typename... V>
+    void transform(size_t size, F& f, V* REFL_EXAMPLES_RESTRICT... columns)
+    {
+        for (size_t i = 0; i < size; i++) {
+            f(columns[i]...);
+        }
+    }
+}
+
+/**
+ * A column of a soa_vector: size() values at a 64-byte aligned address, which no other column aliases.
+ */
+template <typename V>
+class column_span
+{
+public:
+    /**
+     * data must be 64-byte aligned (as the columns of a soa_vector are), since the kernels
+     * use aligned loads and stores.
+     */
+    column_span(V* data, size_t size) noexcept
+        : data_(data), size_(size)
+    {
+        assert(reinterpret_cast<uintptr_t>(data) % soa_detail::column_alignment == 0 && "The column is not 64-byte aligned!");
+    }
+
+    V* data() const noexcept { return column_detail::assume_aligned(data_); }
+    size_t size() const noexcept { return size_; }
+
+    V& operator[](size_t index) const noexcept { return data_[index]; }
+
+    V* begin() const noexcept { return data(); }
+    V* end() const noexcept { return data_ + size_; }
+
+private:
+    V* data_;
+    size_t size_;
+};
+
+/**
+ * Calls f(member, span) for each column of arithmetic values of the vector, where span is a
+ * column_span (of const values if the vector is const).
+ */
+template <typename Vector, typename F>
+void for_each_column(Vector& vector, F&& f)
+{
+    refl::util::for_each(typename std::remove_const_t<Vector>::members{}, [&](auto member) {
+        using value_type = std::remove_pointer_t<decltype(vector.data(member))>;
+        if constexpr (std::is_arithmetic_v<std::remove_const_t<value_type>>) {
+            f(member, column_span<value_type>(vector.data(member), vector.size()));
+        }
+    });
+}
+
+/**
+ * Calls f with references to the values of the members (getters or fields) of each element.
+ * \code{.cpp}
+ * transform_columns(particles, refl::type_list<x_member, vx_member>{}, [](float& x, float vx) {
+ *     x += vx * dt;
+ * });
+ * \endcode
+ */
+template <typename T, typename... Members, typename F>
+void transform_columns(soa_vector<T>& vector, refl::type_list<Members...>, F&& f)
+{
+    static_assert(sizeof...(Members) > 0, "No members were given!");
+    static_assert(column_detail::are_distinct_columns<T, Members...>(), "A member is given more than once!");
+    column_detail::transform(vector.size(), f, column_detail::assume_aligned(vector.data(Members{}))...);
+}
+
+/**
+ * Kernels for common operations on columns, vectorized for float and double columns.
+ */
+namespace column_kernels
+{
+    /** Multiplies every value by factor. */
+    template <typename V>
+    void scale(column_span<V> column, V factor) noexcept
+    {
+        V* REFL_EXAMPLES_RESTRICT data = column.data();
+        size_t i = 0;
+        using simd = column_detail::simd<V>;
+        if constexpr (simd::width != 0) {
+            auto factors = simd::set1(factor);
+            for (; i + simd::width <= column.size(); i += simd::width) {
+                simd::store(data + i, simd::mul(simd::load(data + i), factors));
+            }
+        }
+        for (; i < column.size(); i++) {
+            data[i] *= factor;
+        }
+    }
+
+    /** Adds the values of source (a different column of the same size) to those of target. */
+    template <typename V>
+    void add(column_span<V> target, column_span<const V> source) noexcept
+    {
+        assert(target.size() == source.size());
+        V* REFL_EXAMPLES_RESTRICT data = target.data();
+        const V* REFL_EXAMPLES_RESTRICT values = source.data();
+        size_t i = 0;
+        using simd = column_detail::simd<V>;
+        if constexpr (simd::width != 0) {
+            for (; i + simd::width <= target.size(); i += simd::width) {
+                simd::store(data + i, simd::add(simd::load(data + i), simd::load(values + i)));
+            }
+        }
+        for (; i < target.size(); i++) {
+            data[i] += values[i];
+        }
+    }
+
+    template <typename V>
+    void add(column_span<V> target, column_span<V> source) noexcept
+    {
+        add(target, column_span<const V>(source.data(), source.size()));
+    }
+
+    /** Limits every value to [low, high]. NaN values are left unchanged. */
+    template <typename V>
+    void clamp(column_span<V> column, V low, V high) noexcept
+    {
+        assert(!(high < low));
+        V* REFL_EXAMPLES_RESTRICT data = column.data();
+        size_t i = 0;
+        using simd = column_detail::simd<V>;
+        if constexpr (simd::width != 0) {
+            auto lows = simd::set1(low);
+            auto highs = simd::set1(high);
+            for (; i + simd::width <= column.size(); i += simd::width) {
+                // min and max return their second operand when either is NaN, so NaN values pass through
+                simd::store(data + i, simd::min(highs, simd::max(lows, simd::load(data + i))));
+            }
+        }
+        for (; i < column.size(); i++) {
+            data[i] = data[i] < low ? low : high < data[i] ? high : data[i];
+        }
+    }
+
+    /** The sum of the values. */
+    template <typename V>
+    std::remove_const_t<V> sum(column_span<V> column) noexcept
+    {
+        using value_type = std::remove_const_t<V>;
+        const value_type* data = column.data();
+        value_type total{};
+        size_t i = 0;
+        using simd = column_detail::simd<value_type>;
+        if constexpr (simd::width != 0) {
+            // two accumulators, to hide the latency of the additions
+            auto a = simd::zero();
+            auto b = simd::zero();
+            for (; i + 2 * simd::width <= column.size(); i += 2 * simd::width) {
+                a = simd::add(a, simd::load(data + i));
+                b = simd::add(b, simd::load(data + i + simd::width));
+            }
+            total = simd::reduce(simd::add(a, b));
+        }
+        for (; i < column.size(); i++) {
+            total += data[i];
+        }
+        return total;
+    }
+}
+
+#undef REFL_EXAMPLES_RESTRICT
+
+#endif // REFL_EXAMPLES_COLUMN_KERNELS_HPP
@@ -0,0 +1,446 @@
+/**
+ * ***README***
+ * A conversion between ranges of reflected types and columnar batches, with the buffer layout
+ * of Apache Arrow. Used by example-columnar.cpp and bench/bench-columnar-export.cpp.
+ *
+ * to_columnar(rows) stores each readable member (field or getter property) of the rows in a
+ * column<V>, where V is the type of the member:
+ * <ul>
+ * <li>integers, floating point numbers and enums - one contiguous buffer of values</li>
+ * <li>bool - a bitmap of the values (bit i % 8 of byte i / 8 is set when row i is true)</li>
+ * <li>std::string - rows + 1 int64_t offsets and a buffer of the characters of all rows, back
+ *     to back (row i is [offsets[i], offsets[i + 1]), as in Arrow's large string layout)</li>
+ * <li>std::optional of those - the column of the value type (with a zero or an empty string for
+ *     null rows) and a validity bitmap (bit i % 8 of byte i / 8 is set when row i has a value)</li>
+ * </ul>
+ * All buffers are 64-byte aligned and padded to a multiple of 64 bytes. The rows are copied in
+ * blocks of a few hundred, which are written to every column while they are in the cache, in two
+ * passes: the first computes the offsets of the strings (so that their characters are copied into a
+ * buffer of the right size) and the second copies the values. Getters are called in both passes;
+ * a string whose length differs in the second is cut (or padded with zeros) to its first length.
+ *
+ * from_columnar(batch) converts a batch back into a std::vector of rows, through the writers
+ * of the members (fields or setter properties). Read-only members are skipped.
+ */
+#ifndef REFL_EXAMPLES_COLUMNAR_HPP
+#define REFL_EXAMPLES_COLUMNAR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "refl.hpp"
+
+namespace columnar_detail
+{
+    static constexpr size_t buffer_alignment = 64;
+
+    // the number of rows which are copied to (or from) all columns at a time
+    static constexpr size_t block_size = 256;
+
+    // the members which are stored (fields and getter properties)
+    template <typename T>
+    static constexpr auto members = filter(refl::member_list<T>{}, [](auto member) { return is_readable(member); });
+
+    template <typename T>
+    using members_t = std::remove_const_t<decltype(members<T>)>;
+
+    template <typename Member>
+    using value_type = refl::trait::remove_qualifiers_t<decltype(Member{}(std::declval<const typename Member::declaring_type&>()))>;
+
+    // The value of a row, or a default value for null rows.
+    template <typename V>
+    const V& unwrap(const V& value) noexcept
+    {
+        return value;
+    }
+
+    template <typename V>
+    const V& unwrap(const std::optional<V>& value) noexcept
+    {
+        static const V empty{};
+        return value ? *value : empty;
+    }
+
+    // Assigns a value of a column (see column<V>::operator[]) to a member.
+    template <typename V, typename U>
+    void assign(V& target, const U& value)
+    {
+        target = value;
+    }
+
+    inline void assign(std::string& target, std::string_view value)
+    {
+        target.assign(value.data(), value.size());
+    }
+
+    template <typename V, typename U>
+    void assign(std::optional<V>& target, const std::optional<U>& value)
+    {
+        if (value) {
+            assign(target ? *target : target.emplace(), *value);
+        }
+        else {
+            target.reset();
+        }
+    }
+
+    struct buffer_deleter
+    {
+        void operator()(void* data) const noexcept
+        {
+            ::operator delete(data, std::align_val_t{ buffer_alignment });
+        }
+    };
+}
+
+/**
+ * A zero-initialized, 64-byte aligned buffer of trivial values, padded to a multiple of 64 bytes.
+ */
+template <typename V>
+class aligned_buffer
+{
+public:
+    static_assert(std::is_trivially_copyable_v<V>);
+
+    aligned_buffer() noexcept = default;
+
+    explicit aligned_buffer(size_t size)
+        : size_(size)
+    {
+        if (size != 0) {
+            size_t bytes = (size * sizeof(V) + columnar_detail::buffer_alignment - 1) / columnar_detail::buffer_alignment * columnar_detail::buffer_alignment;
+            data_.reset(::operator new(bytes, std::align_val_t{ columnar_detail::buffer_alignment }));
+            std::memset(data_.get(), 0, bytes);
+        }
+    }
+
+    V* data() noexcept { return static_cast<V*>(data_.get()); }
+    const V* data() const noexcept { return static_cast<const V*>(data_.get()); }
+
+    size_t size() const noexcept { return size_; }
+
+private:
+    std::unique_ptr<void, columnar_detail::buffer_deleter> data_;
+    size_t size_ = 0;
+};
+
+/**
+ * A column of values of a fixed size (integers, floating point numbers and enums).
+ */
+template <typename V>
+class column
+{
+public:
+    static_assert(std::is_arithmetic_v<V> || std::is_enum_v<V>, "Type is not supported by columnar_batch!");
+
+    size_t size() const noexcept { return values_.size(); }
+
+    const V* values() const noexcept { return values_.data(); }
+
+    V operator[](size_t index) const noexcept { return values_.data()[index]; }
+
+    /**
+     * A column is filled in three steps: allocate(count), then measure and fill for consecutive
+     * ranges [begin, end) of the rows, with get(row) as the value of a row (every range is measured
+     * before the first is filled).
+     */
+    void allocate(size_t count)
+    {
+        values_ = aligned_buffer<V>(count);
+    }
+
+    template <typename It, typename Get>
+    void measure(It, size_t, size_t, Get&&) noexcept
+    {
+    }
+
+    template <typename It, typename Get>
+    void fill(It row, size_t begin, size_t end, Get&& get)
+    {
+        V* out = values_.data();
+        for (size_t i = begin; i < end; i++, ++row) {
+            out[i] = columnar_detail::unwrap(get(*row));
+        }
+    }
+
+private:
+    aligned_buffer<V> values_;
+};
+
+/**
+ * A column of bools: a bitmap of the values.
+ */
+template <>
+class column<bool>
+{
+public:
+    size_t size() const noexcept { return size_; }
+
+    /** The bitmap (bit i % 8 of byte i / 8 is the value of row i). */
+    const uint8_t* values() const noexcept { return values_.data(); }
+
+    bool operator[](size_t index) const noexcept { return (values_.data()[index / 8] >> (index % 8)) & 1; }
+
+    void allocate(size_t count)
+    {
+        values_ = aligned_buffer<uint8_t>((count + 7) / 8);
+        size_ = count;
+    }
+
+    template <typename It, typename Get>
+    void measure(It, size_t, size_t, Get&&) noexcept
+    {
+    }
+
+    template <typename It, typename Get>
+    void fill(It row, size_t begin, size_t end, Get&& get)
+    {
+        uint8_t* bits = values_.data();
+        for (size_t i = begin; i < end; i++, ++row) {
+            bits[i / 8] |= static_cast<uint8_t>(columnar_detail::unwrap(get(*row))) << (i % 8);
+        }
+    }
+
+private:
+    aligned_buffer<uint8_t> values_;
+    size_t size_ = 0;
+};
+
+/**
+ * A column of strings: the offsets of the rows in a buffer of characters.
+ */
+template <>
+class column<std::string>
+{
+public:
+    size_t size() const noexcept { return offsets_.size() == 0 ? 0 : offsets_.size() - 1; }
+
+    const int64_t* offsets() const noexcept { return offsets_.data(); }
+
+    const char* data() const noexcept { return data_.data(); }
+
+    std::string_view operator[](size_t index) const noexcept
+    {
+        const int64_t* offsets = offsets_.data();
+        return { data_.data() + offsets[index], static_cast<size_t>(offsets[index + 1] - offsets[index]) };
+    }
+
+    void allocate(size_t count)
+    {
+        offsets_ = aligned_buffer<int64_t>(count + 1);
+        data_ = aligned_buffer<char>();
+    }
+
+    // computes the offsets, so that the characters can be copied into a buffer of the right size
+    template <typename It, typename Get>
+    void measure(It row, size_t begin, size_t end, Get&& get)
+    {
+        int64_t* offsets = offsets_.data();
+        for (size_t i = begin; i < end; i++, ++row) {
+            offsets[i + 1] = offsets[i] + static_cast<int64_t>(columnar_detail::unwrap(get(*row)).size());
+        }
+    }
+
+    template <typename It, typename Get>
+    void fill(It row, size_t begin, size_t end, Get&& get)
+    {
+        const int64_t* offsets = offsets_.data();
+        if (data_.size() == 0 && offsets[size()] != 0) {
+            data_ = aligned_buffer<char>(static_cast<size_t>(offsets[size()]));
+        }
+        char* out = data_.data();
+        for (size_t i = begin; i < end; i++, ++row) {
+            copy(out + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]), columnar_detail::unwrap(get(*row)));
+        }
+    }
+
+private:
+    // copies at most size characters (the length measured in the first pass), in case the getter
+    // returned a longer string the second time
+    static void copy(char* out, size_t size, std::string_view value) noexcept
+    {
+        size = (std::min)(size, value.size());
+        if (size != 0) {
+            std::memcpy(out, value.data(), size);
+        }
+    }
+
+    aligned_buffer<int64_t> offsets_;
+    aligned_buffer<char> data_;
+};
+
+/**
+ * A column of optional values: the column of the values and a validity bitmap.
+ */
+template <typename V>
+class column<std::optional<V>> : public column<V>
+{
+public:
+    const uint8_t* validity() const noexcept { return validity_.data(); }
+
+    size_t null_count() const noexcept { return null_count_; }
+
+    bool is_valid(size_t index) const noexcept { return (validity_.data()[index / 8] >> (index % 8)) & 1; }
+
+    auto operator[](size_t index) const noexcept
+    {
+        using value_type = decltype(column<V>::operator[](index));
+        return is_valid(index) ? std::optional<value_type>(column<V>::operator[](index)) : std::nullopt;
+    }
+
+    void allocate(size_t count)
+    {
+        column<V>::allocate(count);
+        validity_ = aligned_buffer<uint8_t>((count + 7) / 8);
+        null_count_ = 0;
+    }
+
+    template <typename It, typename Get>
+    void fill(It row, size_t begin, size_t end, Get&& get)
+    {
+        column<V>::fill(row, begin, end, get);
+        uint8_t* bits = validity_.data();
+        for (size_t i = begin; i < end; i++, ++row) {
+            bool valid = get(*row).has_value();
+            bits[i / 8] |= static_cast<uint8_t>(valid) << (i % 8);
+            null_count_ += !valid;
+        }
+    }
+
+private:
+    aligned_buffer<uint8_t> validity_;
+    size_t null_count_ = 0;
+};
+
+/**
+ * The readable members of a number of T, stored column by column.
+ */
+template <typename T>
+class columnar_batch
+{
+public:
+    using members = columnar_detail::members_t<T>;
+
+    static constexpr size_t column_count = members::size;
+
+    /**
+     * Fills the batch with the count rows starting at first. The rows are traversed in blocks,
+     * and each block is copied to all columns while it is in the cache.
+     */
+    template <typename It>
+    void assign(It first, size_t count)
+    {
+        refl::util::for_each(members{}, [&](auto member) {
+            (*this)[member].allocate(count);
+        });
+        for_each_block(first, count, [&](It block, size_t begin, size_t end) {
+            refl::util::for_each(members{}, [&](auto member) {
+                (*this)[member].measure(block, begin, end, member);
+            });
+        });
+        for_each_block(first, count, [&](It block, size_t begin, size_t end) {
+            refl::util::for_each(members{}, [&](auto member) {
+                (*this)[member].fill(block, begin, end, member);
+            });
+        });
+        size_ = count;
+    }
+
+    /** The number of rows. */
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /** The column of the member (a descriptor from members). */
+    template <typename Member>
+    auto& operator[](Member) noexcept
+    {
+        return std::get<refl::trait::index_of_v<Member, members>>(columns_);
+    }
+
+    template <typename Member>
+    const auto& operator[](Member) const noexcept
+    {
+        return std::get<refl::trait::index_of_v<Member, members>>(columns_);
+    }
+
+    /** The column of the I-th member. */
+    template <size_t I>
+    const auto& get() const noexcept
+    {
+        return std::get<I>(columns_);
+    }
+
+private:
+    template <typename It, typename F>
+    static void for_each_block(It first, size_t count, F&& f)
+    {
+        for (size_t begin = 0; begin < count; begin += columnar_detail::block_size) {
+            size_t end = (std::min)(begin + columnar_detail::block_size, count);
+            f(first, begin, end);
+            std::advance(first, end - begin);
+        }
+    }
+
+    template <typename Member>
+    struct make_column
+    {
+        using type = column<columnar_detail::value_type<Member>>;
+    };
+
+    size_t size_ = 0;
+    refl::trait::as_tuple_t<refl::trait::map_t<make_column, members>> columns_;
+};
+
+/**
+ * Converts a range of reflected values (e.g. a std::vector<T>) into a columnar batch.
+ */
+template <typename Range>
+auto to_columnar(const Range& rows)
+{
+    using T = refl::trait::remove_qualifiers_t<decltype(*std::begin(rows))>;
+    columnar_batch<T> batch;
+    batch.assign(std::begin(rows), static_cast<size_t>(std::distance(std::begin(rows), std::end(rows))));
+    return batch;
+}
+
+/**
+ * Converts a columnar batch back into rows. T must be default-constructible.
+ */
+template <typename T>
+std::vector<T> from_columnar(const columnar_batch<T>& batch)
+{
+    std::vector<T> rows(batch.size());
+    for (size_t begin = 0; begin < rows.size(); begin += columnar_detail::block_size) {
+        size_t end = (std::min)(begin + columnar_detail::block_size, rows.size());
+        refl::util::for_each(typename columnar_batch<T>::members{}, [&](auto member) {
+            using value_type = columnar_detail::value_type<decltype(member)>;
+            const auto& values = batch[member];
+            if constexpr (refl::descriptor::is_field(member) && refl::descriptor::is_writable(member)) {
+                for (size_t i = begin; i < end; i++) {
+                    columnar_detail::assign(member(rows[i]), values[i]);
+                }
+            }
+            else if constexpr (refl::descriptor::is_function(member) && refl::descriptor::has_writer(member)) {
+                constexpr auto writer = refl::descriptor::get_writer(member);
+                for (size_t i = begin; i < end; i++) {
+                    writer(rows[i], value_type(values[i]));
+                }
+            }
+        });
+    }
+    return rows;
+}
+
+#endif // REFL_EXAMPLES_COLUMNAR_HPP
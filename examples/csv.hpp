@@ -0,0 +1,543 @@
+/**
+ * ***README***
+ * A multi-threaded CSV reader and writer (RFC 4180) for ranges of reflected types.
+ * Used by example-csv.cpp and bench/bench-csv-read.cpp.
+ *
+ * write_csv(rows, out) writes a header with the display names of the readable members
+ * (fields and getter properties) followed by one line per row. read_csv<T>(text) maps the columns
+ * of the header to the writable members of T (fields and properties with a setter) once per
+ * input, through a sorted index of the display names; unknown columns are ignored and members
+ * without a column keep their default value.
+ *
+ * Members can be bool, integers, floating point numbers, enums (written as their underlying
+ * integers), std::string and std::optional of those (an empty cell is std::nullopt). Numbers are
+ * converted with std::from_chars and std::to_chars, so they round-trip exactly and do not
+ * depend on the locale.
+ *
+ * Reading splits the input into chunks which end with a line break, parses them on separate
+ * threads and concatenates the rows in order. Since quoted values can contain line breaks, each
+ * thread first counts the quotes in its part of the input, and the chunk boundaries are chosen
+ * at line breaks where the number of quotes before them is even. Quotes are therefore rejected
+ * outside of quoted values, so that every number of threads accepts the same inputs. Writing formats chunks of rows
+ * in parallel and appends them in order.
+ */
+#ifndef REFL_EXAMPLES_CSV_HPP
+#define REFL_EXAMPLES_CSV_HPP
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "refl.hpp"
+
+namespace csv_detail
+{
+    template <typename T>
+    struct is_optional : std::false_type {};
+
+    template <typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+    // the members which are written (fields and getter properties)
+    template <typename T>
+    static constexpr auto members = filter(refl::member_list<T>{}, [](auto member) { return is_readable(member); });
+
+    // the members which are read (writable fields and getter properties with a matching setter)
+    template <typename T>
+    static constexpr auto writable_members = filter(members<T>, [](auto member) {
+        if constexpr (refl::descriptor::is_field(member)) {
+            return refl::descriptor::is_writable(member);
+        }
+        else {
+            return refl::descriptor::has_writer(member);
+        }
+    });
+
+    template <typename T>
+    using writable_members_t = std::remove_const_t<decltype(writable_members<T>)>;
+
+    // Inputs smaller than this many bytes per thread are read by fewer threads.
+    static constexpr size_t min_chunk_size = 1 << 20;
+
+    inline unsigned thread_count(unsigned threads) noexcept
+    {
+        if (threads == 0) {
+            threads = std::thread::hardware_concurrency();
+        }
+        return threads == 0 ? 1 : threads;
+    }
+
+    // Runs f(0), ..., f(count - 1) on separate threads and rethrows the first exception (in index order).
+    template <typename F>
+    void parallel_for(size_t count, F&& f)
+    {
+        std::vector<std::exception_ptr> errors(count);
+        auto run = [&](size_t index) {
+            try {
+                f(index);
+            }
+            catch (...) {
+                errors[index] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < count; i++) {
+            threads.emplace_back(run, i);
+        }
+        if (count != 0) {
+            run(0);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (const auto& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+
+    /** The display names of the writable members of T, sorted, for looking up the columns of a header. */
+    template <typename T>
+    struct name_index
+    {
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        struct entry
+        {
+            std::string_view name;
+            size_t index;
+        };
+
+        static constexpr std::array<entry, writable_members<T>.size> make() noexcept
+        {
+            std::array<entry, writable_members<T>.size> entries{};
+            for_each(writable_members<T>, [&](auto member, size_t index) {
+                entries[index] = { refl::descriptor::get_display_name_view(member), index };
+            });
+            // insertion sort, which is constexpr
+            for (size_t i = 1; i < entries.size(); i++) {
+                for (size_t j = i; j > 0 && entries[j].name < entries[j - 1].name; j--) {
+                    entry tmp = entries[j];
+                    entries[j] = entries[j - 1];
+                    entries[j - 1] = tmp;
+                }
+            }
+            return entries;
+        }
+
+        static constexpr std::array<entry, writable_members<T>.size> entries = make();
+
+        static size_t find(std::string_view name) noexcept
+        {
+            auto it = std::lower_bound(entries.begin(), entries.end(), name, [](const entry& e, std::string_view key) { return e.name < key; });
+            return it != entries.end() && it->name == name ? it->index : npos;
+        }
+    };
+
+    template <typename T>
+    bool parse_value(std::string_view text, T& value)
+    {
+        if constexpr (is_optional<T>::value) {
+            if (text.empty()) {
+                value.reset();
+                return true;
+            }
+            return parse_value(text, value.emplace());
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            value.assign(text.data(), text.size());
+            return true;
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            if (text == "true" || text == "1") value = true;
+            else if (text == "false" || text == "0") value = false;
+            else return false;
+            return true;
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> underlying;
+            if (!parse_value(text, underlying)) return false;
+            value = static_cast<T>(underlying);
+            return true;
+        }
+        else if constexpr (std::is_arithmetic_v<T>) {
+            const char* end = text.data() + text.size();
+            auto [ptr, ec] = std::from_chars(text.data(), end, value);
+            return ec == std::errc() && ptr == end;
+        }
+        else {
+            static_assert(std::is_same_v<T, void>, "Type is not supported by read_csv!");
+        }
+    }
+
+    inline bool needs_quotes(std::string_view text) noexcept
+    {
+        return text.find_first_of(",\"\r\n") != std::string_view::npos;
+    }
+
+    inline void write_text(std::string& out, std::string_view text)
+    {
+        if (!needs_quotes(text)) {
+            out.append(text);
+            return;
+        }
+        out += '"';
+        for (char c : text) {
+            if (c == '"') out += '"';
+            out += c;
+        }
+        out += '"';
+    }
+
+    template <typename T>
+    void write_value(std::string& out, const T& value)
+    {
+        if constexpr (is_optional<T>::value) {
+            if (value) write_value(out, *value);
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            write_text(out, value);
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            out.append(value ? "true" : "false");
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            write_value(out, static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (std::is_arithmetic_v<T>) {
+            char buffer[64];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, result.ptr);
+        }
+        else {
+            static_assert(std::is_same_v<T, void>, "Type is not supported by write_csv!");
+        }
+    }
+
+    template <typename T>
+    void write_header(std::string& out)
+    {
+        for_each(members<T>, [&](auto member, size_t index) {
+            if (index != 0) out += ',';
+            write_text(out, refl::descriptor::get_display_name_view(member));
+        });
+        out += '\n';
+    }
+
+    template <typename T>
+    void write_row(std::string& out, const T& row)
+    {
+        for_each(members<T>, [&](auto member, size_t index) {
+            if (index != 0) out += ',';
+            write_value(out, member(row));
+        });
+        out += '\n';
+    }
+
+    /** Reads the cells of CSV text. */
+    class reader
+    {
+    public:
+        reader(const char* begin, const char* pos, const char* end) noexcept
+            : begin_(begin), pos_(pos), end_(end)
+        {
+        }
+
+        [[noreturn]] void fail(const char* message) const
+        {
+            fail_at(pos_, message);
+        }
+
+        [[noreturn]] void fail_at(const char* pos, const char* message) const
+        {
+            throw std::runtime_error(std::string("CSV error at offset ") + std::to_string(pos - begin_) + ": " + message);
+        }
+
+        bool at_end() const noexcept
+        {
+            return pos_ == end_;
+        }
+
+        const char* position() const noexcept
+        {
+            return pos_;
+        }
+
+        // Reads the next cell, unescaping it into buffer when it is quoted and contains quotes.
+        std::string_view read_cell(std::string& buffer)
+        {
+            if (pos_ == end_ || *pos_ != '"') {
+                const char* start = pos_;
+                while (pos_ != end_ && *pos_ != ',' && *pos_ != '\n' && *pos_ != '\r') {
+                    // as in RFC 4180, quotes are only allowed in quoted values (split_lines relies on it)
+                    if (*pos_ == '"') fail("unexpected quote in an unquoted value");
+                    pos_++;
+                }
+                return std::string_view(start, static_cast<size_t>(pos_ - start));
+            }
+
+            const char* start = ++pos_;
+            bool escaped = false;
+            while (true) {
+                if (pos_ == end_) fail("unterminated quoted value");
+                if (*pos_ == '"') {
+                    if (pos_ + 1 == end_ || pos_[1] != '"') break;
+                    escaped = true;
+                    pos_ += 2;
+                }
+                else {
+                    pos_++;
+                }
+            }
+            std::string_view text(start, static_cast<size_t>(pos_ - start));
+            pos_++;
+            if (pos_ != end_ && *pos_ != ',' && *pos_ != '\n' && *pos_ != '\r') {
+                fail("expected a separator after a quoted value");
+            }
+            if (!escaped) {
+                return text;
+            }
+            buffer.clear();
+            for (size_t i = 0; i < text.size(); i++) {
+                buffer += text[i];
+                if (text[i] == '"') i++;
+            }
+            return buffer;
+        }
+
+        // Consumes a separator and returns true, or returns false at the end of a line.
+        bool next_cell()
+        {
+            if (pos_ != end_ && *pos_ == ',') {
+                pos_++;
+                return true;
+            }
+            return false;
+        }
+
+        void end_line()
+        {
+            if (pos_ != end_ && *pos_ == '\r') pos_++;
+            if (pos_ != end_) {
+                if (*pos_ != '\n') fail("expected the end of a line");
+                pos_++;
+            }
+        }
+
+    private:
+        const char* begin_;
+        const char* pos_;
+        const char* end_;
+    };
+
+    template <typename T, size_t I>
+    bool read_member(std::string_view text, T& target)
+    {
+        using member = refl::trait::get_t<I, writable_members_t<T>>;
+        if constexpr (refl::descriptor::is_field(member{})) {
+            return parse_value(text, member{}(target));
+        }
+        else {
+            refl::trait::remove_qualifiers_t<decltype(member{}(target))> value{};
+            if (!parse_value(text, value)) return false;
+            constexpr auto writer = refl::descriptor::get_writer(member{});
+            writer(target, std::move(value));
+            return true;
+        }
+    }
+
+    template <typename T, typename = std::make_index_sequence<writable_members<T>.size>>
+    struct member_readers;
+
+    template <typename T, size_t... I>
+    struct member_readers<T, std::index_sequence<I...>>
+    {
+        using reader_type = bool (*)(std::string_view, T&);
+        static constexpr reader_type table[sizeof...(I) > 0 ? sizeof...(I) : 1] = { &read_member<T, I>... };
+    };
+
+    // The reader of each column of the header, or nullptr for unknown columns.
+    template <typename T>
+    using column_readers = std::vector<typename member_readers<T>::reader_type>;
+
+    template <typename T>
+    column_readers<T> read_header(reader& in)
+    {
+        column_readers<T> columns;
+        std::vector<bool> seen(writable_members<T>.size);
+        std::string buffer;
+        do {
+            size_t index = name_index<T>::find(in.read_cell(buffer));
+            if (index != name_index<T>::npos) {
+                if (seen[index]) in.fail("duplicate column");
+                seen[index] = true;
+                columns.push_back(member_readers<T>::table[index]);
+            }
+            else {
+                columns.push_back(nullptr);
+            }
+        } while (in.next_cell());
+        in.end_line();
+        return columns;
+    }
+
+    template <typename T>
+    void read_rows(reader& in, const column_readers<T>& columns, std::vector<T>& rows)
+    {
+        std::string buffer;
+        while (!in.at_end()) {
+            T& row = rows.emplace_back();
+            for (size_t i = 0; i < columns.size(); i++) {
+                if (i != 0 && !in.next_cell()) in.fail("too few values");
+                const char* start = in.position();
+                std::string_view cell = in.read_cell(buffer);
+                if (columns[i] != nullptr && !columns[i](cell, row)) in.fail_at(start, "invalid value");
+            }
+            if (in.next_cell()) in.fail("too many values");
+            in.end_line();
+        }
+    }
+
+    // The ends of at most count chunks of text which end with a line break outside of quotes.
+    inline std::vector<const char*> split_lines(const char* begin, const char* end, size_t count)
+    {
+        size_t size = static_cast<size_t>(end - begin);
+        std::vector<size_t> quotes(count);
+        parallel_for(count, [&](size_t i) {
+            quotes[i] = static_cast<size_t>(std::count(begin + size * i / count, begin + size * (i + 1) / count, '"'));
+        });
+
+        std::vector<const char*> ends;
+        size_t quotes_before = 0;
+        for (size_t i = 1; i < count; i++) {
+            quotes_before += quotes[i - 1];
+            const char* pos = begin + size * i / count;
+            if (!ends.empty() && ends.back() > pos) {
+                // the previous chunk already extends past this part (a very long line)
+                continue;
+            }
+            bool quoted = quotes_before % 2 != 0;
+            while (pos != end && (quoted || *pos != '\n')) {
+                quoted ^= *pos == '"';
+                pos++;
+            }
+            if (pos == end) break;
+            ends.push_back(pos + 1);
+        }
+        ends.push_back(end);
+        return ends;
+    }
+}
+
+/**
+ * Writes a header and the readable members of each element of rows (any range with
+ * random-access iterators) as CSV to out. Chunks of rows are formatted on
+ * up to threads threads (0 means one per core).
+ */
+template <typename Range>
+void write_csv(const Range& rows, std::string& out, unsigned threads = 0)
+{
+    using value_type = refl::trait::remove_qualifiers_t<decltype(*std::begin(rows))>;
+    csv_detail::write_header<value_type>(out);
+
+    auto first = std::begin(rows);
+    size_t size = static_cast<size_t>(std::distance(first, std::end(rows)));
+    size_t count = std::min<size_t>(csv_detail::thread_count(threads), std::max<size_t>(size / 10000, 1));
+    if (count == 1) {
+        for (const auto& row : rows) {
+            csv_detail::write_row(out, row);
+        }
+        return;
+    }
+
+    std::vector<std::string> chunks(count);
+    csv_detail::parallel_for(count, [&](size_t i) {
+        for (auto it = first + size * i / count, last = first + size * (i + 1) / count; it != last; ++it) {
+            csv_detail::write_row(chunks[i], *it);
+        }
+    });
+    for (const auto& chunk : chunks) {
+        out.append(chunk);
+    }
+}
+
+/** Writes rows as CSV to the file at path (see write_csv). Throws std::runtime_error on I/O errors. */
+template <typename Range>
+void write_csv_file(const Range& rows, const std::string& path, unsigned threads = 0)
+{
+    std::string text;
+    write_csv(rows, text, threads);
+    std::ofstream file(path, std::ios::binary);
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (!file) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
+
+/**
+ * Reads the rows of CSV text with a header into default-constructed T's. The text is parsed
+ * in chunks on up to threads threads (0 means one per core), and the rows are returned in order.
+ * Throws std::runtime_error on malformed input.
+ */
+template <typename T>
+std::vector<T> read_csv(std::string_view text, unsigned threads = 0)
+{
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    csv_detail::reader header(begin, begin, end);
+    if (header.at_end()) {
+        return {};
+    }
+    const auto columns = csv_detail::read_header<T>(header);
+
+    const char* body = header.position();
+    size_t count = std::min<size_t>(csv_detail::thread_count(threads), std::max<size_t>(static_cast<size_t>(end - body) / csv_detail::min_chunk_size, 1));
+    std::vector<const char*> ends = csv_detail::split_lines(body, end, count);
+
+    std::vector<std::vector<T>> chunks(ends.size());
+    csv_detail::parallel_for(ends.size(), [&](size_t i) {
+        csv_detail::reader in(begin, i == 0 ? body : ends[i - 1], ends[i]);
+        csv_detail::read_rows(in, columns, chunks[i]);
+    });
+
+    if (chunks.size() == 1) {
+        return std::move(chunks[0]);
+    }
+    size_t size = 0;
+    for (const auto& chunk : chunks) {
+        size += chunk.size();
+    }
+    std::vector<T> rows;
+    rows.reserve(size);
+    for (auto& chunk : chunks) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(rows));
+    }
+    return rows;
+}
+
+/** Reads the rows of the CSV file at path (see read_csv). Throws std::runtime_error on I/O errors and malformed input. */
+template <typename T>
+std::vector<T> read_csv_file(const std::string& path, unsigned threads = 0)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Cannot read " + path);
+    }
+    std::string text(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(text.data(), static_cast<std::streamsize>(text.size()));
+    return read_csv<T>(text, threads);
+}
+
+#endif // REFL_EXAMPLES_CSV_HPP
@@ -0,0 +1,348 @@
+/**
+ * ***README***
+ * A small data access layer which inserts reflected types into a database in batches.
+ * Used by example-dao.cpp and bench/bench-dao-insert.cpp.
+ *
+ * The Table and Column attributes map a type to a table and its fields to columns.
+ * make_sql_create_table<T>() and make_sql_insert<T, Rows>() build the statements at compile-time
+ * with const_strings. The INSERT statement binds Rows rows at once
+ * (INSERT INTO Users (ID, Email) VALUES (?, ?), (?, ?), ...), and a prefix of it binds fewer rows,
+ * so one compile-time string covers every batch size up to Rows.
+ *
+ * bind_buffers<T> holds the parameters of a batch column by column, in the layout which drivers
+ * with array binding consume (e.g. ODBC column-wise binding): one array of 64-bit integers or
+ * doubles per numeric column and the characters of all rows plus an array of offsets per text
+ * column. The buffers are filled one column at a time, straight from a range of T, and are reused
+ * between batches.
+ *
+ * dao<T, BatchSize> executes one statement per BatchSize rows through a Driver, which only has to
+ * provide
+ *     void execute(std::string_view sql, const column_binding* columns, size_t column_count, size_t rows);
+ * (column_count is 0 for statements without parameters).
+ */
+#ifndef REFL_EXAMPLES_DAO_HPP
+#define REFL_EXAMPLES_DAO_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "refl.hpp"
+
+/** An attribute for specifying a DB table's properties */
+struct Table : refl::attr::usage::type
+{
+    const char* name;
+
+    constexpr Table(const char* name) noexcept
+        : name(name)
+    {
+    }
+};
+
+enum class DataType
+{
+    ID,
+    INTEGER,
+    REAL,
+    TEXT,
+};
+
+/** An attribute for specifying a DB column's properties */
+struct Column : refl::attr::usage::field
+{
+    const char* name;
+    const DataType data_type;
+
+    constexpr Column(const char* name, DataType dataType) noexcept
+        : name(name), data_type(dataType)
+    { }
+};
+
+/**
+ * The parameters of one column of a batch, as passed to a driver.
+ */
+struct column_binding
+{
+    const char* name;
+    DataType data_type;
+    // ID and INTEGER: one int64_t per row; REAL: one double per row;
+    // TEXT: the characters of all rows, back to back
+    const void* values;
+    // TEXT: rows + 1 offsets into values, row i is [offsets[i], offsets[i + 1]); otherwise nullptr
+    const uint64_t* offsets;
+};
+
+namespace dao_detail
+{
+    // the fields which are mapped to columns
+    template <typename T>
+    static constexpr auto columns = filter(refl::member_list<T>{}, [](auto member) {
+        return refl::descriptor::has_attribute<Column>(member);
+    });
+
+    template <typename T>
+    static constexpr size_t column_count = columns<T>.size;
+
+    template <typename Member>
+    static constexpr Column column_of = refl::descriptor::get_attribute<Column>(Member{});
+
+    template <typename Member>
+    constexpr auto make_sql_column_name(Member)
+    {
+        // convert the const char* data member to a refl::const_string<N>
+        // (necessary to be able to do compile-time string concat)
+        return REFL_MAKE_CONST_STRING(column_of<Member>.name);
+    }
+
+    // Joins Count copies of item with separator in between.
+    template <size_t Count, size_t N, size_t M>
+    constexpr auto join_repeated(const refl::util::const_string<N>& item, const refl::util::const_string<M>& separator)
+    {
+        refl::util::const_string<Count == 0 ? 0 : Count * N + (Count - 1) * M> result;
+        size_t pos = 0;
+        for (size_t i = 0; i < Count; i++) {
+            for (size_t j = 0; i != 0 && j < M; j++) {
+                result.data[pos++] = separator.data[j];
+            }
+            for (size_t j = 0; j < N; j++) {
+                result.data[pos++] = item.data[j];
+            }
+        }
+        result.data[pos] = '\0';
+        return result;
+    }
+
+    template <typename T>
+    constexpr auto make_sql_table_name()
+    {
+        using Td = refl::type_descriptor<T>;
+
+        // Verify that the type has the Table attribute.
+        static_assert(refl::descriptor::has_attribute<Table>(Td{}));
+        static_assert(column_count<T> != 0, "The type has no fields with the Column attribute!");
+
+        constexpr auto tbl = refl::descriptor::get_attribute<Table>(Td{});
+        return REFL_MAKE_CONST_STRING(tbl.name);
+    }
+
+    // "(?, ?, ..., ?)" with one placeholder per column
+    template <typename T>
+    static constexpr auto row_placeholders = "(" + join_repeated<column_count<T>>(refl::make_const_string("?"), refl::make_const_string(", ")) + ")";
+
+    // The storage of one column of a batch; only the arrays of its data type are used.
+    struct column_buffer
+    {
+        std::vector<int64_t> integers;
+        std::vector<double> reals;
+        std::vector<char> text;
+        std::vector<uint64_t> offsets;
+    };
+
+    template <typename Member, typename T>
+    void fill_column(column_buffer& buffer, column_binding& binding, const T* rows, size_t count)
+    {
+        using value_type = std::remove_cv_t<typename Member::value_type>;
+        constexpr DataType data_type = column_of<Member>.data_type;
+        binding.name = column_of<Member>.name;
+        binding.data_type = data_type;
+        binding.offsets = nullptr;
+
+        if constexpr (data_type == DataType::ID || data_type == DataType::INTEGER) {
+            static_assert(std::is_integral_v<value_type> || std::is_enum_v<value_type>, "ID and INTEGER columns must be integers or enums!");
+            buffer.integers.resize(count);
+            int64_t* out = buffer.integers.data();
+            for (size_t i = 0; i < count; i++) {
+                out[i] = static_cast<int64_t>(Member{}(rows[i]));
+            }
+            binding.values = out;
+        }
+        else if constexpr (data_type == DataType::REAL) {
+            static_assert(std::is_arithmetic_v<value_type>, "REAL columns must be numbers!");
+            buffer.reals.resize(count);
+            double* out = buffer.reals.data();
+            for (size_t i = 0; i < count; i++) {
+                out[i] = static_cast<double>(Member{}(rows[i]));
+            }
+            binding.values = out;
+        }
+        else {
+            static_assert(std::is_convertible_v<const value_type&, std::string_view>, "TEXT columns must be convertible to std::string_view!");
+            // the offsets first, so that the characters are copied in one allocation
+            buffer.offsets.resize(count + 1);
+            uint64_t* offsets = buffer.offsets.data();
+            offsets[0] = 0;
+            for (size_t i = 0; i < count; i++) {
+                offsets[i + 1] = offsets[i] + std::string_view(Member{}(rows[i])).size();
+            }
+            buffer.text.resize(static_cast<size_t>(offsets[count]));
+            char* out = buffer.text.data();
+            for (size_t i = 0; i < count; i++) {
+                std::string_view value(Member{}(rows[i]));
+                if (!value.empty()) {
+                    std::memcpy(out + offsets[i], value.data(), value.size());
+                }
+            }
+            binding.values = out;
+            binding.offsets = offsets;
+        }
+    }
+}
+
+template <typename Member>
+constexpr auto make_sql_field_spec(Member)
+{
+    using namespace refl;
+
+    constexpr auto col = descriptor::get_attribute<Column>(Member{});
+
+    if constexpr (DataType::ID == col.data_type) {
+        return REFL_MAKE_CONST_STRING(col.name) + " int PRIMARY KEY";
+    }
+    else if constexpr (DataType::INTEGER == col.data_type) {
+        return REFL_MAKE_CONST_STRING(col.name) + " int";
+    }
+    else if constexpr (DataType::REAL == col.data_type) {
+        return REFL_MAKE_CONST_STRING(col.name) + " REAL";
+    }
+    else if constexpr (DataType::TEXT == col.data_type) {
+        return REFL_MAKE_CONST_STRING(col.name) + " TEXT";
+    }
+}
+
+/**
+ * Creates a CREATE TABLE SQL query.
+ * Returns the query as a refl::const_string<N>.
+ */
+template <typename T>
+constexpr auto make_sql_create_table()
+{
+    using namespace refl;
+
+    // Concatenate all the members' column definitions together
+    constexpr auto fields = accumulate(dao_detail::columns<T>,
+        [](auto acc, auto member) {
+            return acc + ",\n\t" + make_sql_field_spec(member);
+        }, make_const_string())
+        .template substr<2>(); // remove the initial ",\n"
+
+    // return the resulting compile-time string
+    return "CREATE TABLE " + dao_detail::make_sql_table_name<T>() + " (\n" + fields + "\n);";
+}
+
+/**
+ * Creates an INSERT SQL query with placeholders for Rows rows (without a trailing semicolon).
+ * Returns the query as a refl::const_string<N>.
+ */
+template <typename T, size_t Rows>
+constexpr auto make_sql_insert()
+{
+    using namespace refl;
+    static_assert(Rows != 0);
+
+    constexpr auto names = accumulate(dao_detail::columns<T>,
+        [](auto acc, auto member) {
+            return acc + ", " + dao_detail::make_sql_column_name(member);
+        }, make_const_string())
+        .template substr<2>(); // remove the initial ", "
+
+    return "INSERT INTO " + dao_detail::make_sql_table_name<T>() + " (" + names + ") VALUES "
+        + dao_detail::join_repeated<Rows>(dao_detail::row_placeholders<T>, make_const_string(", "));
+}
+
+/**
+ * Column-major parameter buffers for batches of T.
+ */
+template <typename T>
+class bind_buffers
+{
+public:
+    static constexpr size_t column_count = dao_detail::column_count<T>;
+
+    /** Replaces the contents of the buffers with the columns of count rows. */
+    void fill(const T* rows, size_t count)
+    {
+        refl::util::for_each(dao_detail::columns<T>, [&](auto member, size_t index) {
+            dao_detail::fill_column<decltype(member)>(buffers_[index], bindings_[index], rows, count);
+        });
+        size_ = count;
+    }
+
+    /** The number of rows in the buffers. */
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /** The bindings of the columns, in the order of the INSERT statement. */
+    const std::array<column_binding, column_count>& bindings() const noexcept
+    {
+        return bindings_;
+    }
+
+private:
+    size_t size_ = 0;
+    std::array<dao_detail::column_buffer, column_count> buffers_;
+    std::array<column_binding, column_count> bindings_{};
+};
+
+/**
+ * Creates the table of T and inserts ranges of T, BatchSize rows per statement.
+ *
+ * \code{.cpp}
+ * dao<User, 64> users;
+ * users.create_table(driver);
+ * users.insert(driver, all_users); // executes (all_users.size() + 63) / 64 statements
+ * \endcode
+ */
+template <typename T, size_t BatchSize = 64>
+class dao
+{
+public:
+    static_assert(BatchSize != 0);
+
+    static constexpr auto create_table_sql = make_sql_create_table<T>();
+    static constexpr auto insert_sql = make_sql_insert<T, BatchSize>();
+
+    /** The INSERT statement for rows rows (1 to BatchSize), a prefix of insert_sql. */
+    static constexpr std::string_view insert_sql_for(size_t rows) noexcept
+    {
+        constexpr size_t header_size = insert_sql.size - BatchSize * dao_detail::row_placeholders<T>.size - (BatchSize - 1) * 2;
+        return { insert_sql.data, header_size + rows * dao_detail::row_placeholders<T>.size + (rows - 1) * 2 };
+    }
+
+    template <typename Driver>
+    void create_table(Driver& driver)
+    {
+        driver.execute(std::string_view(create_table_sql.data, create_table_sql.size), nullptr, 0, 0);
+    }
+
+    /** Inserts count rows and returns the number of statements which were executed. */
+    template <typename Driver>
+    size_t insert(Driver& driver, const T* rows, size_t count)
+    {
+        size_t statements = 0;
+        for (size_t pos = 0; pos < count; pos += BatchSize) {
+            size_t batch = (std::min)(BatchSize, count - pos);
+            buffers_.fill(rows + pos, batch);
+            driver.execute(insert_sql_for(batch), buffers_.bindings().data(), buffers_.column_count, batch);
+            statements++;
+        }
+        return statements;
+    }
+
+    template <typename Driver>
+    size_t insert(Driver& driver, const std::vector<T>& rows)
+    {
+        return insert(driver, rows.data(), rows.size());
+    }
+
+private:
+    bind_buffers<T> buffers_;
+};
+
+#endif // REFL_EXAMPLES_DAO_HPP
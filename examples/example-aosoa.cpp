@@ -0,0 +1,76 @@
+/**
+ * ***README***
+ * This example shows the tiled container implemented in aosoa-vector.hpp. The particles
+ * of an aosoa_vector<Particle, 8> are stored in blocks of 8, with one array of 8 values per
+ * member in each block. A simulation step runs over the arrays of each block (a loop which
+ * compilers vectorize), while single particles are updated through proxies.
+ */
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include "aosoa-vector.hpp"
+
+struct Particle
+{
+    float x, y;
+    float vx, vy;
+    uint32_t id;
+};
+
+REFL_AUTO(type(Particle), field(x), field(y), field(vx), field(vy), field(id))
+
+using particles_t = aosoa_vector<Particle, 8>;
+using members = particles_t::members;
+using x_member = refl::trait::get_t<0, members>;
+using vx_member = refl::trait::get_t<2, members>;
+
+// moves every particle (the elements past the end of the last block have no velocity)
+void step(particles_t& particles, float dt)
+{
+    for (size_t b = 0; b < particles.block_count(); b++) {
+        auto& block = particles.block(b);
+        for (size_t i = 0; i < particles_t::block_size; i++) {
+            block[x_member{}][i] += block[vx_member{}][i] * dt;
+            block.get<1>()[i] += block.get<3>()[i] * dt;
+        }
+    }
+}
+
+int main()
+{
+    particles_t particles;
+    for (uint32_t i = 0; i < 20; i++) {
+        particles.push_back(Particle{ 0, 0, static_cast<float>(i), 1, i });
+    }
+    // 20 particles need 3 blocks, the last of which has 4 unused elements
+    assert(particles.size() == 20 && particles.block_count() == 3);
+    static_assert(sizeof(particles_t::block_type) % 64 == 0 && alignof(particles_t::block_type) == 64);
+    std::cout << "size=" << particles.size() << ", blocks=" << particles.block_count()
+        << ", block size=" << sizeof(particles_t::block_type) << " bytes\n";
+
+    step(particles, 0.5f);
+    assert(particles[9].x() == 4.5f && particles[9].y() == 0.5f);
+    assert(particles.block(1)[x_member{}][1] == 4.5f);
+
+    // the members of one particle are close together, so updating several of them is cheap
+    auto p = particles[13];
+    p.vx(-p.vx());
+    p.vy(0.0f);
+    step(particles, 0.5f);
+    Particle copy = particles.at(13);
+    assert(copy.x == 0 && copy.y == 0.5f && copy.id == 13);
+    std::cout << "particle 13: x=" << copy.x << ",y=" << copy.y << ",vx=" << copy.vx << "\n";
+
+    // removed elements are reset, so that the blocks can still be processed whole
+    particles.resize(17);
+    assert(particles.block_count() == 3 && particles.block(2)[vx_member{}][1] == 0);
+    particles.pop_back();
+    assert(particles.block_count() == 2 && particles.back().id() == 15);
+
+    // the iterators are random-access, so the standard algorithms work with them
+    std::reverse(particles.begin(), particles.end());
+    auto found = std::find_if(particles.begin(), particles.end(), [](auto particle) { return particle.id() == 3; });
+    assert(particles.front().id() == 15 && found - particles.begin() == 12);
+    std::cout << "reversed, first id=" << particles.front().id() << ", index of 3=" << found - particles.begin() << "\n";
+}
@@ -0,0 +1,137 @@
+/**
+ * ***README***
+ * This example shows the binary serializer implemented in binary-serialization.hpp.
+ * The serializer only needs the field descriptors of a type: the fields of Reading
+ * are grouped into memcpy runs at compile-time, and samples is written with a single
+ * bulk copy, which makes it as fast as a hand-written serializer.
+ * The data can then be read back with deserialize_binary, or inspected in place
+ * with a zero-copy binary_view.
+ */
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "binary-serialization.hpp"
+
+enum class Kind : uint8_t
+{
+    Sensor,
+    Actuator
+};
+
+struct Vec3
+{
+    float x, y, z;
+};
+
+REFL_AUTO(type(Vec3), field(x), field(y), field(z))
+
+struct Reading
+{
+    uint64_t timestamp;
+    uint32_t sensor_id;
+    float value;
+    Vec3 position;
+    Kind kind;
+    std::string label;
+    std::vector<float> samples;
+};
+
+REFL_AUTO(
+    type(Reading),
+    field(timestamp),
+    field(sensor_id),
+    field(value),
+    field(position),
+    field(kind),
+    field(label),
+    field(samples)
+)
+
+// Vec3 has no padding, so it can be copied as a whole
+static_assert(binary_detail::is_blittable<Vec3>());
+static_assert(!binary_detail::is_blittable<Reading>());
+
+// timestamp..kind form a single run of 29 bytes, label and samples are written separately
+static_assert(binary_detail::field_runs<Reading>::count == 3);
+static_assert(binary_detail::field_runs<Reading>::runs[0].count == 5);
+static_assert(binary_detail::field_runs<Reading>::runs[0].size == 29);
+
+int main()
+{
+    Reading reading{ 1600000000, 42, 21.5f, { 1, 2, 3 }, Kind::Actuator, "thermometer", { 0.5f, 1.5f, 2.5f } };
+
+    std::vector<unsigned char> buffer;
+    serialize_binary(reading, buffer);
+
+    size_t expected_size = 29 + sizeof(uint64_t) + reading.label.size() + sizeof(uint64_t) + reading.samples.size() * sizeof(float);
+    assert(buffer.size() == expected_size);
+    assert(serialized_binary_size(reading) == expected_size);
+
+    // the fields are written back-to-back in native byte order
+    uint32_t sensor_id;
+    std::memcpy(&sensor_id, buffer.data() + 8, sizeof(sensor_id));
+    assert(sensor_id == 42);
+
+    uint64_t label_size;
+    std::memcpy(&label_size, buffer.data() + 29, sizeof(label_size));
+    assert(label_size == reading.label.size());
+    assert(std::memcmp(buffer.data() + 29 + 8, "thermometer", label_size) == 0);
+
+    // serialize_binary appends, so multiple values can be written to the same buffer
+    std::vector<Reading> readings(3, reading);
+    serialize_binary(readings, buffer);
+    assert(buffer.size() == expected_size * 4 + sizeof(uint64_t));
+
+    std::cout << "Serialized 4 readings of " << expected_size << " bytes into " << buffer.size() << " bytes" << std::endl;
+
+    // deserialize_binary reads the value back into an existing object
+    Reading copy{};
+    size_t read = deserialize_binary(buffer.data(), buffer.size(), copy);
+    assert(read == expected_size);
+    assert(copy.timestamp == reading.timestamp && copy.position.z == 3 && copy.kind == Kind::Actuator);
+    assert(copy.label == reading.label && copy.samples == reading.samples);
+
+    // binary_view has a member function for each field of Reading, which decodes it in place
+    binary_view<Reading> view(buffer.data(), buffer.size());
+    std::string_view label = view.label();
+    binary_span<float> samples = view.samples();
+    assert(view.byte_size() == expected_size);
+    assert(view.sensor_id() == 42 && view.position().y == 2);
+    assert(label == "thermometer" && label.data() == reinterpret_cast<const char*>(buffer.data()) + 29 + 8);
+    assert(samples.size() == 3 && samples[2] == 2.5f);
+    std::cout << "Read " << read << " bytes back, viewing label \"" << label << "\" with " << samples.size() << " samples" << std::endl;
+
+    // vectors of non-trivial types can be iterated without decoding them
+    binary_sequence<Reading> others = view_binary<std::vector<Reading>>(buffer.data() + expected_size, buffer.size() - expected_size);
+    float sum = 0;
+    for (binary_view<Reading> element : others) {
+        for (float sample : element.samples()) {
+            sum += sample;
+        }
+    }
+    std::cout << "Sum of the samples of the other readings: " << sum << std::endl;
+
+    // truncated input is detected when the view is created
+    try {
+        binary_view<Reading> truncated(buffer.data(), expected_size - 1);
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+
+    // and so are bytes which are not valid values, e.g. bools other than 0 and 1
+    unsigned char flags[] = { 1, 2 };
+    std::array<bool, 2> values{};
+    try {
+        deserialize_binary(flags, sizeof(flags), values);
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ * ***README***
+ * This example shows the column kernels implemented in column-kernels.hpp. The members of
+ * the particles in a soa_vector are updated column by column, with element-wise lambdas and
+ * with vectorized kernels.
+ */
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include "column-kernels.hpp"
+
+struct Particle
+{
+    float x, y;
+    float vx, vy;
+    double energy;
+    uint32_t id;
+};
+
+REFL_AUTO(type(Particle), field(x), field(y), field(vx), field(vy), field(energy), field(id))
+
+using members = soa_vector<Particle>::members;
+using x_member = refl::trait::get_t<0, members>;
+using y_member = refl::trait::get_t<1, members>;
+using vx_member = refl::trait::get_t<2, members>;
+using vy_member = refl::trait::get_t<3, members>;
+using energy_member = refl::trait::get_t<4, members>;
+
+int main()
+{
+    soa_vector<Particle> particles;
+    for (uint32_t i = 0; i < 100; i++) {
+        particles.push_back(Particle{ 0, 0, static_cast<float>(i), -1, i * 0.5, i });
+    }
+
+    // a step: the lambda is called with the values of each particle
+    const float dt = 0.5f;
+    transform_columns(particles, refl::type_list<x_member, y_member, vx_member, vy_member>{}, [=](float& x, float& y, float vx, float vy) {
+        x += vx * dt;
+        y += vy * dt;
+    });
+    assert(particles[10].x() == 5 && particles[10].y() == -0.5f);
+
+    // the kernels work on whole columns
+    column_span<float> xs(particles.data(x_member{}), particles.size());
+    column_span<double> energies(particles.data(energy_member{}), particles.size());
+    column_kernels::add(xs, column_span<float>(particles.data(vx_member{}), particles.size()));
+    column_kernels::clamp(xs, 0.0f, 100.0f);
+    column_kernels::scale(energies, 2.0);
+    assert(particles[10].x() == 15 && particles[99].x() == 100 && particles[3].energy() == 3.0);
+    std::cout << "sum of x=" << column_kernels::sum(xs) << ", sum of energy=" << column_kernels::sum(energies) << "\n";
+
+    // every arithmetic column, whatever its type
+    for_each_column(static_cast<const soa_vector<Particle>&>(particles), [](auto member, auto column) {
+        std::cout << get_display_name(member) << ": sum=" << column_kernels::sum(column) << "\n";
+    });
+}
@@ -0,0 +1,112 @@
+/**
+ * ***README***
+ * This example shows the columnar conversion implemented in columnar.hpp. A vector of
+ * reflected objects is turned into one aligned buffer per member (with offsets for strings
+ * and a validity bitmap for optional members), which analytics code can scan directly,
+ * and converted back.
+ */
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+#include "columnar.hpp"
+
+enum class Side : uint8_t
+{
+    Buy,
+    Sell
+};
+
+class Trade
+{
+public:
+    uint64_t id = 0;
+    std::string symbol;
+    Side side = Side::Buy;
+    double price = 0;
+    std::optional<int32_t> quantity;
+    std::optional<std::string> note;
+
+    bool IsCancelled() const { return cancelled_; }
+    void SetCancelled(bool cancelled) { cancelled_ = cancelled; }
+
+private:
+    bool cancelled_ = false;
+};
+
+REFL_AUTO(
+    type(Trade),
+    field(id),
+    field(symbol),
+    field(side),
+    field(price),
+    field(quantity),
+    field(note),
+    func(IsCancelled, property("cancelled")),
+    func(SetCancelled, property("cancelled"))
+)
+
+int main()
+{
+    std::vector<Trade> trades;
+    for (uint64_t i = 0; i < 20; i++) {
+        Trade& trade = trades.emplace_back();
+        trade.id = 1000 + i;
+        trade.symbol = i % 3 ? "MSFT" : "AAPL";
+        trade.side = i % 2 ? Side::Sell : Side::Buy;
+        trade.price = 100 + static_cast<double>(i) / 4;
+        if (i % 4 != 0) trade.quantity = static_cast<int32_t>(i * 10);
+        if (i % 5 == 0) trade.note = "block " + std::to_string(i);
+        trade.SetCancelled(i == 7);
+    }
+
+    auto batch = to_columnar(trades);
+    static_assert(decltype(batch)::column_count == 7);
+    assert(batch.size() == trades.size());
+
+    // each column is a contiguous buffer, which can be scanned without touching the other members
+    const column<double>& prices = batch.get<3>();
+    assert(reinterpret_cast<uintptr_t>(prices.values()) % 64 == 0);
+    double total = 0;
+    for (size_t i = 0; i < prices.size(); i++) {
+        total += prices.values()[i];
+    }
+    std::cout << "Total price: " << total << std::endl;
+
+    const column<std::string>& symbols = batch.get<1>();
+    assert(symbols.offsets()[trades.size()] == 4 * 20);
+    assert(symbols[4] == "MSFT" && symbols[6] == "AAPL");
+    std::cout << "Symbols: " << symbols.offsets()[trades.size()] << " characters" << std::endl;
+
+    const column<std::optional<int32_t>>& quantities = batch.get<4>();
+    assert(quantities.null_count() == 5 && !quantities.is_valid(0) && quantities.is_valid(1));
+    assert(quantities.validity()[0] == 0xee && !quantities[8] && *quantities[9] == 90);
+    std::cout << "Quantities: " << quantities.null_count() << " null" << std::endl;
+
+    // bools are stored as a bitmap
+    const column<bool>& cancelled = batch.get<6>();
+    assert(cancelled.values()[0] == 0x80 && cancelled[7] && !cancelled[8]);
+    std::cout << "Cancelled: " << (cancelled[7] ? "trade 7" : "none") << std::endl;
+
+    const column<std::optional<std::string>>& notes = batch.get<5>();
+    assert(notes.null_count() == 16 && notes[5] == "block 5" && notes[6] == std::nullopt);
+    std::cout << "Notes: " << notes.null_count() << " null, " << notes.offsets()[trades.size()] << " characters" << std::endl;
+
+    // and back
+    std::vector<Trade> copy = from_columnar(batch);
+    assert(copy.size() == trades.size());
+    for (size_t i = 0; i < trades.size(); i++) {
+        assert(copy[i].id == trades[i].id && copy[i].symbol == trades[i].symbol && copy[i].side == trades[i].side);
+        assert(copy[i].price == trades[i].price && copy[i].quantity == trades[i].quantity && copy[i].note == trades[i].note);
+        assert(copy[i].IsCancelled() == trades[i].IsCancelled());
+    }
+
+    // any range of reflected values can be converted
+    std::list<Trade> list(trades.begin(), trades.begin() + 3);
+    auto small = to_columnar(list);
+    assert(small.size() == 3 && small.get<0>()[2] == 1002);
+    std::cout << "Converted " << copy.size() << " trades" << std::endl;
+}
@@ -0,0 +1,116 @@
+/**
+ * ***README***
+ * This example shows the CSV reader and writer implemented in csv.hpp. The columns are the
+ * display names of the members, so the header of a file can list them in any order, and
+ * large inputs are parsed on all cores, with the rows kept in their original order.
+ */
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "csv.hpp"
+
+enum class Side : uint8_t
+{
+    Buy,
+    Sell
+};
+
+class Order
+{
+public:
+    uint64_t id = 0;
+    std::string customer;
+    Side side = Side::Buy;
+    double price = 0;
+    std::optional<int32_t> quantity;
+
+    bool IsUrgent() const { return urgent_; }
+    void SetUrgent(bool urgent) { urgent_ = urgent; }
+
+private:
+    bool urgent_ = false;
+};
+
+REFL_AUTO(
+    type(Order),
+    field(id),
+    field(customer),
+    field(side),
+    field(price),
+    field(quantity),
+    func(IsUrgent, property("urgent")),
+    func(SetUrgent, property("urgent"))
+)
+
+int main()
+{
+    std::vector<Order> orders(3);
+    orders[0].id = 1;
+    orders[0].customer = "ACME, Inc.";
+    orders[0].price = 0.1;
+    orders[0].quantity = 250;
+    orders[1].id = 2;
+    orders[1].customer = "Joe's \"Bar\"\nDowntown";
+    orders[1].side = Side::Sell;
+    orders[1].price = 1e-7;
+    orders[1].SetUrgent(true);
+    orders[2].id = 3;
+
+    std::string text;
+    write_csv(orders, text);
+    std::cout << text;
+    assert(text.substr(0, text.find('\n')) == "id,customer,side,price,quantity,urgent");
+
+    std::vector<Order> copy = read_csv<Order>(text);
+    assert(copy.size() == 3);
+    assert(copy[0].customer == "ACME, Inc." && copy[0].price == 0.1 && copy[0].quantity == 250 && !copy[0].IsUrgent());
+    assert(copy[1].customer == orders[1].customer && copy[1].side == Side::Sell && copy[1].price == 1e-7 && !copy[1].quantity);
+    assert(copy[1].IsUrgent() && copy[2].id == 3 && copy[2].customer.empty());
+
+    // the columns are matched by name; unknown ones are ignored and missing ones keep their default
+    std::vector<Order> partial = read_csv<Order>("urgent,note,id\r\n1,first,10\r\n0,\"second, with a comma\",20\r\n");
+    assert(partial.size() == 2 && partial[0].id == 10 && partial[0].IsUrgent() && partial[1].id == 20 && partial[1].price == 0);
+
+    // large inputs are parsed on several threads
+    std::vector<Order> many;
+    for (uint64_t i = 0; i < 200000; i++) {
+        Order& order = many.emplace_back();
+        order.id = i;
+        order.customer = i % 10 == 0 ? "multi\nline " + std::to_string(i) : "customer " + std::to_string(i);
+        order.price = static_cast<double>(i) / 3;
+        if (i % 2 == 0) order.quantity = static_cast<int32_t>(i);
+    }
+    text.clear();
+    write_csv(many, text);
+    std::vector<Order> parsed = read_csv<Order>(text, 4);
+    assert(parsed.size() == many.size());
+    for (size_t i = 0; i < many.size(); i++) {
+        assert(parsed[i].id == i && parsed[i].customer == many[i].customer && parsed[i].price == many[i].price && parsed[i].quantity == many[i].quantity);
+    }
+    std::cout << "Read " << parsed.size() << " orders from " << text.size() << " bytes" << std::endl;
+
+    try {
+        read_csv<Order>("id,price\n1,2.5\n2,abc\n");
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+
+    // quotes are only allowed in quoted values, whatever the number of threads
+    size_t header_end = text.find('\n') + 1;
+    std::string stray = text.substr(0, header_end) + "1,5\" screen,0,0,,false\n" + text.substr(header_end);
+    for (unsigned threads : { 1u, 4u }) {
+        try {
+            read_csv<Order>(stray, threads);
+            assert(false);
+        }
+        catch (const std::runtime_error& e) {
+            assert(std::string(e.what()) == "CSV error at offset 42: unexpected quote in an unquoted value");
+            std::cout << "Error (" << threads << " threads): " << e.what() << std::endl;
+        }
+    }
+}
@@ -1,14 +1,142 @@
 /**
  * ***README***
  * This example showcases how a runtime reflection system can be implemented on
- * top of refl-cpp (here only the name of the type is being stored, but this can be extended).
+ * top of refl-cpp. We store the name of the type and a flat table describing
+ * its readable members (name, byte offset, size, alignment, type id and
+ * type-erased getter/setter functions). The byte offsets are only available
+ * for default-constructible types.
  *
  * We are storing the runtime information in TypeInfo. TypeInfo also has a factory method called
  * Get<T>, which creates an instance of TypeInfo by using metadata from refl-cpp.
+ * Generic code can then walk TypeInfo::Fields() without instantiating any templates per type.
  */
 #include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
 #include "refl.hpp"
 
+// a unique identifier for each type, which is available at compile-time
+using TypeId = const void*;
+
+template <typename T>
+struct TypeIdAnchor
+{
+    static constexpr char value{};
+};
+
+template <typename T>
+constexpr TypeId GetTypeId()
+{
+    return &TypeIdAnchor<refl::trait::remove_qualifiers_t<T>>::value;
+}
+
+// describes a single readable member of a type
+struct FieldInfo
+{
+    // offset used by readable members which are not fields (e.g. getter properties), and by the fields
+    // of types which are not default-constructible
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    const char* name;
+    size_t offset;
+    size_t size;
+    size_t align;
+    TypeId type;
+    // copies the value of the member of object into out (which must point to a value of the member's type)
+    void (*get)(const void* object, void* out);
+    // assigns the value pointed to by in to the member of object (nullptr if the member is read-only)
+    void (*set)(void* object, const void* in);
+};
+
+namespace detail
+{
+    template <typename Member>
+    using value_type = refl::trait::remove_qualifiers_t<decltype(Member{}(std::declval<const typename Member::declaring_type&>()))>;
+
+    // C++17 does not allow computing the offset of a member pointer in a constant expression,
+    // so we compute it against a real T (dereferencing the member pointer on storage which holds
+    // no T is undefined behavior, and gives wrong results for members of virtual bases).
+    // All the fields of T share this one object.
+    template <typename T>
+    const T& OffsetObject()
+    {
+        static const T object{};
+        return object;
+    }
+
+    template <typename T, typename Pointer>
+    size_t OffsetOf(Pointer pointer)
+    {
+        const T& object = OffsetObject<T>();
+        return static_cast<size_t>(reinterpret_cast<const unsigned char*>(std::addressof(object.*pointer))
+            - reinterpret_cast<const unsigned char*>(std::addressof(object)));
+    }
+
+    template <typename Member>
+    size_t GetOffset(Member member)
+    {
+        if constexpr (refl::descriptor::is_field(member)) {
+            using T = typename Member::declaring_type;
+            if constexpr (!refl::descriptor::is_static(member) && std::is_default_constructible_v<T>) {
+                return OffsetOf<T>(member.pointer);
+            }
+        }
+        return FieldInfo::npos;
+    }
+
+    template <typename Member>
+    FieldInfo MakeFieldInfo(Member member)
+    {
+        using T = typename Member::declaring_type;
+        using V = value_type<Member>;
+
+        FieldInfo info{
+            get_display_name(member),
+            GetOffset(member),
+            sizeof(V),
+            alignof(V),
+            GetTypeId<V>(),
+            [](const void* object, void* out) {
+                *static_cast<V*>(out) = Member{}(*static_cast<const T*>(object));
+            },
+            nullptr
+        };
+
+        // get_writer returns the member itself for fields and the matching setter for properties
+        if constexpr (refl::descriptor::is_writable(member)) {
+            info.set = [](void* object, const void* in) {
+                Member{}(*static_cast<T*>(object), *static_cast<const V*>(in));
+            };
+        }
+        else if constexpr (refl::descriptor::has_writer(member)) {
+            info.set = [](void* object, const void* in) {
+                constexpr auto writer = refl::descriptor::get_writer(Member{});
+                writer(*static_cast<T*>(object), *static_cast<const V*>(in));
+            };
+        }
+
+        return info;
+    }
+
+    template <typename T>
+    static constexpr auto readable_members = filter(refl::member_list<T>{}, [](auto member) { return is_readable(member); });
+
+    // one flat table per type, built once from the type_descriptor; building it default-constructs
+    // one T to compute the offsets (running its constructor), and the offsets are FieldInfo::npos
+    // when T is not default-constructible
+    template <typename T>
+    struct FieldTable
+    {
+        static const std::array<FieldInfo, readable_members<T>.size> fields;
+    };
+
+    template <typename T>
+    const std::array<FieldInfo, readable_members<T>.size> FieldTable<T>::fields =
+        refl::util::map_to_array<FieldInfo>(readable_members<T>, [](auto member) { return MakeFieldInfo(member); });
+}
+
 // create a class to hold runtime type information
 class TypeInfo
 {
@@ -28,17 +156,48 @@ public:
         return name_;
     }
 
+    TypeId Id() const
+    {
+        return id_;
+    }
+
+    // the readable members of the type, in declaration order
+    const FieldInfo* Fields() const
+    {
+        return fields_;
+    }
+
+    size_t FieldCount() const
+    {
+        return fieldCount_;
+    }
+
+    // finds a field by display name (returns nullptr if there is no such field)
+    const FieldInfo* FindField(const std::string& name) const
+    {
+        for (size_t i = 0; i < fieldCount_; i++) {
+            if (name == fields_[i].name) {
+                return &fields_[i];
+            }
+        }
+        return nullptr;
+    }
+
 private:
 
-    // were only storing the name for demonstration purposes,
-    // but this can be extended to hold other properties as well
     std::string name_;
+    TypeId id_;
+    const FieldInfo* fields_;
+    size_t fieldCount_;
 
     // given a type_descriptor, we construct a TypeInfo
-    // with all the metadata we care about (currently only name)
-    template <typename T, typename... Fields>
+    // with all the metadata we care about
+    template <typename T>
     TypeInfo(refl::type_descriptor<T> td)
         : name_(td.name)
+        , id_(GetTypeId<T>())
+        , fields_(detail::FieldTable<T>::fields.data())
+        , fieldCount_(detail::FieldTable<T>::fields.size())
     {
     }
 
@@ -94,17 +253,64 @@ public:
     MYLIB_REFLECTABLE()
 
     int health = 100;
+    float speed = 2.5f;
+    std::string nickname = "player";
+
+    int GetLevel() const { return level_; }
+    void SetLevel(int level) { level_ = level; }
 
     virtual ~FirstPersonController() noexcept
     {
     }
+
+private:
+    int level_ = 1;
 };
 
 REFL_AUTO(
     type(FirstPersonController),
-    field(health)
+    field(health),
+    field(speed),
+    field(nickname),
+    func(GetLevel, property()),
+    func(SetLevel, property())
 )
 
+// a generic, non-template routine which only uses the runtime tables
+void PrintFields(const void* object, const TypeInfo& ti)
+{
+    std::cout << ti.Name() << " {\n";
+    for (size_t i = 0; i < ti.FieldCount(); i++) {
+        const FieldInfo& field = ti.Fields()[i];
+        std::cout << "    " << field.name << " (size=" << field.size << ", align=" << field.align;
+        if (field.offset != FieldInfo::npos) {
+            std::cout << ", offset=" << field.offset;
+        }
+        std::cout << ") = ";
+
+        if (field.type == GetTypeId<int>()) {
+            int value;
+            field.get(object, &value);
+            std::cout << value;
+        }
+        else if (field.type == GetTypeId<float>()) {
+            float value;
+            field.get(object, &value);
+            std::cout << value;
+        }
+        else if (field.type == GetTypeId<std::string>()) {
+            std::string value;
+            field.get(object, &value);
+            std::cout << '"' << value << '"';
+        }
+        else {
+            std::cout << "(unknown)";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "}\n";
+}
+
 int main()
 {
     FirstPersonController fpc;
@@ -113,4 +319,16 @@ int main()
 
     // access the name through our TypeInfo object
     assert(pawnTypeInfo.Name() == "FirstPersonController");
-}
\ No newline at end of file
+    assert(pawnTypeInfo.Id() == GetTypeId<FirstPersonController>());
+    assert(pawnTypeInfo.FieldCount() == 4);
+
+    // set the values of members by name, without knowing the static type
+    int health = 42;
+    pawnTypeInfo.FindField("health")->set(&fpc, &health);
+    int level = 7;
+    pawnTypeInfo.FindField("Level")->set(&fpc, &level);
+    assert(fpc.health == 42);
+    assert(fpc.GetLevel() == 7);
+
+    PrintFields(&fpc, pawnTypeInfo);
+}
@@ -1,104 +1,77 @@
-
 /**
  * ***README***
  * This example shows how attributes can be used to build powerful
  * abstractions. Here we utilize two user-defined attributes to
  * generate SQL queries which insert elements into a database.
- * The SQL queries are generated all at compile-time using const_strings.
+ * The SQL queries are generated all at compile-time using const_strings
+ * (see dao.hpp), and the rows are inserted in batches, with their
+ * parameters bound column by column, into an in-process fake database.
  */
+#include <cassert>
 #include <cstdint>
-#include <sstream>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
-#include "refl.hpp"
-
-/** An attribute for specifying a DB table's properties */
-struct Table : refl::attr::usage::type
-{
-    const char* name;
-
-    constexpr Table(const char* name) noexcept
-        : name(name)
-    {
-    }
-};
-
-enum class DataType
-{
-    ID,
-    TEXT,
-};
-
-/** An attribute for specifying a DB column's properties */
-struct Column : refl::attr::usage::field
-{
-    const char* name;
-    const DataType data_type;
-
-    constexpr Column(const char* name, DataType dataType) noexcept
-        : name(name), data_type(dataType)
-    { }
-};
+#include "dao.hpp"
 
 /** User will serve as the "model" for the "Users table" */
 struct User
 {
     std::uint32_t id;
     std::string email;
+    double rating;
 };
 
 /** Define the reflection metadata for the model */
 REFL_AUTO(
     type(User, Table{"Users"}),
     field(id, Column{"ID", DataType::ID}),
-    field(email, Column{"Email", DataType::TEXT})
+    field(email, Column{"Email", DataType::TEXT}),
+    field(rating, Column{"Rating", DataType::REAL})
 );
 
-template <typename Member>
-constexpr auto make_sql_field_spec(Member)
-{
-    using namespace refl;
-
-    constexpr auto col = descriptor::get_attribute<Column>(Member{});
-
-    if constexpr (DataType::ID == col.data_type) {
-        // convert the const char* data member to a refl::const_string<N>
-        // (necessary to be able to do compile-time string concat)
-        return REFL_MAKE_CONST_STRING(col.name) + " int PRIMARY KEY";
-    }
-    else if constexpr (DataType::TEXT == col.data_type) {
-        return REFL_MAKE_CONST_STRING(col.name) + " TEXT";
-    }
-}
-
 /**
- * Creates a CREATE TABLE SQL query.
- * Returns the query as a refl::const_string<N>.
+ * A fake driver, which checks the statements it is given and keeps the inserted rows
+ * in memory, as text.
  */
-template <typename T>
-constexpr auto make_sql_create_table()
+class FakeDriver
 {
-    using namespace refl;
-    using Td = type_descriptor<T>;
+public:
+    std::vector<std::string> statements;
+    std::vector<std::vector<std::string>> rows;
 
-    // Verify that the type has the Table attribute.
-    static_assert(descriptor::has_attribute<Table>(Td{}));
-
-    // Concatenate all the members' column definitions together
-    constexpr auto fields = accumulate(Td::members,
-        [](auto acc, auto member) {
-            return acc + ",\n\t" + make_sql_field_spec(member);
-        }, make_const_string())
-        .template substr<2>(); // remove the initial ",\n"
-
-    constexpr auto tbl = descriptor::get_attribute<Table>(Td{});
-    // convert the const char* data member to a refl::const_string<N>
-    // (necessary to be able to do compile-time string concat)
-    constexpr auto tbl_name = REFL_MAKE_CONST_STRING(tbl.name);
-
-    // return the resulting compile-time string
-    return "CREATE TABLE " + tbl_name + " (\n" + fields + "\n);";
-}
+    void execute(std::string_view sql, const column_binding* columns, size_t column_count, size_t count)
+    {
+        statements.emplace_back(sql);
+        // every parameter must have a placeholder
+        size_t placeholders = 0;
+        for (char c : sql) {
+            placeholders += c == '?';
+        }
+        assert(placeholders == column_count * count);
+
+        for (size_t i = 0; i < count; i++) {
+            std::vector<std::string>& row = rows.emplace_back();
+            for (size_t j = 0; j < column_count; j++) {
+                const column_binding& column = columns[j];
+                switch (column.data_type) {
+                case DataType::ID:
+                case DataType::INTEGER:
+                    row.push_back(std::to_string(static_cast<const int64_t*>(column.values)[i]));
+                    break;
+                case DataType::REAL:
+                    row.push_back(std::to_string(static_cast<const double*>(column.values)[i]));
+                    break;
+                case DataType::TEXT:
+                    row.emplace_back(static_cast<const char*>(column.values) + column.offsets[i], column.offsets[i + 1] - column.offsets[i]);
+                    break;
+                }
+            }
+        }
+    }
+};
 
 int main()
 {
@@ -107,4 +80,28 @@ int main()
     constexpr auto sql = make_sql_create_table<User>();
     std::cout << sql << "\n";
     std::cout << "Number of characters: " << sizeof(sql) - 1 << "\n";
+
+    constexpr auto insert = make_sql_insert<User, 2>();
+    static_assert(insert == "INSERT INTO Users (ID, Email, Rating) VALUES (?, ?, ?), (?, ?, ?)");
+    std::cout << insert << "\n";
+
+    std::vector<User> users;
+    for (uint32_t i = 0; i < 10; i++) {
+        users.push_back(User{ i, "user" + std::to_string(i) + "@example.com", i * 0.5 });
+    }
+
+    // 10 rows are inserted with 3 statements, of 4, 4 and 2 rows
+    FakeDriver driver;
+    dao<User, 4> user_dao;
+    user_dao.create_table(driver);
+    size_t statements = user_dao.insert(driver, users);
+    assert(statements == 3 && driver.statements.size() == 4);
+    assert(driver.statements[3] == insert.c_str());
+    assert(driver.rows.size() == users.size());
+    for (size_t i = 0; i < users.size(); i++) {
+        assert(driver.rows[i][0] == std::to_string(users[i].id));
+        assert(driver.rows[i][1] == users[i].email);
+        assert(driver.rows[i][2] == std::to_string(users[i].rating));
+    }
+    std::cout << "Inserted " << driver.rows.size() << " rows with " << statements << " statements\n";
 }
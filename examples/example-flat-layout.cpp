@@ -0,0 +1,171 @@
+/**
+ * ***README***
+ * This example shows the flat layout implemented in flat-layout.hpp. The data is written
+ * to a file once, and then memory-mapped and read in place through flat_view, a proxy
+ * of the reflected type which loads each field from its offset on demand. Nothing is parsed
+ * or copied when the file is opened, however large it is.
+ */
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "flat-layout.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EXAMPLE_HAS_MMAP 1
+#endif
+
+struct Position
+{
+    double latitude;
+    double longitude;
+};
+
+REFL_AUTO(type(Position), field(latitude), field(longitude))
+
+enum class Kind : uint8_t
+{
+    Weather,
+    Seismic
+};
+
+struct Station
+{
+    uint32_t id;
+    Kind kind;
+    std::string name;
+    Position position;
+    std::vector<float> readings;
+};
+
+REFL_AUTO(type(Station), field(id), field(kind), field(name), field(position), field(readings))
+
+struct Catalog
+{
+    uint16_t version;
+    std::vector<Station> stations;
+    std::vector<std::string> tags;
+};
+
+REFL_AUTO(type(Catalog), field(version), field(stations), field(tags))
+
+// The table of Station: name, position and readings (32 bytes), id (4) and kind (1), padded to a multiple of 8.
+static_assert(flat_detail::layout<Station>::size == 40);
+static_assert(flat_detail::layout<Station>::offset<1> == 36);
+
+// A read-only mapping of a whole file (or a copy of it, where mmap is not available).
+class MappedFile
+{
+public:
+    explicit MappedFile(const char* path)
+    {
+#ifdef EXAMPLE_HAS_MMAP
+        int fd = open(path, O_RDONLY);
+        struct stat info;
+        if (fd == -1 || fstat(fd, &info) != 0) {
+            throw std::runtime_error("Cannot open file!");
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data_ == MAP_FAILED) {
+            throw std::runtime_error("Cannot map file!");
+        }
+#else
+        std::ifstream in(path, std::ios::binary);
+        copy_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = copy_.data();
+        size_ = copy_.size();
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+#ifdef EXAMPLE_HAS_MMAP
+        munmap(data_, size_);
+#endif
+    }
+
+    const void* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    void* data_;
+    size_t size_;
+#ifndef EXAMPLE_HAS_MMAP
+    std::vector<char> copy_;
+#endif
+};
+
+int main()
+{
+    Catalog catalog{ 3, {}, { "public", "hourly" } };
+    for (uint32_t i = 0; i < 1000; i++) {
+        Station station{ i, i % 2 == 0 ? Kind::Weather : Kind::Seismic, "station-" + std::to_string(i),
+            { 42.0 + i * 0.001, 23.0 - i * 0.001 }, {} };
+        for (uint32_t j = 0; j < i % 5; j++) {
+            station.readings.push_back(static_cast<float>(i + j) / 4);
+        }
+        catalog.stations.push_back(std::move(station));
+    }
+
+    std::vector<unsigned char> buffer;
+    serialize_flat(catalog, buffer);
+    const char* path = "example-flat-layout.bin";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    std::cout << "Catalog: " << buffer.size() << " bytes" << std::endl;
+
+    {
+        MappedFile file(path);
+        // checks the whole file; trusted data can be used right away
+        verify_flat<Catalog>(file.data(), file.size());
+        flat_view<Catalog> view = view_flat<Catalog>(file.data(), file.size());
+
+        assert(view.version() == 3 && view.stations().size() == 1000);
+        assert(view.tags().size() == 2 && view.tags()[1] == "hourly");
+
+        // random access to any station, without reading the ones before it
+        flat_view<Station> station = view.stations()[777];
+        assert(station.id() == 777 && station.kind() == Kind::Seismic && station.name() == "station-777");
+        assert(station.position().latitude() == 42.0 + 777 * 0.001);
+        assert(station.readings().size() == 2 && station.readings()[1] == 778.0f / 4);
+        std::cout << station.name() << " at " << station.position().latitude() << ", " << station.position().longitude() << std::endl;
+
+        double total = 0;
+        for (auto s : view.stations()) {
+            for (float reading : s.readings()) {
+                total += reading;
+            }
+        }
+        std::cout << "Sum of all readings: " << total << std::endl;
+    }
+
+    // the data of another type, or truncated data, is rejected
+    try {
+        view_flat<Station>(buffer.data(), buffer.size());
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+    try {
+        buffer.resize(buffer.size() / 2);
+        verify_flat<Catalog>(buffer.data(), buffer.size());
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+
+    std::remove(path);
+}
@@ -0,0 +1,117 @@
+/**
+ * ***README***
+ * This example shows the JSON writer implemented in json.hpp.
+ * The keys of each object, along with the braces and commas around them, are
+ * rendered at compile-time from the display names of the readable members,
+ * so a property can be renamed in the output with property("friendly_name").
+ *
+ * read_json parses the same format back without building a DOM: keys are looked up
+ * in a perfect hash table of the display names, and values are parsed straight into
+ * the fields (or passed to the setter of a property).
+ */
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+enum class Role
+{
+    Guest,
+    Member,
+    Admin
+};
+
+struct Address
+{
+    std::string city;
+    std::string street;
+};
+
+REFL_AUTO(type(Address), field(city), field(street))
+
+class User
+{
+public:
+    User(std::string name, std::string email, unsigned age)
+        : name(std::move(name)), email(std::move(email)), age_(age)
+    {
+    }
+
+    std::string name;
+    std::string email;
+    Role role = Role::Member;
+    double balance = 0;
+    std::optional<Address> address;
+    std::vector<std::string> tags;
+    std::map<std::string, int> counters;
+
+    unsigned GetAge() const { return age_; }
+    void SetAge(unsigned age) { age_ = age; }
+    bool IsAdult() const { return age_ >= 18; }
+
+private:
+    unsigned age_;
+};
+
+REFL_AUTO(
+    type(User),
+    field(name),
+    field(email),
+    field(role),
+    field(balance),
+    field(address),
+    field(tags),
+    field(counters),
+    func(GetAge, property("age")),
+    func(SetAge, property("age")),
+    func(IsAdult, property("adult"))
+)
+
+// The fragments are plain const_strings
+static_assert(json_detail::key_fragment<refl::trait::get_t<0, refl::member_list<User>>, true> == "{\"name\":");
+static_assert(json_detail::key_fragment<refl::trait::get_t<1, refl::member_list<User>>, false> == ",\"email\":");
+
+int main()
+{
+    User user("Jane \"JD\" Doe", "jane@example.com", 34);
+    user.balance = 12.75;
+    user.address = Address{ "Sofia", "Vitosha 1" };
+    user.tags = { "beta", "vip" };
+    user.counters = { { "logins", 42 }, { "posts", 7 } };
+
+    std::string json = to_json(user);
+    std::cout << json << std::endl;
+    assert(json == R"({"name":"Jane \"JD\" Doe","email":"jane@example.com","role":1,"balance":12.75,)"
+                   R"("address":{"city":"Sofia","street":"Vitosha 1"},"tags":["beta","vip"],)"
+                   R"("counters":{"logins":42,"posts":7},"age":34,"adult":true})");
+
+    // write_json appends to an existing buffer, which can be reused between messages
+    std::string buffer;
+    std::vector<User> users(2, User("John", "john@example.com", 17));
+    write_json(users, buffer);
+    std::cout << buffer << std::endl;
+    assert(buffer.find("\"address\":null") != std::string::npos);
+
+    // read_json only touches the members present in the input and skips unknown keys
+    User parsed("", "", 0);
+    read_json(json, parsed);
+    assert(to_json(parsed) == json);
+
+    read_json(R"({ "email": "jane@doe.org", "unknown": { "nested": [1, "]}", {}] }, "age": 35, "tags": [] })", parsed);
+    assert(parsed.name == user.name && parsed.email == "jane@doe.org" && parsed.GetAge() == 35 && parsed.tags.empty());
+    std::cout << to_json(parsed) << std::endl;
+
+    // escape sequences are decoded, including surrogate pairs
+    read_json(R"({"name": "J\u00e9r\u00f4me \ud83d\ude00\n"})", parsed);
+    assert(parsed.name == "J\xc3\xa9r\xc3\xb4me \xf0\x9f\x98\x80\n");
+
+    try {
+        read_json(R"({"name": "unterminated)", parsed);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << e.what() << std::endl;
+    }
+}
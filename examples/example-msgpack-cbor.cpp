@@ -0,0 +1,140 @@
+/**
+ * ***README***
+ * This example shows the MessagePack and CBOR codecs implemented in msgpack-cbor.hpp.
+ * The keys of each map are encoded at compile-time from the display names of the
+ * readable members, integers take as few bytes as their value needs, and object_mode::array
+ * drops the keys altogether, for peers which agree on the order of the members.
+ */
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "msgpack-cbor.hpp"
+
+struct Header
+{
+    bool compact;
+    int schema;
+};
+
+REFL_AUTO(type(Header), field(compact), field(schema))
+
+enum class Status : uint8_t
+{
+    Pending,
+    Shipped
+};
+
+class Shipment
+{
+public:
+    uint64_t id = 0;
+    std::string destination;
+    Status status = Status::Pending;
+    double weight = 0;
+    std::vector<int32_t> deltas;
+    std::optional<std::string> note;
+    std::map<std::string, uint16_t> counts;
+
+    int GetPriority() const { return priority_; }
+    void SetPriority(int priority) { priority_ = priority; }
+
+private:
+    int priority_ = 0;
+};
+
+REFL_AUTO(
+    type(Shipment),
+    field(id),
+    field(destination),
+    field(status),
+    field(weight),
+    field(deltas),
+    field(note),
+    field(counts),
+    func(GetPriority, property("priority")),
+    func(SetPriority, property("priority"))
+)
+
+void PrintHex(const char* label, const std::vector<unsigned char>& bytes)
+{
+    static constexpr char hex[] = "0123456789abcdef";
+    std::cout << label << " (" << bytes.size() << " bytes):";
+    for (unsigned char byte : bytes) {
+        std::cout << ' ' << hex[byte >> 4] << hex[byte & 0xf];
+    }
+    std::cout << std::endl;
+}
+
+int main()
+{
+    // the example from msgpack.org: {"compact":true,"schema":0} in 18 bytes
+    std::vector<unsigned char> buffer;
+    write_msgpack(Header{ true, 0 }, buffer);
+    assert((buffer == std::vector<unsigned char>{ 0x82, 0xa7, 'c', 'o', 'm', 'p', 'a', 'c', 't', 0xc3, 0xa6, 's', 'c', 'h', 'e', 'm', 'a', 0x00 }));
+    PrintHex("MessagePack", buffer);
+
+    // the names are constant byte strings, which include the header of the string
+    static_assert(msgpack_cbor_detail::encoded_name<msgpack_cbor_detail::msgpack, refl::trait::get_t<0, refl::member_list<Header>>>.size() == 8);
+
+    buffer.clear();
+    write_cbor(Header{ true, 0 }, buffer);
+    assert((buffer == std::vector<unsigned char>{ 0xa2, 0x67, 'c', 'o', 'm', 'p', 'a', 'c', 't', 0xf5, 0x66, 's', 'c', 'h', 'e', 'm', 'a', 0x00 }));
+    PrintHex("CBOR", buffer);
+
+    // integers use the smallest encoding which fits (examples from RFC 8949)
+    buffer.clear();
+    write_cbor(int64_t(1000000), buffer);
+    write_cbor(-1000, buffer);
+    assert((buffer == std::vector<unsigned char>{ 0x1a, 0x00, 0x0f, 0x42, 0x40, 0x39, 0x03, 0xe7 }));
+
+    Shipment shipment;
+    shipment.id = 70000;
+    shipment.destination = "Rotterdam";
+    shipment.status = Status::Shipped;
+    shipment.weight = 1250.5;
+    shipment.deltas = { -1, 100, -40000 };
+    shipment.counts = { { "boxes", 12 }, { "pallets", 300 } };
+    shipment.SetPriority(-3);
+
+    std::vector<unsigned char> as_map;
+    std::vector<unsigned char> as_array;
+    write_msgpack(shipment, as_map);
+    write_msgpack<object_mode::array>(shipment, as_array);
+    std::cout << "Shipment as a MessagePack map: " << as_map.size() << " bytes, as an array: " << as_array.size() << " bytes" << std::endl;
+    PrintHex("Shipment as an array", as_array);
+
+    // the decoders accept both representations
+    for (const auto* encoded : { &as_map, &as_array }) {
+        Shipment copy;
+        size_t read = read_msgpack(encoded->data(), encoded->size(), copy);
+        assert(read == encoded->size());
+        assert(copy.id == shipment.id && copy.destination == shipment.destination && copy.status == Status::Shipped);
+        assert(copy.weight == shipment.weight && copy.deltas == shipment.deltas && !copy.note && copy.counts == shipment.counts);
+        assert(copy.GetPriority() == -3);
+        (void)read;
+    }
+
+    // the same for CBOR
+    shipment.note = "fragile";
+    buffer.clear();
+    write_cbor(shipment, buffer);
+    Shipment copy;
+    read_cbor(buffer.data(), buffer.size(), copy);
+    assert(copy.note == shipment.note && copy.deltas == shipment.deltas && copy.GetPriority() == -3);
+    std::cout << "Shipment as a CBOR map: " << buffer.size() << " bytes" << std::endl;
+
+    // values which do not fit into the target type are rejected
+    buffer.clear();
+    write_cbor(std::map<std::string, std::map<std::string, int>>{ { "counts", { { "boxes", 70000 } } } }, buffer);
+    try {
+        read_cbor(buffer.data(), buffer.size(), copy);
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
@@ -0,0 +1,150 @@
+/**
+ * ***README***
+ * This example shows the Protocol Buffers encoder and decoder implemented in protobuf.hpp.
+ * The field numbers come from the tag attribute and the scalar encodings (sint32, fixed64, ...)
+ * from the protobuf::zigzag and protobuf::fixed attributes, so the structs below are wire-compatible
+ * with the messages of the following .proto file, and no generated classes are needed:
+ *
+ *   message Test1 { int32 a = 1; }
+ *   message Test2 { string b = 2; }
+ *   message Test3 { Test1 c = 3; }
+ *   message Test4 { repeated int32 d = 4; }
+ *   message Sample {
+ *     uint64 id = 1;
+ *     sint32 delta = 2;
+ *     fixed64 checksum = 3;
+ *     double value = 4;
+ *     Status status = 5;
+ *     repeated sint64 offsets = 6;
+ *     repeated string labels = 7;
+ *     map<string, int32> counters = 8;
+ *     optional Test1 parent = 9;
+ *   }
+ */
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "protobuf.hpp"
+
+struct Test1
+{
+    int32_t a;
+};
+
+struct Test2
+{
+    std::string b;
+};
+
+struct Test3
+{
+    Test1 c;
+};
+
+struct Test4
+{
+    std::vector<int32_t> d;
+};
+
+REFL_AUTO(type(Test1), field(a, tag(1)))
+REFL_AUTO(type(Test2), field(b, tag(2)))
+REFL_AUTO(type(Test3), field(c, tag(3)))
+REFL_AUTO(type(Test4), field(d, tag(4)))
+
+enum class Status
+{
+    Unknown,
+    Ok,
+    Failed
+};
+
+struct Sample
+{
+    uint64_t id = 0;
+    int32_t delta = 0;
+    uint64_t checksum = 0;
+    double value = 0;
+    Status status = Status::Unknown;
+    std::vector<int64_t> offsets;
+    std::vector<std::string> labels;
+    std::map<std::string, int32_t> counters;
+    std::optional<Test1> parent;
+};
+
+REFL_AUTO(
+    type(Sample),
+    field(id, tag(1)),
+    field(delta, tag(2), protobuf::zigzag()),
+    field(checksum, tag(3), protobuf::fixed()),
+    field(value, tag(4)),
+    field(status, tag(5)),
+    field(offsets, tag(6), protobuf::zigzag()),
+    field(labels, tag(7)),
+    field(counters, tag(8)),
+    field(parent, tag(9))
+)
+
+using Bytes = std::vector<unsigned char>;
+
+template <typename T>
+Bytes Encode(const T& value)
+{
+    Bytes out;
+    encode_protobuf(value, out);
+    return out;
+}
+
+int main()
+{
+    // the examples from the encoding guide of Protocol Buffers
+    assert((Encode(Test1{ 150 }) == Bytes{ 0x08, 0x96, 0x01 }));
+    assert((Encode(Test2{ "testing" }) == Bytes{ 0x12, 0x07, 't', 'e', 's', 't', 'i', 'n', 'g' }));
+    assert((Encode(Test3{ { 150 } }) == Bytes{ 0x1a, 0x03, 0x08, 0x96, 0x01 }));
+    assert((Encode(Test4{ { 3, 270, 86942 } }) == Bytes{ 0x22, 0x06, 0x03, 0x8e, 0x02, 0x9e, 0xa7, 0x05 }));
+
+    // negative int32 values take 10 bytes, unless the field is a sint32
+    assert(Encode(Test1{ -1 }).size() == 11);
+
+    // default values are not written
+    assert(Encode(Test1{ 0 }).empty());
+
+    Sample sample;
+    sample.id = 1234567;
+    sample.delta = -2;
+    sample.checksum = 0xdeadbeef;
+    sample.value = 0.5;
+    sample.status = Status::Ok;
+    sample.offsets = { 0, -1, 1, -64, 63, 100000, -100000, 7, 8, 9 };
+    sample.labels = { "eu-west", "primary" };
+    sample.counters = { { "retries", 3 }, { "errors", 0 } };
+    sample.parent = Test1{ 150 };
+
+    Bytes encoded = Encode(sample);
+    std::cout << "Sample: " << encoded.size() << " bytes" << std::endl;
+
+    Sample copy;
+    copy.labels = { "stale" };
+    decode_protobuf(encoded.data(), encoded.size(), copy);
+    assert(copy.id == sample.id && copy.delta == -2 && copy.checksum == sample.checksum && copy.value == 0.5);
+    assert(copy.status == Status::Ok && copy.offsets == sample.offsets && copy.labels == sample.labels);
+    assert(copy.counters == sample.counters && copy.parent && copy.parent->a == 150);
+
+    // parsers must accept unpacked repeated fields and skip unknown fields
+    Bytes unpacked{ 0x20, 0x03, 0x28, 0x01, 0x20, 0x8e, 0x02, 0x22, 0x01, 0x05 };
+    Test4 test4;
+    decode_protobuf(unpacked.data(), unpacked.size(), test4);
+    assert((test4.d == std::vector<int32_t>{ 3, 270, 5 }));
+    std::cout << "Test4: " << test4.d.size() << " elements" << std::endl;
+
+    try {
+        decode_protobuf(encoded.data(), encoded.size() - 1, copy);
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * ***README***
+ * This example shows the resumable decoder implemented in push-parser.hpp. Messages written
+ * by serialize_binary are fed to binary_push_parser in fragments of arbitrary sizes, as a
+ * non-blocking socket would deliver them, and are decoded without being reassembled first.
+ */
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "push-parser.hpp"
+
+struct Point
+{
+    int32_t x;
+    int32_t y;
+};
+
+REFL_AUTO(type(Point), field(x), field(y))
+
+struct Shape
+{
+    std::string name;
+    std::vector<Point> points;
+};
+
+REFL_AUTO(type(Shape), field(name), field(points))
+
+struct Request
+{
+    uint64_t id;
+    std::string path;
+    std::vector<Shape> shapes;
+    std::array<std::string, 2> tags;
+    double timeout;
+};
+
+REFL_AUTO(type(Request), field(id), field(path), field(shapes), field(tags), field(timeout))
+
+bool operator==(const Point& a, const Point& b) { return a.x == b.x && a.y == b.y; }
+bool operator==(const Shape& a, const Shape& b) { return a.name == b.name && a.points == b.points; }
+bool operator==(const Request& a, const Request& b)
+{
+    return a.id == b.id && a.path == b.path && a.shapes == b.shapes && a.tags == b.tags && a.timeout == b.timeout;
+}
+
+int main()
+{
+    std::vector<Request> sent;
+    for (uint64_t i = 0; i < 20; i++) {
+        Request request{ i, "/api/v1/shapes/" + std::to_string(i), {}, { "tag", std::string(i, 'x') }, 0.5 * i };
+        for (int32_t j = 0; j < static_cast<int32_t>(i % 4); j++) {
+            request.shapes.push_back(Shape{ "shape" + std::to_string(j), std::vector<Point>(j * 3, Point{ j, -j }) });
+        }
+        sent.push_back(request);
+    }
+
+    // the messages are sent back-to-back over a stream
+    std::vector<unsigned char> stream;
+    for (const auto& request : sent) {
+        serialize_binary(request, stream);
+    }
+    std::cout << "Stream: " << stream.size() << " bytes, " << sent.size() << " messages" << std::endl;
+
+    // and they arrive in fragments of 1 to 13 bytes, which do not respect message boundaries
+    std::vector<Request> received;
+    Request request;
+    binary_push_parser<Request> parser(request);
+    size_t fragments = 0;
+    for (size_t pos = 0, size = 1; pos < stream.size(); pos += size, size = size % 13 + 1) {
+        const unsigned char* fragment = stream.data() + pos;
+        size_t length = std::min(size, stream.size() - pos);
+        fragments++;
+        // a fragment can complete a message and start the next one
+        while (length != 0) {
+            size_t used = parser.feed(fragment, length);
+            fragment += used;
+            length -= used;
+            if (parser.done()) {
+                received.push_back(request);
+                parser.reset();
+            }
+        }
+    }
+
+    assert(received.size() == sent.size());
+    assert(std::equal(sent.begin(), sent.end(), received.begin()));
+    std::cout << "Decoded " << received.size() << " messages from " << fragments << " fragments" << std::endl;
+
+    // a size prefix claims a string of 2^40 bytes, but nothing is allocated before the bytes arrive
+    std::vector<unsigned char> bogus(8 + 8 + 5);
+    uint64_t huge = uint64_t(1) << 40;
+    std::memcpy(bogus.data() + 8, &huge, sizeof(huge));
+    parser.reset();
+    parser.feed(bogus.data(), bogus.size());
+    assert(!parser.done() && request.path.size() == 5);
+    std::cout << "Partial path: " << request.path.size() << " bytes" << std::endl;
+}
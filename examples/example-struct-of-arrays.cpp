@@ -1,123 +1,13 @@
-#include "refl.hpp"
-#include <iostream>
-#include <vector>
-
-/********************************/
-template <typename T>
-constexpr auto readable_members = filter(refl::member_list<T>{}, [](auto member) { return is_readable(member); });
-
-template <typename T>
-using readable_member_list = std::remove_const_t<decltype(readable_members<T>)>;
-
 /**
- * The type the readable member returns when invoked.
+ * ***README***
+ * This example shows the structure-of-arrays container implemented in soa-vector.hpp.
+ * The elements of a soa_vector<color> are stored as three arrays (one per property of
+ * color), and are accessed through proxies which have the same interface as color.
  */
-template <typename ReadableMember>
-using underlying_type = refl::trait::remove_qualifiers_t<decltype(ReadableMember()(std::declval<const typename ReadableMember::declaring_type&>()))>;
-
-template <typename T>
-struct struct_of_arrays : refl::runtime::proxy<struct_of_arrays<T>, std::remove_cv_t<T>> {
-public:
-
-    using readable_members = readable_member_list<std::remove_cv_t<T>>;
-    static_assert(readable_members::size > 0, "Type has no fields!");
-
-    struct_of_arrays(size_t capacity = 4)
-    {
-    }
-
-    void push_back(const T& value)
-    {
-        for_each(readable_members {}, [&](auto member, size_t index) {
-            constexpr auto i = refl::trait::index_of_v<decltype(member), readable_members>;
-            std::get<i>(storage_).push_back(member(value));
-        });
-    }
-
-    void pop_back()
-    {
-        for_each(readable_members{}, [&](auto member) {
-            constexpr auto i = refl::trait::index_of_v<decltype(member), readable_members>;
-            std::get<i>(storage_).pop_back();
-        });
-    }
-
-    T at(size_t index) const
-    {
-        T t{};
-        for_each(readable_members{}, [&](auto member) {
-            constexpr auto i = refl::trait::index_of_v<decltype(member), readable_members>;
-            std::get<i>(storage_).pop_back();
-        });
-    }
-
-    template <typename Member>
-    auto& operator[](Member)
-    {
-        constexpr auto i = refl::trait::index_of_v<Member, readable_members>;
-        return std::get<i>(storage_);
-    }
-
-    template <typename Member>
-    const auto& operator[](Member) const
-    {
-        constexpr auto i = refl::trait::index_of_v<Member, readable_members>;
-        return std::get<i>(storage_);
-    }
-
-    size_t size() const
-    {
-        return std::get<0>(storage_).size();
-    }
-
-    template <typename Member, typename Self>
-    static auto invoke_impl(Self&& self, size_t index) -> decltype(auto)
-    {
-        constexpr auto i = refl::trait::index_of_v<Member, readable_members>;
-        auto&& vec = std::get<i>(self.storage_);
-        return vec.at(index);
-    }
-
-private:
-
-    template <typename ReadableMember>
-    struct make_storage
-    {
-        using type = std::vector<underlying_type<ReadableMember>>;
-    };
-
-    refl::trait::as_tuple_t<refl::trait::map_t<make_storage, readable_members>> storage_;
-};
-
-template <size_t N, typename T>
-auto& get(struct_of_arrays<T>& soa)
-{
-    using member = refl::trait::get_t<N, typename struct_of_arrays<T>::readable_members>;
-    return soa[member{}];
-}
-
-template <size_t N, typename T>
-const auto& get(const struct_of_arrays<T>& soa)
-{
-    using member = refl::trait::get_t<N, typename struct_of_arrays<T>::readable_members>;
-    return soa[member{}];
-}
-
-namespace std
-{
-    template <typename T>
-    struct tuple_size<struct_of_arrays<T>>
-    {
-        static constexpr size_t value = struct_of_arrays<T>::readable_members::size;
-    };
-
-    template <size_t N, typename T>
-    struct tuple_element<N, struct_of_arrays<T>>
-    {
-        using descriptor = refl::trait::get_t<N, typename struct_of_arrays<T>::readable_members>;
-        using type = decltype(std::declval<struct_of_arrays<T>>()[descriptor{}]);
-    };
-}
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include "soa-vector.hpp"
 
 /********************************/
 
@@ -155,15 +45,47 @@ REFL_AUTO(
 
 int main()
 {
-    struct_of_arrays<color> colors;
+    soa_vector<color> colors;
     colors.push_back(color{ .0f, .5f, .5f });
     colors.push_back(color{ .0f, .5f, .0f });
     colors.push_back(color{ .5f, .5f, .5f });
 
-    auto& [red_chan, green_chan, blue_chan] = colors;
-
     std::cout << "size=" << colors.size() << "\n";
+    for (auto c : colors) {
+        std::cout << "r=" << c.red() << ",g=" << c.green() << ",b=" << c.blue() << "\n";
+    }
+
+    // the proxies write to the arrays
+    colors[1].set_blue(1.0f);
+    colors[2] = color{ 1.0f, 1.0f, 1.0f };
+    for (auto c : colors) {
+        c.set_red(c.red() + 0.25f);
+    }
+
+    // each property is a contiguous, cache-line aligned array
+    using members = soa_vector<color>::members;
+    const float* reds = colors.data(refl::trait::get_t<0, members>{});
+    const float* blues = colors.data(refl::trait::get_t<2, members>{});
+    assert(reinterpret_cast<uintptr_t>(reds) % 64 == 0 && reinterpret_cast<uintptr_t>(blues) % 64 == 0);
+    assert(reds[0] == .25f && reds[2] == 1.25f && blues[1] == 1.0f);
+    std::cout << "reds[0]=" << reds[0] << ",blues[1]=" << blues[1] << "\n";
+
+    colors.erase(colors.begin());
+    color copy = colors.at(0);
+    assert(colors.size() == 2 && copy.red() == .25f && copy.blue() == 1.0f);
+    std::cout << "after erase: r=" << copy.red() << ",g=" << copy.green() << ",b=" << copy.blue() << "\n";
+
+    // growing moves every array into a single new allocation
+    colors.resize(1000, color{ .1f, .2f, .3f });
+    assert(colors.capacity() >= 1000 && colors.back().green() == .2f && colors[1].blue() == 1.0f);
+    std::cout << "size=" << colors.size() << ", capacity=" << colors.capacity() << "\n";
+
+    // the iterators are random-access, so the standard algorithms work with them
     for (size_t i = 0; i < colors.size(); i++) {
-        std::cout << "r=" << red_chan[i] << ",g=" << green_chan[i] << ",b=" << blue_chan[i] << "\n";
+        colors[i].set_green(static_cast<float>((i * 7919) % 1000));
     }
+    std::sort(colors.begin(), colors.end(), [](const auto& a, const auto& b) { return a.green() < b.green(); });
+    assert(std::is_sorted(colors.begin(), colors.end(), [](const auto& a, const auto& b) { return a.green() < b.green(); }));
+    auto found = std::find_if(colors.begin(), colors.end(), [](auto c) { return c.blue() == 1.0f; });
+    std::cout << "sorted, first green=" << colors.front().green() << ", index of blue=" << found - colors.begin() << "\n";
 }
@@ -0,0 +1,129 @@
+/**
+ * ***README***
+ * This example shows the schema-evolvable binary format implemented in tagged-binary.hpp.
+ * Fields are identified by the number given to them with the tag attribute, so two
+ * versions of the same type can read each other's data: unknown tags are skipped,
+ * missing fields keep their default value, and integer fields can be widened.
+ */
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "tagged-binary.hpp"
+
+namespace v1
+{
+    struct Account
+    {
+        uint64_t id = 0;
+        std::string owner;
+        int32_t balance = 0;
+        // not serialized
+        bool dirty = false;
+    };
+}
+
+REFL_AUTO(
+    type(v1::Account),
+    field(id, tag(1)),
+    field(owner, tag(2)),
+    field(balance, tag(3)),
+    field(dirty)
+)
+
+namespace v2
+{
+    struct Address
+    {
+        std::string city;
+        std::string street;
+    };
+
+    enum class Tier
+    {
+        Basic,
+        Premium
+    };
+
+    struct Account
+    {
+        uint64_t id = 0;
+        std::string owner;
+        int64_t balance = 0;
+        Tier tier = Tier::Basic;
+        std::vector<std::string> aliases;
+        std::optional<double> credit_limit;
+        Address address;
+        std::map<std::string, uint32_t> limits;
+    };
+}
+
+REFL_AUTO(type(v2::Address), field(city, tag(1)), field(street, tag(2)))
+
+// tags do not need to be contiguous or in the order of the fields
+REFL_AUTO(
+    type(v2::Account),
+    field(id, tag(1)),
+    field(owner, tag(2)),
+    field(balance, tag(3)),
+    field(tier, tag(10)),
+    field(aliases, tag(4)),
+    field(credit_limit, tag(5)),
+    field(address, tag(6)),
+    field(limits, tag(7))
+)
+
+int main()
+{
+    v1::Account old_account{ 42, "Jane Doe", -1500, true };
+
+    std::vector<unsigned char> buffer;
+    serialize_tagged(old_account, buffer);
+    // 3 keys of 1 byte, 1 byte for the id, 1 + 8 bytes for the owner and 2 bytes for the balance
+    assert(buffer.size() == 3 + 1 + 9 + 2);
+    std::cout << "v1 account: " << buffer.size() << " bytes" << std::endl;
+
+    // a newer reader gets the fields it knows about, and keeps the defaults of the others
+    v2::Account account;
+    deserialize_tagged(buffer.data(), buffer.size(), account);
+    assert(account.id == 42 && account.owner == "Jane Doe" && account.balance == -1500);
+    assert(account.tier == v2::Tier::Basic && account.aliases.empty() && !account.credit_limit);
+
+    account.balance = 1000000;
+    account.tier = v2::Tier::Premium;
+    account.aliases = { "jd", "jane" };
+    account.address = { "Sofia", "Vitosha 1" };
+    account.limits = { { "daily", 5000 }, { "monthly", 100000 } };
+
+    buffer.clear();
+    serialize_tagged(account, buffer);
+    std::cout << "v2 account: " << buffer.size() << " bytes" << std::endl;
+
+    v2::Account copy;
+    deserialize_tagged(buffer.data(), buffer.size(), copy);
+    assert(copy.id == account.id && copy.owner == account.owner && copy.balance == account.balance);
+    assert(copy.tier == v2::Tier::Premium && copy.aliases == account.aliases && !copy.credit_limit);
+    assert(copy.address.city == "Sofia" && copy.address.street == "Vitosha 1" && copy.limits == account.limits);
+
+    // an older reader skips the tags it does not know about
+    v1::Account old_copy;
+    deserialize_tagged(buffer.data(), buffer.size(), old_copy);
+    assert(old_copy.id == 42 && old_copy.owner == "Jane Doe" && old_copy.balance == 1000000 && !old_copy.dirty);
+    std::cout << "v1 reader: id = " << old_copy.id << ", owner = " << old_copy.owner << ", balance = " << old_copy.balance << std::endl;
+
+    // but it rejects values which do not fit into its fields
+    account.balance = int64_t(1) << 40;
+    account.credit_limit = 250.5;
+    buffer.clear();
+    serialize_tagged(account, buffer);
+    try {
+        deserialize_tagged(buffer.data(), buffer.size(), old_copy);
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
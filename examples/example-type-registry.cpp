@@ -0,0 +1,76 @@
+/**
+ * ***README***
+ * This example shows how to use the TypeRegistry from type-registry.hpp
+ * to enumerate reflected types and look them up by id or by name at runtime,
+ * e.g. when instantiating types by name from a plugin or configuration file.
+ */
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "type-registry.hpp"
+
+struct Transform
+{
+    float x, y, z;
+};
+
+REFL_AUTO(type(Transform), field(x), field(y), field(z))
+
+struct Health
+{
+    int current;
+    int max;
+};
+
+REFL_AUTO(type(Health), field(current), field(max))
+
+template <typename T>
+struct Tagged
+{
+    T value;
+};
+
+REFL_AUTO(template((typename T), (Tagged<T>)), field(value))
+
+int main()
+{
+    TypeRegistry& registry = TypeRegistry::Instance();
+
+    // registration happens once, typically at startup
+    uint32_t transform_id = registry.Register<Transform>();
+    uint32_t health_id = registry.Register<Health>();
+    // template instances share the name of the template, so we provide our own
+    registry.Register<Tagged<int>>("Tagged<int>");
+
+    assert(registry.Register<Transform>() == transform_id);
+    assert(TypeRegistry::IdOf<Health>() == health_id);
+    assert(TypeRegistry::IdOf<Tagged<float>>() == TypeRegistry::invalid_id);
+    (void)transform_id;
+
+    // lookups never lock, so any number of threads can perform them concurrently
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&registry, health_id] {
+            for (int j = 0; j < 1000; j++) {
+                const TypeRecord* record = registry.Find("Health");
+                assert(record != nullptr && record->id == health_id);
+                (void)record;
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    for (uint32_t id = 0; id < registry.Size(); id++) {
+        const TypeRecord* record = registry.Find(id);
+        std::cout << record->id << ": " << record->name
+            << " (size=" << record->size
+            << ", align=" << record->align
+            << ", members=" << record->member_count << ")\n";
+    }
+
+    assert(registry.Find("Tagged<int>")->size == sizeof(Tagged<int>));
+    assert(registry.Find("Unknown") == nullptr);
+}
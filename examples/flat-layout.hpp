@@ -0,0 +1,534 @@
+/**
+ * ***README***
+ * A flat serialized layout, in the spirit of FlatBuffers, which is read in place: the data can be
+ * memory-mapped and used straight away, without deserializing (or even scanning) anything.
+ * Used by example-flat-layout.cpp and bench/bench-flat-layout-open.cpp.
+ *
+ * Each reflected type is laid out as a fixed-size table with one slot per non-static field, at
+ * offsets computed at compile-time (fields are sorted by alignment, so there is no padding between
+ * them). Slots hold:
+ * <ul>
+ * <li>arithmetic types and enum classes - the value itself, in native byte order (bools are
+ *     read as true when their byte is not 0, as not every byte is a valid bool)</li>
+ * <li>reflected types - their table, inline</li>
+ * <li>std::array - its elements' slots, inline</li>
+ * <li>std::string and std::vector - a uint64_t offset to the data, relative to the slot
+ *     (0 when empty); the data is the uint64_t number of elements followed by the elements' slots
+ *     (or the characters and a null terminator)</li>
+ * </ul>
+ * All out-of-line data is 8-byte aligned, so everything is naturally aligned, provided that the
+ * buffer itself is (memory-mapped files and heap allocations are). serialize_flat(value, out)
+ * appends a 16-byte header (a magic number, the size of the root table and the schema fingerprint
+ * of T, see refl::descriptor::get_fingerprint) and the root table, followed by the out-of-line data.
+ *
+ * view_flat<T>(data, size) only checks the header, so opening the data takes constant time.
+ * flat_view<T> is a refl::runtime::proxy of T: each of its member functions is a load at a
+ * constant offset from the start of the table. verify_flat<T>(data, size) checks all offsets and
+ * sizes, for data which does not come from a trusted source.
+ */
+#ifndef REFL_EXAMPLES_FLAT_LAYOUT_HPP
+#define REFL_EXAMPLES_FLAT_LAYOUT_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "refl.hpp"
+
+template <typename T>
+class flat_view;
+
+namespace flat_detail
+{
+    // the type of offsets and element counts
+    using size_type = uint64_t;
+
+    static constexpr size_t data_alignment = 8;
+
+    static constexpr char magic[4] = { 'R', 'F', 'L', 'T' };
+
+    struct header
+    {
+        char magic[4];
+        uint32_t table_size;
+        uint64_t fingerprint;
+    };
+
+    template <typename T>
+    static constexpr uint64_t schema_fingerprint = refl::descriptor::get_fingerprint(refl::reflect<T>());
+
+    template <typename T>
+    struct is_vector : std::false_type {};
+
+    template <typename T, typename Allocator>
+    struct is_vector<std::vector<T, Allocator>> : std::true_type {};
+
+    template <typename T>
+    struct is_string : std::false_type {};
+
+    template <typename Traits, typename Allocator>
+    struct is_string<std::basic_string<char, Traits, Allocator>> : std::true_type {};
+
+    template <typename T>
+    struct is_std_array : std::false_type {};
+
+    template <typename T, size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    template <typename T>
+    static constexpr bool is_scalar_v = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+    // the members which are stored (non-static fields)
+    template <typename T>
+    static constexpr auto fields = filter(refl::member_list<T>{}, [](auto member) {
+        if constexpr (refl::descriptor::is_field(member)) {
+            return !refl::descriptor::is_static(member);
+        }
+        else {
+            return false;
+        }
+    });
+
+    template <typename T>
+    using fields_t = std::remove_const_t<decltype(fields<T>)>;
+
+    template <typename Member>
+    using field_type = std::remove_cv_t<typename Member::value_type>;
+
+    constexpr size_t align_up(size_t size, size_t alignment) noexcept
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    template <typename T>
+    struct layout;
+
+    template <typename T>
+    constexpr size_t slot_alignment() noexcept
+    {
+        if constexpr (is_scalar_v<T>) {
+            static_assert(alignof(T) <= data_alignment, "Over-aligned types are not supported by the flat layout!");
+            return alignof(T);
+        }
+        else if constexpr (is_string<T>::value || is_vector<T>::value) {
+            return alignof(size_type);
+        }
+        else if constexpr (is_std_array<T>::value) {
+            return slot_alignment<typename T::value_type>();
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by the flat layout!");
+            return layout<T>::alignment;
+        }
+    }
+
+    template <typename T>
+    constexpr size_t slot_size() noexcept
+    {
+        if constexpr (is_scalar_v<T>) {
+            return sizeof(T);
+        }
+        else if constexpr (is_string<T>::value || is_vector<T>::value) {
+            return sizeof(size_type);
+        }
+        else if constexpr (is_std_array<T>::value) {
+            return slot_size<typename T::value_type>() * std::tuple_size_v<T>;
+        }
+        else {
+            return layout<T>::size;
+        }
+    }
+
+    /** The offsets of the slots of the fields of T in its table, and the size and alignment of the table. */
+    template <typename T>
+    struct layout
+    {
+        static constexpr std::array<size_t, fields<T>.size + 2> compute() noexcept
+        {
+            // slot sizes are multiples of their alignment, so placing the most aligned slots first leaves no gaps
+            std::array<size_t, fields<T>.size + 2> result{};
+            size_t size = 0;
+            size_t max_alignment = 1;
+            for (size_t alignment = data_alignment; alignment != 0; alignment /= 2) {
+                for_each(fields<T>, [&](auto member, size_t index) {
+                    using type = field_type<decltype(member)>;
+                    if (slot_alignment<type>() == alignment) {
+                        result[index] = size;
+                        size += slot_size<type>();
+                        max_alignment = max_alignment < alignment ? alignment : max_alignment;
+                    }
+                });
+            }
+            result[fields<T>.size] = align_up(size, max_alignment);
+            result[fields<T>.size + 1] = max_alignment;
+            return result;
+        }
+
+        static constexpr std::array<size_t, fields<T>.size + 2> values = compute();
+
+        static constexpr size_t size = values[fields<T>.size];
+        static constexpr size_t alignment = values[fields<T>.size + 1];
+
+        template <size_t Index>
+        static constexpr size_t offset = values[Index];
+    };
+
+    template <typename T>
+    T load(const unsigned char* data) noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return *data != 0;
+        }
+        else {
+            if constexpr (std::is_enum_v<T>) {
+                static_assert(!std::is_convertible_v<T, std::underlying_type_t<T>>,
+                    "Unscoped enums are not supported by the flat layout (use an enum class)!");
+            }
+            T value;
+            std::memcpy(&value, data, sizeof(T));
+            return value;
+        }
+    }
+
+    template <typename Buffer>
+    void store(Buffer& out, size_t pos, const void* data, size_t size)
+    {
+        std::memcpy(out.data() + pos, data, size);
+    }
+
+    // Appends size zero bytes at the next aligned position and returns that position.
+    template <typename Buffer>
+    size_t allocate(Buffer& out, size_t size)
+    {
+        size_t pos = align_up(out.size(), data_alignment);
+        out.resize(pos + size);
+        return pos;
+    }
+
+    template <typename T, typename Buffer>
+    void write_slot(Buffer& out, size_t slot, const T& value)
+    {
+        if constexpr (is_scalar_v<T>) {
+            store(out, slot, &value, sizeof(T));
+        }
+        else if constexpr (is_string<T>::value) {
+            if (value.empty()) return;
+            size_type size = value.size();
+            size_t pos = allocate(out, sizeof(size) + value.size() + 1);
+            store(out, pos, &size, sizeof(size));
+            store(out, pos + sizeof(size), value.data(), value.size());
+            size_type offset = pos - slot;
+            store(out, slot, &offset, sizeof(offset));
+        }
+        else if constexpr (is_vector<T>::value) {
+            using element_type = typename T::value_type;
+            if (value.empty()) return;
+            size_type size = value.size();
+            size_t pos = allocate(out, sizeof(size) + value.size() * slot_size<element_type>());
+            store(out, pos, &size, sizeof(size));
+            size_type offset = pos - slot;
+            store(out, slot, &offset, sizeof(offset));
+            if constexpr (is_scalar_v<element_type> && !std::is_same_v<element_type, bool>) {
+                store(out, pos + sizeof(size), value.data(), value.size() * sizeof(element_type));
+            }
+            else {
+                for (size_t i = 0; i < value.size(); i++) {
+                    write_slot<element_type>(out, pos + sizeof(size) + i * slot_size<element_type>(), value[i]);
+                }
+            }
+        }
+        else if constexpr (is_std_array<T>::value) {
+            using element_type = typename T::value_type;
+            for (size_t i = 0; i < value.size(); i++) {
+                write_slot<element_type>(out, slot + i * slot_size<element_type>(), value[i]);
+            }
+        }
+        else {
+            for_each(fields<T>, [&](auto member, size_t index) {
+                using type = field_type<decltype(member)>;
+                write_slot<type>(out, slot + layout<T>::values[index], member(value));
+            });
+        }
+    }
+
+    template <typename T>
+    auto view_at(const unsigned char* slot) noexcept;
+
+    // Checks the slot of a T, following and counting its offsets.
+    template <typename T>
+    void verify_slot(const unsigned char* slot, const unsigned char* end, size_t& references)
+    {
+        if constexpr (is_string<T>::value || is_vector<T>::value) {
+            size_type offset = load<size_type>(slot);
+            if (offset == 0) return;
+            // offsets only point forward, and each block of data is referenced once
+            if (offset % data_alignment != 0 || offset > static_cast<size_t>(end - slot) || --references == 0) {
+                throw std::runtime_error("Invalid flat data: bad offset!");
+            }
+            const unsigned char* data = slot + offset;
+            if (static_cast<size_t>(end - data) < sizeof(size_type)) {
+                throw std::runtime_error("Invalid flat data: unexpected end of input!");
+            }
+            size_type size = load<size_type>(data);
+            data += sizeof(size_type);
+
+            using element_type = std::conditional_t<is_string<T>::value, char, typename T::value_type>;
+            if (size > static_cast<size_t>(end - data) / slot_size<element_type>()) {
+                throw std::runtime_error("Invalid flat data: unexpected end of input!");
+            }
+            if constexpr (!is_scalar_v<element_type>) {
+                for (size_t i = 0; i < size; i++) {
+                    verify_slot<element_type>(data + i * slot_size<element_type>(), end, references);
+                }
+            }
+        }
+        else if constexpr (is_std_array<T>::value) {
+            using element_type = typename T::value_type;
+            if constexpr (!is_scalar_v<element_type>) {
+                for (size_t i = 0; i < std::tuple_size_v<T>; i++) {
+                    verify_slot<element_type>(slot + i * slot_size<element_type>(), end, references);
+                }
+            }
+        }
+        else if constexpr (!is_scalar_v<T>) {
+            for_each(fields<T>, [&](auto member, size_t index) {
+                verify_slot<field_type<decltype(member)>>(slot + layout<T>::values[index], end, references);
+            });
+        }
+    }
+
+    // Checks the header and returns the root table.
+    template <typename T>
+    const unsigned char* root(const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        if (reinterpret_cast<uintptr_t>(bytes) % data_alignment != 0) {
+            throw std::runtime_error("Flat data must be 8-byte aligned!");
+        }
+        if (size < sizeof(header) + layout<T>::size) {
+            throw std::runtime_error("Invalid flat data: unexpected end of input!");
+        }
+        header h = load<header>(bytes);
+        if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.table_size != layout<T>::size) {
+            throw std::runtime_error("Invalid flat data: not a flat layout of this type!");
+        }
+        if (h.fingerprint != schema_fingerprint<T>) {
+            throw std::runtime_error("Invalid flat data: written with a different definition of this type!");
+        }
+        return bytes + sizeof(header);
+    }
+}
+
+/**
+ * A read-only view of a string or vector of arithmetic types (other than bool) or enums inside flat data.
+ * The elements are aligned, so they are accessed through a pointer.
+ */
+template <typename T>
+class flat_span
+{
+public:
+    flat_span(const T* data, size_t size) noexcept
+        : data_(data), size_(size)
+    {
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    const T* data() const noexcept { return data_; }
+
+    const T& operator[](size_t index) const noexcept { return data_[index]; }
+
+    const T* begin() const noexcept { return data_; }
+    const T* end() const noexcept { return data_ + size_; }
+
+private:
+    const T* data_;
+    size_t size_;
+};
+
+/**
+ * A read-only view of a vector or array of bools, strings, vectors or reflected types inside flat data.
+ * Elements have slots of the same size, so they can be accessed in any order.
+ */
+template <typename T>
+class flat_sequence
+{
+public:
+    using value_type = decltype(flat_detail::view_at<T>(nullptr));
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = flat_sequence::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        explicit iterator(const unsigned char* pos = nullptr) noexcept : pos_(pos) {}
+
+        value_type operator*() const noexcept { return flat_detail::view_at<T>(pos_); }
+
+        iterator& operator++() noexcept { pos_ += flat_detail::slot_size<T>(); return *this; }
+        iterator operator++(int) noexcept { iterator it = *this; ++*this; return it; }
+        bool operator==(const iterator& other) const noexcept { return pos_ == other.pos_; }
+        bool operator!=(const iterator& other) const noexcept { return pos_ != other.pos_; }
+
+    private:
+        const unsigned char* pos_;
+    };
+
+    flat_sequence(const unsigned char* data, size_t size) noexcept
+        : data_(data), size_(size)
+    {
+    }
+
+    size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    value_type operator[](size_t index) const noexcept
+    {
+        return flat_detail::view_at<T>(data_ + index * flat_detail::slot_size<T>());
+    }
+
+    iterator begin() const noexcept { return iterator(data_); }
+    iterator end() const noexcept { return iterator(data_ + size_ * flat_detail::slot_size<T>()); }
+
+private:
+    const unsigned char* data_;
+    size_t size_;
+};
+
+/**
+ * A view of a T in flat data, which reads the fields of T in place: flat_view<T> has a member
+ * function for each field of T, which loads the field from a constant offset. Fields are returned as:
+ * <ul>
+ * <li>arithmetic types and enums - by value</li>
+ * <li>std::string - std::string_view</li>
+ * <li>std::vector and std::array of arithmetic types (other than bool) or enums - flat_span</li>
+ * <li>std::vector and std::array of other types (and bools) - flat_sequence</li>
+ * <li>other reflected types - flat_view</li>
+ * </ul>
+ * The data must outlive the view. Views are the size of a pointer and are cheap to copy.
+ */
+template <typename T>
+class flat_view : public refl::runtime::proxy<flat_view<T>, T>
+{
+public:
+    explicit flat_view(const unsigned char* table) noexcept
+        : table_(table)
+    {
+    }
+
+    /** The table of the viewed value. */
+    const unsigned char* bytes() const noexcept
+    {
+        return table_;
+    }
+
+    template <typename Member, typename Self>
+    static auto invoke_impl(Self&& self) noexcept
+    {
+        constexpr ptrdiff_t index = refl::trait::index_of_v<Member, flat_detail::fields_t<T>>;
+        static_assert(index != -1, "Only non-static fields are available in a flat_view!");
+        return flat_detail::view_at<flat_detail::field_type<Member>>(self.table_ + flat_detail::layout<T>::template offset<index>);
+    }
+
+private:
+    const unsigned char* table_;
+};
+
+namespace flat_detail
+{
+    template <typename T>
+    auto view_at(const unsigned char* slot) noexcept
+    {
+        if constexpr (is_scalar_v<T>) {
+            return load<T>(slot);
+        }
+        else if constexpr (is_string<T>::value) {
+            size_type offset = load<size_type>(slot);
+            if (offset == 0) return std::string_view();
+            const unsigned char* data = slot + offset;
+            return std::string_view(reinterpret_cast<const char*>(data + sizeof(size_type)), static_cast<size_t>(load<size_type>(data)));
+        }
+        else if constexpr (is_vector<T>::value || is_std_array<T>::value) {
+            using element_type = typename T::value_type;
+            // bools are loaded one by one, rather than through a pointer
+            constexpr bool is_span = is_scalar_v<element_type> && !std::is_same_v<element_type, bool>;
+            using view_type = std::conditional_t<is_span, flat_span<element_type>, flat_sequence<element_type>>;
+            const unsigned char* data = slot;
+            size_t size = 0;
+            if constexpr (is_std_array<T>::value) {
+                size = std::tuple_size_v<T>;
+            }
+            else {
+                size_type offset = load<size_type>(slot);
+                if (offset != 0) {
+                    data = slot + offset;
+                    size = static_cast<size_t>(load<size_type>(data));
+                    data += sizeof(size_type);
+                }
+            }
+            if constexpr (is_span) {
+                return view_type(reinterpret_cast<const element_type*>(data), size);
+            }
+            else {
+                return view_type(data, size);
+            }
+        }
+        else {
+            return flat_view<T>(slot);
+        }
+    }
+}
+
+/**
+ * Appends the flat layout of value to out (a std::vector<unsigned char> or another
+ * contiguous container of bytes with resize()). The data starts at the next 8-byte aligned
+ * position of out, which is returned.
+ */
+template <typename T, typename Buffer>
+size_t serialize_flat(const T& value, Buffer& out)
+{
+    static_assert(refl::trait::is_reflectable_v<T> && !flat_detail::is_scalar_v<T>, "The root of flat data must be a reflected type!");
+    size_t start = flat_detail::allocate(out, sizeof(flat_detail::header) + flat_detail::layout<T>::size);
+    flat_detail::header h{ { flat_detail::magic[0], flat_detail::magic[1], flat_detail::magic[2], flat_detail::magic[3] },
+        static_cast<uint32_t>(flat_detail::layout<T>::size), flat_detail::schema_fingerprint<T> };
+    flat_detail::store(out, start, &h, sizeof(h));
+    flat_detail::write_slot<T>(out, start + sizeof(h), value);
+    return start;
+}
+
+/**
+ * Returns a view of the T in the flat data at data, which must be 8-byte aligned.
+ * Only the header is checked (in constant time). Throws std::runtime_error when the data
+ * does not start with a flat layout of T. Use verify_flat for data which cannot be trusted.
+ */
+template <typename T>
+flat_view<T> view_flat(const void* data, size_t size)
+{
+    return flat_view<T>(flat_detail::root<T>(data, size));
+}
+
+/**
+ * Checks that all offsets and sizes in the flat data at data are in bounds, so that no
+ * access through view_flat<T>(data, size) can read past the end of the data.
+ * Takes time proportional to the number of strings, vectors and tables.
+ * Throws std::runtime_error on invalid data.
+ */
+template <typename T>
+void verify_flat(const void* data, size_t size)
+{
+    const unsigned char* table = flat_detail::root<T>(data, size);
+    // each block of out-of-line data takes at least 8 bytes
+    size_t references = size / flat_detail::data_alignment + 1;
+    flat_detail::verify_slot<T>(table, static_cast<const unsigned char*>(data) + size, references);
+}
+
+#endif // REFL_EXAMPLES_FLAT_LAYOUT_HPP
@@ -0,0 +1,670 @@
+/**
+ * ***README***
+ * A JSON serializer driven by refl-cpp type descriptors.
+ * Used by example-json.cpp, bench/bench-json-write.cpp and bench/bench-json-read.cpp.
+ *
+ * write_json(value, out) appends the JSON representation of value to out. Reflected types
+ * become objects with one key per readable member (fields and getter properties), named by
+ * their display name (the friendly_name of attr::property, when specified).
+ *
+ * The part of the output which precedes each value - {"name": for the first member and
+ * ,"email": for the rest - is rendered at compile-time by concatenating const_strings, so
+ * writing an object only takes one copy of a constant fragment per member plus the values.
+ * Numbers are formatted with std::to_chars and strings are escaped in bulk.
+ *
+ * read_json(json, value) parses straight into value, without a DOM. Each key is hashed 8 bytes
+ * at a time and looked up in a perfect hash table of display names generated at compile-time,
+ * which then picks the function that parses the value of that member (in place for fields,
+ * through get_writer for properties). Unknown keys are skipped by a structural scanner.
+ */
+#ifndef REFL_EXAMPLES_JSON_HPP
+#define REFL_EXAMPLES_JSON_HPP
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "refl.hpp"
+
+namespace json_detail
+{
+    template <typename T>
+    struct is_optional : std::false_type {};
+
+    template <typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_std_array : std::false_type {};
+
+    template <typename T, size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    template <typename T>
+    struct is_string_like : std::bool_constant<std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, std::nullptr_t>> {};
+
+    template <typename T, typename = void>
+    struct is_key_value_container : std::false_type {};
+
+    // containers of std::pair<const K, V> with string-like keys are written as objects
+    template <typename T>
+    struct is_key_value_container<T, std::void_t<typename T::key_type, typename T::mapped_type>>
+        : is_string_like<typename T::key_type> {};
+
+    // the members which are written (fields and getter properties)
+    template <typename T>
+    static constexpr auto members = filter(refl::member_list<T>{}, [](auto member) { return is_readable(member); });
+
+    template <size_t N>
+    constexpr bool is_plain_key(const refl::util::const_string<N>& name)
+    {
+        for (size_t i = 0; i < N; i++) {
+            if (name.data[i] == '"' || name.data[i] == '\\' || static_cast<unsigned char>(name.data[i]) < 0x20) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The constant fragment written before the value of a member: {"key": or ,"key":
+    template <typename Member, bool First>
+    static constexpr auto key_fragment = refl::util::make_const_string(First ? '{' : ',')
+        + refl::util::make_const_string('"') + refl::descriptor::get_display_name_const(Member{}) + "\":";
+
+    template <typename Buffer>
+    void append(Buffer& out, const char* str, size_t len)
+    {
+        out.insert(out.end(), str, str + len);
+    }
+
+    template <typename Buffer, size_t N>
+    void append(Buffer& out, const refl::util::const_string<N>& str)
+    {
+        append(out, str.data, N);
+    }
+
+    template <typename Buffer>
+    void write_string(Buffer& out, std::string_view str)
+    {
+        static constexpr char hex[] = "0123456789abcdef";
+        out.push_back('"');
+        size_t run = 0;
+        for (size_t i = 0; i < str.size(); i++) {
+            unsigned char ch = static_cast<unsigned char>(str[i]);
+            if (ch >= 0x20 && ch != '"' && ch != '\\') {
+                continue;
+            }
+
+            append(out, str.data() + run, i - run);
+            run = i + 1;
+            switch (ch) {
+            case '"': append(out, "\\\"", 2); break;
+            case '\\': append(out, "\\\\", 2); break;
+            case '\n': append(out, "\\n", 2); break;
+            case '\r': append(out, "\\r", 2); break;
+            case '\t': append(out, "\\t", 2); break;
+            default: {
+                char escaped[6] = { '\\', 'u', '0', '0', hex[ch >> 4], hex[ch & 0xf] };
+                append(out, escaped, 6);
+            }
+            }
+        }
+        append(out, str.data() + run, str.size() - run);
+        out.push_back('"');
+    }
+
+    template <typename Buffer, typename T>
+    void write_number(Buffer& out, T value)
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            // JSON has no representation for these
+            if (!std::isfinite(value)) {
+                append(out, "null", 4);
+                return;
+            }
+        }
+        char str[64];
+        // shortest representation which round-trips for floating-point numbers
+        auto result = std::to_chars(str, str + sizeof(str), value);
+        append(out, str, static_cast<size_t>(result.ptr - str));
+    }
+
+    template <typename Buffer, typename T>
+    void write_value(Buffer& out, const T& value);
+
+    template <typename Buffer, typename T, typename... Members>
+    void write_object(Buffer& out, const T& value, refl::type_list<Members...>)
+    {
+        if constexpr (sizeof...(Members) == 0) {
+            append(out, "{}", 2);
+        }
+        else {
+            size_t index = 0;
+            ((index++ == 0 ? append(out, key_fragment<Members, true>) : append(out, key_fragment<Members, false>),
+                write_value(out, Members{}(value))), ...);
+            out.push_back('}');
+        }
+    }
+
+    template <typename Buffer, typename T>
+    void write_value(Buffer& out, const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (value) append(out, "true", 4);
+            else append(out, "false", 5);
+        }
+        else if constexpr (std::is_same_v<T, char>) {
+            write_string(out, std::string_view(&value, 1));
+        }
+        else if constexpr (std::is_arithmetic_v<T>) {
+            write_number(out, value);
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            write_number(out, static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (is_string_like<T>::value) {
+            write_string(out, std::string_view(value));
+        }
+        else if constexpr (is_optional<T>::value) {
+            if (value) write_value(out, *value);
+            else append(out, "null", 4);
+        }
+        else if constexpr (is_key_value_container<T>::value) {
+            out.push_back('{');
+            bool first = true;
+            for (const auto& [key, element] : value) {
+                if (!first) out.push_back(',');
+                first = false;
+                write_string(out, std::string_view(key));
+                out.push_back(':');
+                write_value(out, element);
+            }
+            out.push_back('}');
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            out.push_back('[');
+            bool first = true;
+            for (const auto& element : value) {
+                if (!first) out.push_back(',');
+                first = false;
+                write_value(out, element);
+            }
+            out.push_back(']');
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by write_json!");
+            static_assert(refl::util::accumulate(members<T>, [](bool plain, auto member) {
+                return plain && is_plain_key(refl::descriptor::get_display_name_const(member));
+            }, true), "Display names must not contain characters which need to be escaped!");
+            write_object(out, value, members<T>);
+        }
+    }
+}
+
+/**
+ * Appends the JSON representation of value to out
+ * (a std::string, std::vector<char> or any other container of char with insert(end, first, last) and push_back).
+ */
+template <typename T, typename Buffer>
+void write_json(const T& value, Buffer& out)
+{
+    json_detail::write_value(out, value);
+}
+
+/** Returns the JSON representation of value. */
+template <typename T>
+std::string to_json(const T& value)
+{
+    std::string out;
+    write_json(value, out);
+    return out;
+}
+
+namespace json_detail
+{
+    // the members which are read (writable fields and getter properties with a matching setter)
+    template <typename T>
+    static constexpr auto writable_members = filter(members<T>, [](auto member) {
+        if constexpr (refl::descriptor::is_field(member)) {
+            return refl::descriptor::is_writable(member);
+        }
+        else {
+            return refl::descriptor::has_writer(member);
+        }
+    });
+
+    template <typename T>
+    using writable_members_t = std::remove_const_t<decltype(writable_members<T>)>;
+
+    constexpr uint64_t load_le(const char* str, size_t count) noexcept
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < count; i++) {
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(str[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    // Hashes a key 8 bytes at a time, keys are short, so this is only a few multiplications.
+    constexpr uint64_t key_hash(std::string_view key) noexcept
+    {
+        using refl::runtime::detail::mix_hash;
+        const char* str = key.data();
+        size_t size = key.size();
+        uint64_t hash = size * 0x9e3779b97f4a7c15ull;
+        if (size < 8) {
+            return mix_hash(hash ^ load_le(str, size));
+        }
+        for (size_t i = 0; i + 8 < size; i += 8) {
+            hash = (hash ^ load_le(str + i, 8)) * 0xff51afd7ed558ccdull;
+        }
+        // the last word overlaps the previous one, unless size is a multiple of 8
+        return mix_hash(hash ^ load_le(str + size - 8, 8));
+    }
+
+    /**
+     * A perfect hash table of the display names of the writable members of T, built with the
+     * same hash-and-displace layout as the member name tables of refl::runtime, but keyed by
+     * key_hash (the descriptors only store the FNV-1a hashes of the member names).
+     */
+    template <typename T>
+    struct key_table
+    {
+        using name_info = refl::runtime::detail::member_name_info;
+
+        static constexpr auto names = refl::util::map_to_array<name_info>(writable_members<T>, [](auto member) {
+            std::string_view name = refl::descriptor::get_display_name_view(member);
+            return name_info{ name.data(), name.size(), key_hash(name) };
+        });
+
+        static_assert(refl::runtime::detail::count_unique_names(names) == names.size(), "The display names of the members are not unique!");
+
+        static constexpr size_t size = refl::runtime::detail::next_pow2(2 * names.size());
+        static constexpr auto layout = refl::runtime::detail::make_perfect_hash_layout<size>(names);
+
+        static_assert(layout.complete, "Could not build a perfect hash table of the display names!");
+
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        /** Returns the index of the member with the specified display name, or npos. */
+        static size_t find(std::string_view key) noexcept
+        {
+            uint64_t hash = key_hash(key);
+            size_t index = layout.slots[layout.slot_of(hash, layout.seeds[layout.bucket_of(hash)])];
+            // a single comparison is needed to reject unknown keys
+            if (index == npos || std::string_view(names[index].data, names[index].size) != key) {
+                return npos;
+            }
+            return index;
+        }
+    };
+
+    class parser
+    {
+    public:
+        parser(const char* begin, const char* end) noexcept
+            : begin_(begin), pos_(begin), end_(end)
+        {
+        }
+
+        [[noreturn]] void fail(const char* message) const
+        {
+            throw std::runtime_error(std::string("JSON error at offset ") + std::to_string(pos_ - begin_) + ": " + message);
+        }
+
+        void skip_whitespace() noexcept
+        {
+            while (pos_ != end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t')) {
+                pos_++;
+            }
+        }
+
+        char peek()
+        {
+            skip_whitespace();
+            if (pos_ == end_) fail("unexpected end of input");
+            return *pos_;
+        }
+
+        void expect(char ch)
+        {
+            if (peek() != ch) fail("unexpected character");
+            pos_++;
+        }
+
+        bool consume(char ch)
+        {
+            if (peek() != ch) return false;
+            pos_++;
+            return true;
+        }
+
+        bool consume_literal(std::string_view literal)
+        {
+            skip_whitespace();
+            if (static_cast<size_t>(end_ - pos_) < literal.size() || std::string_view(pos_, literal.size()) != literal) {
+                return false;
+            }
+            pos_ += literal.size();
+            return true;
+        }
+
+        bool at_end() noexcept
+        {
+            skip_whitespace();
+            return pos_ == end_;
+        }
+
+        template <typename T>
+        void read_number(T& value)
+        {
+            skip_whitespace();
+            auto result = std::from_chars(pos_, end_, value);
+            if (result.ec != std::errc()) fail("invalid number");
+            pos_ = result.ptr;
+        }
+
+        /** Reads a string into out. When the string has no escape sequences, returns a view of the input instead. */
+        std::string_view read_string(std::string& out)
+        {
+            expect('"');
+            const char* start = pos_;
+            // fast path: no escape sequences
+            while (pos_ != end_ && *pos_ != '"' && *pos_ != '\\') {
+                pos_++;
+            }
+            if (pos_ == end_) fail("unterminated string");
+            if (*pos_ == '"') {
+                return std::string_view(start, static_cast<size_t>(pos_++ - start));
+            }
+
+            out.assign(start, pos_);
+            while (true) {
+                if (pos_ == end_) fail("unterminated string");
+                char ch = *pos_++;
+                if (ch == '"') break;
+                if (ch != '\\') {
+                    out.push_back(ch);
+                    continue;
+                }
+                if (pos_ == end_) fail("unterminated string");
+                switch (char escaped = *pos_++) {
+                case '"': case '\\': case '/': out.push_back(escaped); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': append_code_point(out, read_code_point()); break;
+                default: fail("invalid escape sequence");
+                }
+            }
+            return out;
+        }
+
+        /** Skips a value of any type without decoding it. */
+        void skip_value()
+        {
+            char ch = peek();
+            if (ch == '"') {
+                skip_string();
+            }
+            else if (ch == '{' || ch == '[') {
+                // only the structure matters here: count the brackets outside of strings
+                size_t depth = 0;
+                do {
+                    if (pos_ == end_) fail("unexpected end of input");
+                    ch = *pos_;
+                    if (ch == '"') {
+                        skip_string();
+                        continue;
+                    }
+                    if (ch == '{' || ch == '[') depth++;
+                    else if (ch == '}' || ch == ']') depth--;
+                    pos_++;
+                } while (depth > 0);
+            }
+            else {
+                // numbers and literals
+                const char* start = pos_;
+                while (pos_ != end_ && *pos_ != ',' && *pos_ != '}' && *pos_ != ']'
+                    && *pos_ != ' ' && *pos_ != '\n' && *pos_ != '\r' && *pos_ != '\t') {
+                    pos_++;
+                }
+                if (pos_ == start) fail("expected a value");
+            }
+        }
+
+    private:
+
+        void skip_string()
+        {
+            pos_++;
+            while (true) {
+                const char* quote = static_cast<const char*>(std::memchr(pos_, '"', static_cast<size_t>(end_ - pos_)));
+                if (quote == nullptr) fail("unterminated string");
+                // the quote is escaped when preceded by an odd number of backslashes
+                const char* backslash = quote;
+                while (backslash != pos_ && backslash[-1] == '\\') backslash--;
+                pos_ = quote + 1;
+                if ((quote - backslash) % 2 == 0) return;
+            }
+        }
+
+        uint32_t read_hex4()
+        {
+            if (end_ - pos_ < 4) fail("invalid unicode escape");
+            uint32_t value = 0;
+            for (int i = 0; i < 4; i++) {
+                char ch = *pos_++;
+                value <<= 4;
+                if (ch >= '0' && ch <= '9') value |= static_cast<uint32_t>(ch - '0');
+                else if (ch >= 'a' && ch <= 'f') value |= static_cast<uint32_t>(ch - 'a' + 10);
+                else if (ch >= 'A' && ch <= 'F') value |= static_cast<uint32_t>(ch - 'A' + 10);
+                else fail("invalid unicode escape");
+            }
+            return value;
+        }
+
+        uint32_t read_code_point()
+        {
+            uint32_t code_point = read_hex4();
+            if (code_point >= 0xd800 && code_point < 0xdc00) {
+                // surrogate pair
+                if (end_ - pos_ < 2 || pos_[0] != '\\' || pos_[1] != 'u') fail("invalid surrogate pair");
+                pos_ += 2;
+                uint32_t low = read_hex4();
+                if (low < 0xdc00 || low >= 0xe000) fail("invalid surrogate pair");
+                code_point = 0x10000 + ((code_point - 0xd800) << 10) + (low - 0xdc00);
+            }
+            return code_point;
+        }
+
+        static void append_code_point(std::string& out, uint32_t code_point)
+        {
+            if (code_point < 0x80) {
+                out.push_back(static_cast<char>(code_point));
+            }
+            else if (code_point < 0x800) {
+                out.push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+                out.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+            }
+            else if (code_point < 0x10000) {
+                out.push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+                out.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+            }
+            else {
+                out.push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+                out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+                out.push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+            }
+        }
+
+        const char* begin_;
+        const char* pos_;
+        const char* end_;
+    };
+
+    template <typename T>
+    void read_value(parser& in, T& value);
+
+    template <typename T, size_t I>
+    void read_member(parser& in, T& target)
+    {
+        using member = refl::trait::get_t<I, writable_members_t<T>>;
+        if constexpr (refl::descriptor::is_field(member{})) {
+            // fields are parsed in place
+            read_value(in, member{}(target));
+        }
+        else {
+            refl::trait::remove_qualifiers_t<decltype(member{}(target))> value{};
+            read_value(in, value);
+            constexpr auto writer = refl::descriptor::get_writer(member{});
+            writer(target, std::move(value));
+        }
+    }
+
+    // A jump table with one entry per member, indexed by the key table.
+    template <typename T, typename = std::make_index_sequence<writable_members<T>.size>>
+    struct member_readers;
+
+    template <typename T, size_t... I>
+    struct member_readers<T, std::index_sequence<I...>>
+    {
+        using reader = void (*)(parser&, T&);
+        static constexpr reader table[sizeof...(I) > 0 ? sizeof...(I) : 1] = { &read_member<T, I>... };
+    };
+
+    template <typename T>
+    void read_object(parser& in, T& value)
+    {
+        in.expect('{');
+        if (in.consume('}')) return;
+
+        std::string key_buffer;
+        do {
+            std::string_view key = in.read_string(key_buffer);
+            in.expect(':');
+            size_t index = key_table<T>::find(key);
+            if (index == key_table<T>::npos) {
+                in.skip_value();
+            }
+            else {
+                member_readers<T>::table[index](in, value);
+            }
+        } while (in.consume(','));
+        in.expect('}');
+    }
+
+    template <typename T>
+    void read_value(parser& in, T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            if (in.consume_literal("true")) value = true;
+            else if (in.consume_literal("false")) value = false;
+            else in.fail("expected a boolean");
+        }
+        else if constexpr (std::is_same_v<T, char>) {
+            std::string buffer;
+            std::string_view str = in.read_string(buffer);
+            if (str.size() != 1) in.fail("expected a single character");
+            value = str[0];
+        }
+        else if constexpr (std::is_arithmetic_v<T>) {
+            in.read_number(value);
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> underlying;
+            in.read_number(underlying);
+            value = static_cast<T>(underlying);
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            std::string_view str = in.read_string(value);
+            if (str.data() != value.data()) {
+                value.assign(str.data(), str.size());
+            }
+        }
+        else if constexpr (is_optional<T>::value) {
+            if (in.consume_literal("null")) {
+                value.reset();
+            }
+            else {
+                if (!value) value.emplace();
+                read_value(in, *value);
+            }
+        }
+        else if constexpr (is_key_value_container<T>::value) {
+            static_assert(std::is_same_v<typename T::key_type, std::string>, "Only std::string keys are supported!");
+            value.clear();
+            in.expect('{');
+            if (in.consume('}')) return;
+            std::string key;
+            do {
+                std::string_view str = in.read_string(key);
+                typename T::mapped_type element{};
+                in.expect(':');
+                read_value(in, element);
+                value.emplace(std::string(str), std::move(element));
+            } while (in.consume(','));
+            in.expect('}');
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            in.expect('[');
+            if constexpr (is_std_array<T>::value) {
+                for (size_t i = 0; i < value.size(); i++) {
+                    if (i != 0) in.expect(',');
+                    read_value(in, value[i]);
+                }
+                in.expect(']');
+            }
+            else {
+                value.clear();
+                if (in.consume(']')) return;
+                do {
+                    read_value(in, value.emplace_back());
+                } while (in.consume(','));
+                in.expect(']');
+            }
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by read_json!");
+            read_object(in, value);
+        }
+    }
+}
+
+/**
+ * Parses json directly into value, without building a DOM. Keys are matched against the display names
+ * of the writable members of reflected types (writable fields and properties with a setter) through
+ * a perfect hash table generated at compile-time. Unknown keys are skipped, and members without a key
+ * keep their value. Throws std::runtime_error on invalid input.
+ */
+template <typename T>
+void read_json(std::string_view json, T& value)
+{
+    json_detail::parser in(json.data(), json.data() + json.size());
+    json_detail::read_value(in, value);
+    if (!in.at_end()) {
+        in.fail("unexpected data after the value");
+    }
+}
+
+/** Parses json into a default-constructed T. */
+template <typename T>
+T from_json(std::string_view json)
+{
+    T value{};
+    read_json(json, value);
+    return value;
+}
+
+#endif // REFL_EXAMPLES_JSON_HPP
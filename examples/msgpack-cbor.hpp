@@ -0,0 +1,800 @@
+/**
+ * ***README***
+ * MessagePack and CBOR encoders and decoders driven by refl-cpp type descriptors.
+ * Used by example-msgpack-cbor.cpp and bench/bench-msgpack-cbor-encode.cpp.
+ *
+ * Both formats share the same generic code (msgpack_cbor_detail::write_value and read_value),
+ * which is parameterized by a small policy class per format that encodes and decodes the
+ * headers of individual items (msgpack_cbor_detail::msgpack and msgpack_cbor_detail::cbor).
+ *
+ * Integers are always written with the smallest encoding which can represent the value.
+ * Reflected types are written as maps from the display names of their readable members
+ * (fields and getter properties) to the values. The encoded names (string header included)
+ * are generated at compile-time, so writing a key is a single copy of a constant byte string.
+ * With object_mode::array the names are dropped and the values are written as an array,
+ * in declaration order.
+ *
+ * The decoders accept both maps and arrays for reflected types, and any valid encoding of
+ * a value (not only the smallest one). Integers are checked to fit into the target type,
+ * unknown keys and extra array elements are skipped and members without a value keep theirs.
+ */
+#ifndef REFL_EXAMPLES_MSGPACK_CBOR_HPP
+#define REFL_EXAMPLES_MSGPACK_CBOR_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "refl.hpp"
+
+/** How reflected types are encoded. */
+enum class object_mode
+{
+    /** As maps from the display names of the members to their values. */
+    map,
+    /** As arrays of the values of the members, in declaration order. */
+    array
+};
+
+namespace msgpack_cbor_detail
+{
+    using byte = unsigned char;
+
+    template <typename T>
+    struct is_optional : std::false_type {};
+
+    template <typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_std_array : std::false_type {};
+
+    template <typename T, size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    template <typename T>
+    struct is_string_like : std::bool_constant<std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, std::nullptr_t>> {};
+
+    template <typename T, typename = void>
+    struct is_key_value_container : std::false_type {};
+
+    template <typename T>
+    struct is_key_value_container<T, std::void_t<typename T::key_type, typename T::mapped_type>> : std::true_type {};
+
+    // the members which are written (fields and getter properties)
+    template <typename T>
+    static constexpr auto members = filter(refl::member_list<T>{}, [](auto member) { return is_readable(member); });
+
+    // Writes the size low bytes of value in big-endian order.
+    constexpr size_t put_be(byte* out, uint64_t value, size_t size) noexcept
+    {
+        for (size_t i = 0; i < size; i++) {
+            out[i] = static_cast<byte>(value >> (8 * (size - 1 - i)));
+        }
+        return size;
+    }
+
+    constexpr size_t put_tagged(byte* out, byte tag, uint64_t value, size_t size) noexcept
+    {
+        out[0] = tag;
+        return 1 + put_be(out + 1, value, size);
+    }
+
+    inline uint32_t float_bits(float value) noexcept
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline uint64_t double_bits(double value) noexcept
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    inline float float_from_bits(uint64_t bits) noexcept
+    {
+        uint32_t narrow = static_cast<uint32_t>(bits);
+        float value;
+        std::memcpy(&value, &narrow, sizeof(value));
+        return value;
+    }
+
+    inline double double_from_bits(uint64_t bits) noexcept
+    {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /** The kinds of items, as reported by the decoders of the formats. */
+    enum class item_kind
+    {
+        nil,
+        boolean,
+        uint,
+        sint,
+        floating,
+        string,
+        binary,
+        array,
+        map
+    };
+
+    /** The header of a decoded item. */
+    struct item
+    {
+        item_kind kind;
+        // the value of booleans and integers (the bits of an int64_t for sint),
+        // or the size of strings, binary data, arrays and maps
+        uint64_t value;
+        // the value of floating-point numbers
+        double number;
+    };
+
+    class reader
+    {
+    public:
+        reader(const byte* begin, const byte* end) noexcept
+            : begin_(begin), pos_(begin), end_(end)
+        {
+        }
+
+        [[noreturn]] void fail(const char* message) const
+        {
+            throw std::runtime_error(std::string("Decoding error at offset ") + std::to_string(offset()) + ": " + message);
+        }
+
+        const byte* take(uint64_t size)
+        {
+            if (static_cast<uint64_t>(end_ - pos_) < size) {
+                fail("unexpected end of input");
+            }
+            const byte* result = pos_;
+            pos_ += size;
+            return result;
+        }
+
+        // Reads a big-endian unsigned integer of the specified size.
+        uint64_t take_be(size_t size)
+        {
+            const byte* bytes = take(size);
+            uint64_t value = 0;
+            for (size_t i = 0; i < size; i++) {
+                value = (value << 8) | bytes[i];
+            }
+            return value;
+        }
+
+        size_t offset() const noexcept
+        {
+            return static_cast<size_t>(pos_ - begin_);
+        }
+
+        size_t remaining() const noexcept
+        {
+            return static_cast<size_t>(end_ - pos_);
+        }
+
+    private:
+        const byte* begin_;
+        const byte* pos_;
+        const byte* end_;
+    };
+
+    // Reinterprets the low size bytes of value as a two's complement integer.
+    constexpr uint64_t sign_extend(uint64_t value, size_t size) noexcept
+    {
+        unsigned shift = static_cast<unsigned>(64 - 8 * size);
+        return static_cast<uint64_t>(static_cast<int64_t>(value << shift) >> shift);
+    }
+
+    /**
+     * The MessagePack format (https://github.com/msgpack/msgpack/blob/master/spec.md).
+     * The encoding functions write the header of an item to out and return its size (at most 9 bytes).
+     */
+    struct msgpack
+    {
+        static constexpr size_t nil(byte* out) noexcept
+        {
+            out[0] = 0xc0;
+            return 1;
+        }
+
+        static constexpr size_t boolean(byte* out, bool value) noexcept
+        {
+            out[0] = value ? 0xc3 : 0xc2;
+            return 1;
+        }
+
+        static constexpr size_t uint(byte* out, uint64_t value) noexcept
+        {
+            if (value < 0x80) {
+                // positive fixint
+                out[0] = static_cast<byte>(value);
+                return 1;
+            }
+            if (value <= 0xff) return put_tagged(out, 0xcc, value, 1);
+            if (value <= 0xffff) return put_tagged(out, 0xcd, value, 2);
+            if (value <= 0xffffffff) return put_tagged(out, 0xce, value, 4);
+            return put_tagged(out, 0xcf, value, 8);
+        }
+
+        static constexpr size_t sint(byte* out, int64_t value) noexcept
+        {
+            if (value >= 0) return uint(out, static_cast<uint64_t>(value));
+            if (value >= -32) {
+                // negative fixint
+                out[0] = static_cast<byte>(value);
+                return 1;
+            }
+            if (value >= std::numeric_limits<int8_t>::min()) return put_tagged(out, 0xd0, static_cast<uint64_t>(value), 1);
+            if (value >= std::numeric_limits<int16_t>::min()) return put_tagged(out, 0xd1, static_cast<uint64_t>(value), 2);
+            if (value >= std::numeric_limits<int32_t>::min()) return put_tagged(out, 0xd2, static_cast<uint64_t>(value), 4);
+            return put_tagged(out, 0xd3, static_cast<uint64_t>(value), 8);
+        }
+
+        static size_t float32(byte* out, float value) noexcept
+        {
+            return put_tagged(out, 0xca, float_bits(value), 4);
+        }
+
+        static size_t float64(byte* out, double value) noexcept
+        {
+            return put_tagged(out, 0xcb, double_bits(value), 8);
+        }
+
+        static constexpr size_t string_header(byte* out, size_t size) noexcept
+        {
+            if (size < 32) {
+                // fixstr
+                out[0] = static_cast<byte>(0xa0 | size);
+                return 1;
+            }
+            if (size <= 0xff) return put_tagged(out, 0xd9, size, 1);
+            if (size <= 0xffff) return put_tagged(out, 0xda, size, 2);
+            return put_tagged(out, 0xdb, size, 4);
+        }
+
+        static constexpr size_t array_header(byte* out, size_t size) noexcept
+        {
+            if (size < 16) {
+                out[0] = static_cast<byte>(0x90 | size);
+                return 1;
+            }
+            if (size <= 0xffff) return put_tagged(out, 0xdc, size, 2);
+            return put_tagged(out, 0xdd, size, 4);
+        }
+
+        static constexpr size_t map_header(byte* out, size_t size) noexcept
+        {
+            if (size < 16) {
+                out[0] = static_cast<byte>(0x80 | size);
+                return 1;
+            }
+            if (size <= 0xffff) return put_tagged(out, 0xde, size, 2);
+            return put_tagged(out, 0xdf, size, 4);
+        }
+
+        static item next(reader& in)
+        {
+            byte tag = *in.take(1);
+            if (tag < 0x80) return { item_kind::uint, tag, 0 };
+            if (tag >= 0xe0) return { item_kind::sint, sign_extend(tag, 1), 0 };
+            if (tag < 0x90) return { item_kind::map, tag & 0x0fu, 0 };
+            if (tag < 0xa0) return { item_kind::array, tag & 0x0fu, 0 };
+            if (tag < 0xc0) return { item_kind::string, tag & 0x1fu, 0 };
+
+            switch (tag) {
+            case 0xc0: return { item_kind::nil, 0, 0 };
+            case 0xc2: return { item_kind::boolean, 0, 0 };
+            case 0xc3: return { item_kind::boolean, 1, 0 };
+            case 0xc4: return { item_kind::binary, in.take_be(1), 0 };
+            case 0xc5: return { item_kind::binary, in.take_be(2), 0 };
+            case 0xc6: return { item_kind::binary, in.take_be(4), 0 };
+            case 0xca: return { item_kind::floating, 0, float_from_bits(in.take_be(4)) };
+            case 0xcb: return { item_kind::floating, 0, double_from_bits(in.take_be(8)) };
+            case 0xcc: return { item_kind::uint, in.take_be(1), 0 };
+            case 0xcd: return { item_kind::uint, in.take_be(2), 0 };
+            case 0xce: return { item_kind::uint, in.take_be(4), 0 };
+            case 0xcf: return { item_kind::uint, in.take_be(8), 0 };
+            case 0xd0: return { item_kind::sint, sign_extend(in.take_be(1), 1), 0 };
+            case 0xd1: return { item_kind::sint, sign_extend(in.take_be(2), 2), 0 };
+            case 0xd2: return { item_kind::sint, sign_extend(in.take_be(4), 4), 0 };
+            case 0xd3: return { item_kind::sint, in.take_be(8), 0 };
+            case 0xd9: return { item_kind::string, in.take_be(1), 0 };
+            case 0xda: return { item_kind::string, in.take_be(2), 0 };
+            case 0xdb: return { item_kind::string, in.take_be(4), 0 };
+            case 0xdc: return { item_kind::array, in.take_be(2), 0 };
+            case 0xdd: return { item_kind::array, in.take_be(4), 0 };
+            case 0xde: return { item_kind::map, in.take_be(2), 0 };
+            case 0xdf: return { item_kind::map, in.take_be(4), 0 };
+            default: in.fail("unsupported MessagePack type");
+            }
+        }
+    };
+
+    /**
+     * The CBOR format (RFC 8949), without indefinite-length items.
+     * The encoding functions write the header of an item to out and return its size (at most 9 bytes).
+     */
+    struct cbor
+    {
+        // The initial byte (major type and additional information) followed by the argument.
+        static constexpr size_t head(byte* out, byte major, uint64_t argument) noexcept
+        {
+            byte type = static_cast<byte>(major << 5);
+            if (argument < 24) {
+                out[0] = static_cast<byte>(type | argument);
+                return 1;
+            }
+            if (argument <= 0xff) return put_tagged(out, type | 24, argument, 1);
+            if (argument <= 0xffff) return put_tagged(out, type | 25, argument, 2);
+            if (argument <= 0xffffffff) return put_tagged(out, type | 26, argument, 4);
+            return put_tagged(out, type | 27, argument, 8);
+        }
+
+        static constexpr size_t nil(byte* out) noexcept
+        {
+            out[0] = 0xf6;
+            return 1;
+        }
+
+        static constexpr size_t boolean(byte* out, bool value) noexcept
+        {
+            out[0] = value ? 0xf5 : 0xf4;
+            return 1;
+        }
+
+        static constexpr size_t uint(byte* out, uint64_t value) noexcept
+        {
+            return head(out, 0, value);
+        }
+
+        static constexpr size_t sint(byte* out, int64_t value) noexcept
+        {
+            // negative integers are encoded as -1 - value
+            return value >= 0 ? head(out, 0, static_cast<uint64_t>(value)) : head(out, 1, static_cast<uint64_t>(-1 - value));
+        }
+
+        static size_t float32(byte* out, float value) noexcept
+        {
+            return put_tagged(out, 0xfa, float_bits(value), 4);
+        }
+
+        static size_t float64(byte* out, double value) noexcept
+        {
+            return put_tagged(out, 0xfb, double_bits(value), 8);
+        }
+
+        static constexpr size_t string_header(byte* out, size_t size) noexcept
+        {
+            return head(out, 3, size);
+        }
+
+        static constexpr size_t array_header(byte* out, size_t size) noexcept
+        {
+            return head(out, 4, size);
+        }
+
+        static constexpr size_t map_header(byte* out, size_t size) noexcept
+        {
+            return head(out, 5, size);
+        }
+
+        static double half_to_double(uint64_t half) noexcept
+        {
+            int exponent = static_cast<int>((half >> 10) & 0x1f);
+            int mantissa = static_cast<int>(half & 0x3ff);
+            double value;
+            if (exponent == 0) value = std::ldexp(mantissa, -24);
+            else if (exponent != 31) value = std::ldexp(mantissa + 1024, exponent - 25);
+            else value = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+            return half & 0x8000 ? -value : value;
+        }
+
+        static item next(reader& in)
+        {
+            // tags carry no information needed here, so they are skipped and the tagged item is returned instead
+            byte initial = *in.take(1);
+            while ((initial >> 5) == 6) {
+                byte info = initial & 0x1f;
+                if (info >= 24) {
+                    if (info > 27) in.fail("invalid CBOR argument");
+                    in.take(size_t(1) << (info - 24));
+                }
+                initial = *in.take(1);
+            }
+            byte major = initial >> 5;
+            byte info = initial & 0x1f;
+
+            if (major == 7) {
+                switch (initial) {
+                case 0xf4: return { item_kind::boolean, 0, 0 };
+                case 0xf5: return { item_kind::boolean, 1, 0 };
+                // null and undefined
+                case 0xf6: case 0xf7: return { item_kind::nil, 0, 0 };
+                case 0xf9: return { item_kind::floating, 0, half_to_double(in.take_be(2)) };
+                case 0xfa: return { item_kind::floating, 0, float_from_bits(in.take_be(4)) };
+                case 0xfb: return { item_kind::floating, 0, double_from_bits(in.take_be(8)) };
+                default: in.fail("unsupported CBOR simple value");
+                }
+            }
+
+            uint64_t argument = info;
+            if (info >= 24) {
+                if (info > 27) in.fail(info == 31 ? "indefinite-length items are not supported" : "invalid CBOR argument");
+                argument = in.take_be(size_t(1) << (info - 24));
+            }
+
+            switch (major) {
+            case 0: return { item_kind::uint, argument, 0 };
+            case 1:
+                if (argument > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) in.fail("integer out of range");
+                return { item_kind::sint, static_cast<uint64_t>(-1 - static_cast<int64_t>(argument)), 0 };
+            case 2: return { item_kind::binary, argument, 0 };
+            case 3: return { item_kind::string, argument, 0 };
+            case 4: return { item_kind::array, argument, 0 };
+            // 5, as tags were skipped above
+            default: return { item_kind::map, argument, 0 };
+            }
+        }
+    };
+
+    template <typename Format>
+    constexpr size_t string_header_size(size_t size) noexcept
+    {
+        byte header[9]{};
+        return Format::string_header(header, size);
+    }
+
+    // The header and characters of a string, encoded at compile-time.
+    template <typename Format, size_t N>
+    constexpr auto encode_string(const refl::util::const_string<N>& str) noexcept
+    {
+        std::array<byte, string_header_size<Format>(N) + N> result{};
+        size_t header = Format::string_header(result.data(), N);
+        for (size_t i = 0; i < N; i++) {
+            result[header + i] = static_cast<byte>(str.data[i]);
+        }
+        return result;
+    }
+
+    template <typename Format, typename Member>
+    static constexpr auto encoded_name = encode_string<Format>(refl::descriptor::get_display_name_const(Member{}));
+
+    template <typename Buffer>
+    void append(Buffer& out, const byte* data, size_t size)
+    {
+        out.insert(out.end(), data, data + size);
+    }
+
+    template <typename Buffer, size_t N>
+    void append(Buffer& out, const std::array<byte, N>& data)
+    {
+        append(out, data.data(), N);
+    }
+
+    template <typename Format, object_mode Mode, typename Buffer, typename T>
+    void write_value(Buffer& out, const T& value);
+
+    template <typename Format, object_mode Mode, typename Buffer, typename T, typename... Members>
+    void write_object(Buffer& out, const T& value, refl::type_list<Members...>)
+    {
+        byte header[9];
+        if constexpr (Mode == object_mode::map) {
+            append(out, header, Format::map_header(header, sizeof...(Members)));
+            ((append(out, encoded_name<Format, Members>), write_value<Format, Mode>(out, Members{}(value))), ...);
+        }
+        else {
+            append(out, header, Format::array_header(header, sizeof...(Members)));
+            (write_value<Format, Mode>(out, Members{}(value)), ...);
+        }
+    }
+
+    template <typename Format, object_mode Mode, typename Buffer, typename T>
+    void write_value(Buffer& out, const T& value)
+    {
+        byte header[9];
+        if constexpr (std::is_same_v<T, bool>) {
+            append(out, header, Format::boolean(header, value));
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            append(out, header, Format::sint(header, static_cast<int64_t>(value)));
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            append(out, header, Format::uint(header, static_cast<uint64_t>(value)));
+        }
+        else if constexpr (std::is_same_v<T, float>) {
+            append(out, header, Format::float32(header, value));
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            append(out, header, Format::float64(header, static_cast<double>(value)));
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            write_value<Format, Mode>(out, static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (is_string_like<T>::value) {
+            std::string_view str(value);
+            append(out, header, Format::string_header(header, str.size()));
+            append(out, reinterpret_cast<const byte*>(str.data()), str.size());
+        }
+        else if constexpr (is_optional<T>::value) {
+            if (value) write_value<Format, Mode>(out, *value);
+            else append(out, header, Format::nil(header));
+        }
+        else if constexpr (is_key_value_container<T>::value) {
+            append(out, header, Format::map_header(header, value.size()));
+            for (const auto& [key, element] : value) {
+                write_value<Format, Mode>(out, key);
+                write_value<Format, Mode>(out, element);
+            }
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            append(out, header, Format::array_header(header, value.size()));
+            for (const auto& element : value) {
+                write_value<Format, Mode>(out, element);
+            }
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by the MessagePack/CBOR encoders!");
+            write_object<Format, Mode>(out, value, members<T>);
+        }
+    }
+
+    /**
+     * Skips the next value. Nested values are counted instead of recursed into,
+     * so that deeply nested input cannot exhaust the stack.
+     */
+    template <typename Format>
+    void skip(reader& in)
+    {
+        // the number of items left to skip (a map entry is two items)
+        uint64_t pending = 1;
+        while (pending != 0) {
+            pending--;
+            item token = Format::next(in);
+            switch (token.kind) {
+            case item_kind::string:
+            case item_kind::binary:
+                in.take(token.value);
+                break;
+            case item_kind::array:
+            case item_kind::map:
+            {
+                // every item takes at least one byte, which also keeps pending from overflowing
+                uint64_t items = token.kind == item_kind::map ? 2 * token.value : token.value;
+                if (token.value > in.remaining() || items > in.remaining() || pending > in.remaining() - items) {
+                    in.fail("unexpected end of input");
+                }
+                pending += items;
+                break;
+            }
+            default:
+                break;
+            }
+        }
+    }
+
+    template <typename Format>
+    item expect(reader& in, item_kind kind, const char* message)
+    {
+        item token = Format::next(in);
+        if (token.kind != kind) {
+            in.fail(message);
+        }
+        return token;
+    }
+
+    template <typename T>
+    T to_integer(reader& in, const item& token)
+    {
+        if (token.kind == item_kind::uint) {
+            if (token.value > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+                in.fail("integer out of range");
+            }
+            return static_cast<T>(token.value);
+        }
+        if (token.kind != item_kind::sint) {
+            in.fail("expected an integer");
+        }
+
+        int64_t value = static_cast<int64_t>(token.value);
+        if constexpr (std::is_unsigned_v<T>) {
+            if (value < 0 || static_cast<uint64_t>(value) > std::numeric_limits<T>::max()) {
+                in.fail("integer out of range");
+            }
+        }
+        else {
+            if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) {
+                in.fail("integer out of range");
+            }
+        }
+        return static_cast<T>(value);
+    }
+
+    template <typename Format, typename T>
+    void read_value(reader& in, T& value);
+
+    template <typename Format, typename T, typename Member>
+    void read_member(reader& in, T& target, Member member)
+    {
+        if constexpr (refl::descriptor::is_field(member) && refl::descriptor::is_writable(member)) {
+            read_value<Format>(in, member(target));
+        }
+        else if constexpr (refl::descriptor::is_function(member) && refl::descriptor::has_writer(member)) {
+            refl::trait::remove_qualifiers_t<decltype(member(target))> value{};
+            read_value<Format>(in, value);
+            constexpr auto writer = refl::descriptor::get_writer(member);
+            writer(target, std::move(value));
+        }
+        else {
+            // read-only members
+            skip<Format>(in);
+        }
+    }
+
+    template <typename Format, typename T>
+    void read_object(reader& in, T& value)
+    {
+        item token = Format::next(in);
+        if (token.kind == item_kind::map) {
+            for (uint64_t i = 0; i < token.value; i++) {
+                item key = expect<Format>(in, item_kind::string, "expected a string key");
+                std::string_view name(reinterpret_cast<const char*>(in.take(key.value)), key.value);
+                bool found = false;
+                for_each(members<T>, [&](auto member) {
+                    if (!found && get_display_name_view(member) == name) {
+                        read_member<Format>(in, value, member);
+                        found = true;
+                    }
+                });
+                if (!found) {
+                    skip<Format>(in);
+                }
+            }
+        }
+        else if (token.kind == item_kind::array) {
+            for_each(members<T>, [&](auto member, size_t index) {
+                if (index < token.value) {
+                    read_member<Format>(in, value, member);
+                }
+            });
+            for (uint64_t i = members<T>.size; i < token.value; i++) {
+                skip<Format>(in);
+            }
+        }
+        else {
+            in.fail("expected a map or an array");
+        }
+    }
+
+    template <typename Format, typename T>
+    void read_value(reader& in, T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            value = expect<Format>(in, item_kind::boolean, "expected a boolean").value != 0;
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            value = to_integer<T>(in, Format::next(in));
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            item token = Format::next(in);
+            if (token.kind == item_kind::floating) value = static_cast<T>(token.number);
+            else if (token.kind == item_kind::uint) value = static_cast<T>(token.value);
+            else if (token.kind == item_kind::sint) value = static_cast<T>(static_cast<int64_t>(token.value));
+            else in.fail("expected a number");
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            value = static_cast<T>(to_integer<std::underlying_type_t<T>>(in, Format::next(in)));
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            item token = expect<Format>(in, item_kind::string, "expected a string");
+            value.assign(reinterpret_cast<const char*>(in.take(token.value)), token.value);
+        }
+        else if constexpr (is_optional<T>::value) {
+            reader lookahead = in;
+            if (Format::next(lookahead).kind == item_kind::nil) {
+                in = lookahead;
+                value.reset();
+            }
+            else {
+                if (!value) value.emplace();
+                read_value<Format>(in, *value);
+            }
+        }
+        else if constexpr (is_key_value_container<T>::value) {
+            item token = expect<Format>(in, item_kind::map, "expected a map");
+            value.clear();
+            for (uint64_t i = 0; i < token.value; i++) {
+                typename T::key_type key{};
+                typename T::mapped_type element{};
+                read_value<Format>(in, key);
+                read_value<Format>(in, element);
+                value.emplace(std::move(key), std::move(element));
+            }
+        }
+        else if constexpr (is_std_array<T>::value) {
+            item token = expect<Format>(in, item_kind::array, "expected an array");
+            if (token.value != value.size()) {
+                in.fail("array size mismatch");
+            }
+            for (auto& element : value) {
+                read_value<Format>(in, element);
+            }
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            item token = expect<Format>(in, item_kind::array, "expected an array");
+            value.clear();
+            for (uint64_t i = 0; i < token.value; i++) {
+                read_value<Format>(in, value.emplace_back());
+            }
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by the MessagePack/CBOR decoders!");
+            read_object<Format>(in, value);
+        }
+    }
+
+    template <typename Format, typename T>
+    size_t read(const void* data, size_t size, T& value)
+    {
+        const byte* begin = static_cast<const byte*>(data);
+        reader in(begin, begin + size);
+        read_value<Format>(in, value);
+        return in.offset();
+    }
+}
+
+/**
+ * Appends the MessagePack representation of value to out
+ * (a std::vector<unsigned char> or any other container of bytes with insert(end, first, last)).
+ * Reflected types are written as maps (object_mode::map) or as arrays (object_mode::array).
+ */
+template <object_mode Mode = object_mode::map, typename T, typename Buffer>
+void write_msgpack(const T& value, Buffer& out)
+{
+    msgpack_cbor_detail::write_value<msgpack_cbor_detail::msgpack, Mode>(out, value);
+}
+
+/**
+ * Reads a MessagePack value from data into value and returns the number of bytes read.
+ * Throws std::runtime_error on invalid or truncated input.
+ */
+template <typename T>
+size_t read_msgpack(const void* data, size_t size, T& value)
+{
+    return msgpack_cbor_detail::read<msgpack_cbor_detail::msgpack>(data, size, value);
+}
+
+/**
+ * Appends the CBOR representation of value to out
+ * (a std::vector<unsigned char> or any other container of bytes with insert(end, first, last)).
+ * Reflected types are written as maps (object_mode::map) or as arrays (object_mode::array).
+ */
+template <object_mode Mode = object_mode::map, typename T, typename Buffer>
+void write_cbor(const T& value, Buffer& out)
+{
+    msgpack_cbor_detail::write_value<msgpack_cbor_detail::cbor, Mode>(out, value);
+}
+
+/**
+ * Reads a CBOR value from data into value and returns the number of bytes read.
+ * Throws std::runtime_error on invalid or truncated input.
+ */
+template <typename T>
+size_t read_cbor(const void* data, size_t size, T& value)
+{
+    return msgpack_cbor_detail::read<msgpack_cbor_detail::cbor>(data, size, value);
+}
+
+#endif // REFL_EXAMPLES_MSGPACK_CBOR_HPP
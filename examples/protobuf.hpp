@@ -0,0 +1,599 @@
+/**
+ * ***README***
+ * An encoder and decoder of the Protocol Buffers wire format for reflected types.
+ * Used by example-protobuf.cpp and bench/bench-protobuf-packed.cpp.
+ *
+ * Fields are numbered with the tag attribute and map to proto3 fields as follows:
+ *   - bool, enums, integers: bool, enum, int32/int64 (two's complement varints) and uint32/uint64;
+ *     the protobuf::zigzag attribute selects sint32/sint64 and protobuf::fixed selects
+ *     fixed32/fixed64/sfixed32/sfixed64
+ *   - float and double: float and double
+ *   - std::string: string (or bytes)
+ *   - reflected types: embedded messages
+ *   - std::optional<T>: optional T (written whenever it has a value)
+ *   - std::vector<T>: repeated T, packed for numeric types; the attributes apply to the elements
+ *   - std::map<K, V>: map<K, V>
+ * As in proto3, scalars with the default value and empty strings and containers are not written.
+ *
+ * Packed fields are encoded and decoded in blocks of 8 elements: when all of them fit into
+ * a single byte, which is checked with one OR over the block (or one 64-bit load and mask when
+ * decoding), the block is converted with a simple loop which the compiler vectorizes.
+ *
+ * decode_protobuf(data, size, value) has the semantics of ParseFromArray: the tagged fields of
+ * value are reset first (keeping the capacity of strings and containers), unknown fields are
+ * skipped, repeated fields accept both packed and unpacked data, and integers are truncated to
+ * the size of their field. It uses the varint reader and the jump table layout of tagged-binary.hpp.
+ */
+#ifndef REFL_EXAMPLES_PROTOBUF_HPP
+#define REFL_EXAMPLES_PROTOBUF_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "refl.hpp"
+#include "tagged-binary.hpp"
+
+namespace protobuf
+{
+    /** Encodes a signed integer field (or the elements of a repeated field) as sint32/sint64. */
+    struct zigzag : refl::attr::usage::field
+    {
+    };
+
+    /** Encodes an integer field (or the elements of a repeated field) as fixed32/fixed64 or sfixed32/sfixed64. */
+    struct fixed : refl::attr::usage::field
+    {
+    };
+}
+
+namespace protobuf_detail
+{
+    using tagged_detail::byte;
+    using tagged_detail::reader;
+    using tagged_detail::wire_type;
+    using tagged_detail::is_optional;
+    using tagged_detail::is_key_value_container;
+    using tagged_detail::fields;
+    using tagged_detail::fields_t;
+
+    enum class encoding
+    {
+        varint,
+        zigzag,
+        fixed
+    };
+
+    template <typename Member>
+    constexpr encoding encoding_of() noexcept
+    {
+        if constexpr (refl::descriptor::has_attribute<protobuf::zigzag>(Member{})) {
+            return encoding::zigzag;
+        }
+        else if constexpr (refl::descriptor::has_attribute<protobuf::fixed>(Member{})) {
+            return encoding::fixed;
+        }
+        else {
+            return encoding::varint;
+        }
+    }
+
+    template <typename T>
+    static constexpr bool is_scalar_v = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+    template <typename T>
+    static constexpr bool is_string_v = std::is_convertible_v<const T&, std::string_view>;
+
+    template <typename T, encoding E>
+    constexpr wire_type scalar_wire_type() noexcept
+    {
+        if constexpr (std::is_floating_point_v<T> || E == encoding::fixed) {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Fixed-size fields must have 4 or 8 bytes!");
+            return sizeof(T) == 4 ? tagged_detail::fixed32 : tagged_detail::fixed64;
+        }
+        else {
+            return tagged_detail::varint;
+        }
+    }
+
+    // The wire type of a single value of type T (the elements of packed fields are handled separately).
+    template <typename T, encoding E>
+    constexpr wire_type value_wire_type() noexcept
+    {
+        if constexpr (is_scalar_v<T>) {
+            return scalar_wire_type<T, E>();
+        }
+        else {
+            return tagged_detail::length_delimited;
+        }
+    }
+
+    template <uint32_t Tag, wire_type Type>
+    static constexpr tagged_detail::encoded_key key = tagged_detail::make_key(Tag, Type);
+
+    template <typename T, encoding E>
+    constexpr uint64_t to_varint(T value) noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return value ? 1 : 0;
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            return to_varint<std::underlying_type_t<T>, E>(static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (E == encoding::zigzag) {
+            static_assert(std::is_signed_v<T>, "protobuf::zigzag can only be used with signed integers!");
+            return tagged_detail::zigzag(static_cast<int64_t>(value));
+        }
+        else if constexpr (std::is_signed_v<T>) {
+            // negative int32 values are sign-extended to 64 bits
+            return static_cast<uint64_t>(static_cast<int64_t>(value));
+        }
+        else {
+            return static_cast<uint64_t>(value);
+        }
+    }
+
+    template <typename T, encoding E>
+    constexpr T from_varint(uint64_t value) noexcept
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return value != 0;
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            return static_cast<T>(from_varint<std::underlying_type_t<T>, E>(value));
+        }
+        else if constexpr (E == encoding::zigzag) {
+            return static_cast<T>(tagged_detail::unzigzag(value));
+        }
+        else {
+            return static_cast<T>(value);
+        }
+    }
+
+    template <typename T>
+    uint64_t to_fixed(T value) noexcept
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+        else {
+            return static_cast<std::make_unsigned_t<T>>(value);
+        }
+    }
+
+    template <typename T>
+    T from_fixed(uint64_t bits) noexcept
+    {
+        if constexpr (std::is_floating_point_v<T>) {
+            std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t> narrow = static_cast<decltype(narrow)>(bits);
+            T value;
+            std::memcpy(&value, &narrow, sizeof(value));
+            return value;
+        }
+        else {
+            return static_cast<T>(bits);
+        }
+    }
+
+    template <typename T, encoding E, typename Buffer>
+    void write_scalar(Buffer& out, T value)
+    {
+        if constexpr (scalar_wire_type<T, E>() == tagged_detail::varint) {
+            tagged_detail::write_varint(out, to_varint<T, E>(value));
+        }
+        else {
+            tagged_detail::write_fixed(out, to_fixed(value), sizeof(T));
+        }
+    }
+
+    template <typename T, encoding E>
+    T read_scalar(reader& in)
+    {
+        if constexpr (scalar_wire_type<T, E>() == tagged_detail::varint) {
+            return from_varint<T, E>(in.read_varint());
+        }
+        else {
+            return from_fixed<T>(in.read_fixed(sizeof(T)));
+        }
+    }
+
+    constexpr size_t varint_size(uint64_t value) noexcept
+    {
+        // branch-free, so that the loop in packed_size can be vectorized
+        size_t size = 1;
+        for (unsigned bits = 7; bits < 64; bits += 7) {
+            size += value >= (uint64_t(1) << bits);
+        }
+        return size;
+    }
+
+    template <typename T, encoding E>
+    size_t packed_size(const std::vector<T>& values) noexcept
+    {
+        if constexpr (scalar_wire_type<T, E>() != tagged_detail::varint) {
+            return values.size() * sizeof(T);
+        }
+        else {
+            size_t size = 0;
+            for (const T& value : values) {
+                size += varint_size(to_varint<T, E>(value));
+            }
+            return size;
+        }
+    }
+
+    // The payload of a packed repeated field, without its key.
+    template <typename T, encoding E, typename Buffer>
+    void write_packed(Buffer& out, const std::vector<T>& values)
+    {
+        tagged_detail::write_varint(out, packed_size<T, E>(values));
+
+        constexpr size_t block_size = 8;
+        size_t i = 0;
+        for (; i + block_size <= values.size(); i += block_size) {
+            byte block[block_size * 10];
+            size_t size = 0;
+            if constexpr (scalar_wire_type<T, E>() != tagged_detail::varint) {
+                for (size_t j = 0; j < block_size; j++) {
+                    uint64_t bits = to_fixed(values[i + j]);
+                    for (size_t k = 0; k < sizeof(T); k++) {
+                        block[size++] = static_cast<byte>(bits >> (8 * k));
+                    }
+                }
+            }
+            else {
+                uint64_t wire[block_size];
+                uint64_t any = 0;
+                for (size_t j = 0; j < block_size; j++) {
+                    wire[j] = to_varint<T, E>(values[i + j]);
+                    any |= wire[j];
+                }
+                if (any < 0x80) {
+                    // all elements are single-byte varints
+                    for (size_t j = 0; j < block_size; j++) {
+                        block[j] = static_cast<byte>(wire[j]);
+                    }
+                    size = block_size;
+                }
+                else {
+                    for (size_t j = 0; j < block_size; j++) {
+                        size += tagged_detail::encode_varint(block + size, wire[j]);
+                    }
+                }
+            }
+            tagged_detail::append(out, block, size);
+        }
+        for (; i < values.size(); i++) {
+            write_scalar<T, E>(out, values[i]);
+        }
+    }
+
+    // The payload of a packed repeated field, appended to values.
+    template <typename T, encoding E>
+    void read_packed(reader& in, std::vector<T>& values)
+    {
+        reader contents = in.read_delimited();
+        const size_t size = contents.remaining();
+
+        if constexpr (std::is_same_v<T, bool> || scalar_wire_type<T, E>() != tagged_detail::varint) {
+            if constexpr (scalar_wire_type<T, E>() != tagged_detail::varint) {
+                if (size % sizeof(T) != 0) {
+                    contents.fail("invalid size of a packed field");
+                }
+                values.reserve(values.size() + size / sizeof(T));
+            }
+            while (!contents.at_end()) {
+                values.push_back(read_scalar<T, E>(contents));
+            }
+        }
+        else {
+            // every varint ends with its only byte which does not have the continuation bit,
+            // so once the last byte is one, no varint can run past the end of the field
+            const byte* pos = contents.peek(size);
+            const byte* end = pos + size;
+            size_t count = 0;
+            for (size_t i = 0; i < size; i++) {
+                count += pos[i] < 0x80;
+            }
+            if (size != 0 && end[-1] >= 0x80) {
+                contents.fail("unexpected end of input");
+            }
+
+            size_t first = values.size();
+            values.resize(first + count);
+            T* out = values.data() + first;
+            size_t i = 0;
+            while (i < count) {
+                if (end - pos >= 8) {
+                    uint64_t word;
+                    std::memcpy(&word, pos, sizeof(word));
+                    if ((word & 0x8080808080808080ull) == 0) {
+                        // 8 single-byte varints
+                        for (size_t j = 0; j < 8; j++) {
+                            out[i + j] = from_varint<T, E>(pos[j]);
+                        }
+                        pos += 8;
+                        i += 8;
+                        continue;
+                    }
+                }
+                // decode the next 8 elements one at a time before looking for a block again
+                size_t last = std::min(count, i + 8);
+                for (; i < last; i++) {
+                    uint64_t value = 0;
+                    unsigned shift = 0;
+                    byte next;
+                    do {
+                        if (shift >= 64) {
+                            contents.fail("varint is too long");
+                        }
+                        next = *pos++;
+                        value |= static_cast<uint64_t>(next & 0x7f) << shift;
+                        shift += 7;
+                    } while (next >= 0x80);
+                    out[i] = from_varint<T, E>(value);
+                }
+            }
+        }
+    }
+
+    template <typename Buffer, typename T>
+    void write_message(Buffer& out, const T& value);
+
+    // Writes the key and the value of a (non-repeated) field, even when the value is the default.
+    template <uint32_t Tag, encoding E, typename Buffer, typename T>
+    void write_present(Buffer& out, const T& value)
+    {
+        constexpr auto field_key = key<Tag, value_wire_type<T, E>()>;
+        tagged_detail::append(out, field_key.bytes.data(), field_key.size);
+        if constexpr (is_scalar_v<T>) {
+            write_scalar<T, E>(out, value);
+        }
+        else if constexpr (is_string_v<T>) {
+            std::string_view str(value);
+            tagged_detail::write_varint(out, str.size());
+            tagged_detail::append(out, reinterpret_cast<const byte*>(str.data()), str.size());
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by encode_protobuf!");
+            tagged_detail::write_delimited(out, [&] { protobuf_detail::write_message(out, value); });
+        }
+    }
+
+    template <uint32_t Tag, encoding E, typename Buffer, typename T>
+    void write_field(Buffer& out, const T& value)
+    {
+        if constexpr (is_optional<T>::value) {
+            if (value) {
+                write_present<Tag, E>(out, *value);
+            }
+        }
+        else if constexpr (is_scalar_v<T>) {
+            if (value != T{}) {
+                write_present<Tag, E>(out, value);
+            }
+        }
+        else if constexpr (is_string_v<T>) {
+            if (!std::string_view(value).empty()) {
+                write_present<Tag, E>(out, value);
+            }
+        }
+        else if constexpr (is_key_value_container<T>::value) {
+            // map entries are messages with the key in field 1 and the value in field 2
+            constexpr auto entry_key = key<Tag, tagged_detail::length_delimited>;
+            for (const auto& [entry_key_value, entry_value] : value) {
+                tagged_detail::append(out, entry_key.bytes.data(), entry_key.size);
+                tagged_detail::write_delimited(out, [&] {
+                    write_present<1, encoding::varint>(out, entry_key_value);
+                    write_present<2, encoding::varint>(out, entry_value);
+                });
+            }
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            using element_type = typename T::value_type;
+            if constexpr (is_scalar_v<element_type>) {
+                if (!value.empty()) {
+                    constexpr auto packed_key = key<Tag, tagged_detail::length_delimited>;
+                    tagged_detail::append(out, packed_key.bytes.data(), packed_key.size);
+                    write_packed<element_type, E>(out, value);
+                }
+            }
+            else {
+                for (const auto& element : value) {
+                    write_present<Tag, E>(out, element);
+                }
+            }
+        }
+        else {
+            write_present<Tag, E>(out, value);
+        }
+    }
+
+    template <typename Buffer, typename T>
+    void write_message(Buffer& out, const T& value)
+    {
+        static_assert(tagged_detail::are_valid_tags(tagged_detail::tags<T>), "Tags must be unique and between 1 and 65536!");
+        for_each(fields<T>, [&](auto member) {
+            using member_type = decltype(member);
+            write_field<refl::descriptor::get_tag(member_type{}), encoding_of<member_type>()>(out, member(value));
+        });
+    }
+
+    template <typename T>
+    void read_message(reader& in, T& value);
+
+    template <encoding E, typename T>
+    void read_field_value(reader& in, T& value, uint64_t type)
+    {
+        if constexpr (is_optional<T>::value) {
+            if (type != value_wire_type<typename T::value_type, E>()) {
+                tagged_detail::skip(in, type);
+                return;
+            }
+            if (!value) value.emplace();
+            read_field_value<E>(in, *value, type);
+        }
+        else if constexpr (is_scalar_v<T>) {
+            if (type != scalar_wire_type<T, E>()) {
+                tagged_detail::skip(in, type);
+                return;
+            }
+            value = read_scalar<T, E>(in);
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            if (type != tagged_detail::length_delimited) {
+                tagged_detail::skip(in, type);
+                return;
+            }
+            uint64_t size = in.read_varint();
+            value.assign(reinterpret_cast<const char*>(in.take(size)), size);
+        }
+        else if constexpr (is_key_value_container<T>::value) {
+            if (type != tagged_detail::length_delimited) {
+                tagged_detail::skip(in, type);
+                return;
+            }
+            reader entry = in.read_delimited();
+            typename T::key_type entry_key{};
+            typename T::mapped_type entry_value{};
+            while (!entry.at_end()) {
+                uint64_t entry_field = entry.read_varint();
+                if ((entry_field >> 3) == 1) read_field_value<encoding::varint>(entry, entry_key, entry_field & 7);
+                else if ((entry_field >> 3) == 2) read_field_value<encoding::varint>(entry, entry_value, entry_field & 7);
+                else tagged_detail::skip(entry, entry_field & 7);
+            }
+            value.insert_or_assign(std::move(entry_key), std::move(entry_value));
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            using element_type = typename T::value_type;
+            if constexpr (is_scalar_v<element_type>) {
+                if (type == tagged_detail::length_delimited) {
+                    read_packed<element_type, E>(in, value);
+                }
+                else if (type == scalar_wire_type<element_type, E>()) {
+                    // parsers must accept unpacked repeated fields too
+                    value.push_back(read_scalar<element_type, E>(in));
+                }
+                else {
+                    tagged_detail::skip(in, type);
+                }
+            }
+            else if (type == tagged_detail::length_delimited) {
+                read_field_value<E>(in, value.emplace_back(), type);
+            }
+            else {
+                tagged_detail::skip(in, type);
+            }
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by decode_protobuf!");
+            if (type != tagged_detail::length_delimited) {
+                tagged_detail::skip(in, type);
+                return;
+            }
+            // embedded messages which appear more than once are merged
+            reader contents = in.read_delimited();
+            protobuf_detail::read_message(contents, value);
+        }
+    }
+
+    template <typename T, size_t I>
+    void read_field(reader& in, T& value, uint64_t type)
+    {
+        using member = refl::trait::get_t<I, fields_t<T>>;
+        read_field_value<encoding_of<member>()>(in, member{}(value), type);
+    }
+
+    /** The dense jump table of the decoder of T, indexed by field number. */
+    template <typename T>
+    struct field_table
+    {
+        static_assert(tagged_detail::are_valid_tags(tagged_detail::tags<T>), "Tags must be unique and between 1 and 65536!");
+
+        using reader_type = void (*)(reader&, T&, uint64_t);
+
+        static constexpr size_t size = tagged_detail::largest_tag(tagged_detail::tags<T>) + 1;
+
+        template <size_t... I>
+        static constexpr std::array<reader_type, size> make(std::index_sequence<I...>) noexcept
+        {
+            std::array<reader_type, size> table{};
+            ((table[tagged_detail::tags<T>[I]] = &read_field<T, I>), ...);
+            return table;
+        }
+
+        static constexpr std::array<reader_type, size> entries = make(std::make_index_sequence<fields<T>.size>{});
+    };
+
+    template <typename T>
+    void read_message(reader& in, T& value)
+    {
+        const auto& table = field_table<T>::entries;
+        while (!in.at_end()) {
+            uint64_t field_key = in.read_varint();
+            uint64_t tag = field_key >> 3;
+            uint64_t type = field_key & 7;
+            if (tag < table.size() && table[tag] != nullptr) {
+                table[tag](in, value, type);
+            }
+            else {
+                tagged_detail::skip(in, type);
+            }
+        }
+    }
+
+    // Resets the tagged fields to their defaults, without releasing the memory of strings and containers.
+    template <typename T>
+    void reset(T& value)
+    {
+        for_each(fields<T>, [&](auto member) {
+            auto& field = member(value);
+            using field_type = std::remove_reference_t<decltype(field)>;
+            if constexpr (is_scalar_v<field_type> || is_optional<field_type>::value) {
+                field = field_type{};
+            }
+            else if constexpr (refl::trait::is_container_v<field_type>) {
+                field.clear();
+            }
+            else {
+                reset(field);
+            }
+        });
+    }
+}
+
+/**
+ * Appends the Protocol Buffers encoding of the tagged fields of value to out
+ * (a std::vector<unsigned char> or another random-access container of bytes with resize).
+ */
+template <typename T, typename Buffer>
+void encode_protobuf(const T& value, Buffer& out)
+{
+    tagged_detail::output<Buffer> writer(out);
+    protobuf_detail::write_message(writer, value);
+    writer.finish();
+}
+
+/**
+ * Parses a Protocol Buffers message into value, like ParseFromArray: tagged fields
+ * which are not present have their default value afterwards. Throws std::runtime_error
+ * on malformed input.
+ */
+template <typename T>
+void decode_protobuf(const void* data, size_t size, T& value)
+{
+    protobuf_detail::reset(value);
+    const auto* begin = static_cast<const unsigned char*>(data);
+    protobuf_detail::reader in(begin, begin, begin + size);
+    protobuf_detail::read_message(in, value);
+}
+
+#endif // REFL_EXAMPLES_PROTOBUF_HPP
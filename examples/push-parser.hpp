@@ -0,0 +1,330 @@
+/**
+ * ***README***
+ * A resumable (push) decoder of the format of binary-serialization.hpp, for data which arrives
+ * in fragments, e.g. from a non-blocking socket.
+ * Used by example-push-parser.cpp and bench/bench-push-parser-feed.cpp.
+ *
+ * binary_push_parser<T> decodes into a T as bytes are fed to it, one fragment at a time, and
+ * never buffers the message: fixed-size values are copied straight into their destination (possibly
+ * over several fragments), and strings and vectors grow as their contents arrive, so a bogus size
+ * prefix cannot make the parser allocate more than it has received.
+ *
+ * Its state is a stack of frames, one per value which is being decoded (the message, the current
+ * field of each enclosing object and the current element of each enclosing vector). Each frame
+ * holds a pointer to the value, its progress and a step function, which is generated at compile-time
+ * for the type of the value from the descriptors of its fields. Values which have arrived in whole
+ * (which is checked without copying anything) are decoded at once by deserialize_binary, without
+ * frames of their own, so frames are only needed for the values which span fragments.
+ */
+#ifndef REFL_EXAMPLES_PUSH_PARSER_HPP
+#define REFL_EXAMPLES_PUSH_PARSER_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "refl.hpp"
+#include "binary-serialization.hpp"
+
+namespace push_detail
+{
+    using binary_detail::size_type;
+
+    enum class status
+    {
+        // the value is complete
+        done,
+        // the fragment has been consumed
+        need_input,
+        // a frame for a part of the value was pushed
+        pushed
+    };
+
+    struct frame;
+
+    /** The part of the parser which the step functions work with. */
+    struct state
+    {
+        const unsigned char* pos;
+        const unsigned char* end;
+        std::vector<frame> stack;
+    };
+
+    struct frame
+    {
+        status (*step)(state&, frame&);
+        void* target;
+        // the number of elements of a string or vector, once its size prefix has been read
+        size_type count;
+        // the number of bytes (or elements, or fields) of the value which have been decoded
+        size_type progress;
+        bool has_count;
+    };
+
+    template <typename T>
+    status step(state& in, frame& current);
+
+    template <typename T>
+    void push(state& in, T& value)
+    {
+        in.stack.push_back(frame{ &step<T>, &value, 0, 0, false });
+    }
+
+    // Copies the next bytes of a fixed-size value of size bytes, and returns whether it is complete.
+    inline bool copy_bytes(state& in, void* target, size_t size, size_type& progress) noexcept
+    {
+        size_t available = std::min(static_cast<size_t>(in.end - in.pos), size - static_cast<size_t>(progress));
+        std::memcpy(static_cast<unsigned char*>(target) + progress, in.pos, available);
+        in.pos += available;
+        progress += available;
+        return progress == size;
+    }
+
+    // Reads the size prefix of a string or vector (progress counts its bytes until it is complete).
+    inline bool read_count(state& in, frame& current) noexcept
+    {
+        if (current.has_count) {
+            return true;
+        }
+        if (!copy_bytes(in, &current.count, sizeof(size_type), current.progress)) {
+            return false;
+        }
+        current.has_count = true;
+        current.progress = 0;
+        return true;
+    }
+
+    // Moves pos past a serialized T and returns true, or returns false if it does not end before end.
+    template <typename T>
+    bool fits(const unsigned char*& pos, const unsigned char* end) noexcept
+    {
+        size_t available = static_cast<size_t>(end - pos);
+        if constexpr (binary_detail::is_blittable<T>() || std::is_same_v<T, bool>) {
+            // bools are checked when they are read
+            if (available < binary_detail::min_size<T>()) return false;
+            pos += binary_detail::min_size<T>();
+            return true;
+        }
+        else if constexpr (binary_detail::is_string<T>::value || binary_detail::is_vector<T>::value) {
+            using element_type = typename T::value_type;
+            size_type count;
+            if (available < sizeof(count)) return false;
+            std::memcpy(&count, pos, sizeof(count));
+            available -= sizeof(count);
+            constexpr size_t element_size = binary_detail::min_size<element_type>();
+            if (element_size != 0 && count > available / element_size) return false;
+            pos += sizeof(count);
+            if constexpr (binary_detail::is_string<T>::value || binary_detail::is_blittable<element_type>()) {
+                pos += static_cast<size_t>(count) * sizeof(element_type);
+            }
+            else {
+                for (size_type i = 0; i < count; i++) {
+                    if (!fits<element_type>(pos, end)) return false;
+                }
+            }
+            return true;
+        }
+        else if constexpr (binary_detail::is_std_array<T>::value) {
+            for (size_t i = 0; i < std::tuple_size_v<T>; i++) {
+                if (!fits<typename T::value_type>(pos, end)) return false;
+            }
+            return true;
+        }
+        else {
+            return refl::util::accumulate(binary_detail::fields<T>, [&](bool complete, auto member) {
+                return complete && fits<binary_detail::field_type<decltype(member)>>(pos, end);
+            }, true);
+        }
+    }
+
+    // Decodes a value with deserialize_binary when it has arrived in whole.
+    template <typename T>
+    bool try_read(state& in, T& value)
+    {
+        if constexpr ((binary_detail::is_vector<T>::value || binary_detail::is_std_array<T>::value)
+            && !binary_detail::is_blittable<T>() && !binary_detail::is_blittable_vector<T>()) {
+            // the elements are tried one by one instead, so that they are not checked twice
+            return false;
+        }
+        const unsigned char* end = in.pos;
+        if (!fits<T>(end, in.end)) {
+            return false;
+        }
+        binary_detail::reader whole{ in.pos, end };
+        binary_detail::read(whole, value);
+        in.pos = end;
+        return true;
+    }
+
+    // Decodes value at once when possible, or pushes a frame for it.
+    template <typename T>
+    status read_or_push(state& in, T& value)
+    {
+        if (try_read(in, value)) {
+            return status::done;
+        }
+        push(in, value);
+        return status::pushed;
+    }
+
+    template <typename T, size_t I>
+    status read_field(state& in, T& value)
+    {
+        using member = refl::trait::get_t<I, binary_detail::fields_t<T>>;
+        return read_or_push(in, member{}(value));
+    }
+
+    // The functions which decode each field (or push a frame for it), indexed by the position of the field.
+    template <typename T, typename = std::make_index_sequence<binary_detail::fields<T>.size>>
+    struct field_readers;
+
+    template <typename T, size_t... I>
+    struct field_readers<T, std::index_sequence<I...>>
+    {
+        using reader = status (*)(state&, T&);
+        static constexpr reader table[sizeof...(I) > 0 ? sizeof...(I) : 1] = { &read_field<T, I>... };
+    };
+
+    template <typename T>
+    status step(state& in, frame& current)
+    {
+        T& value = *static_cast<T*>(current.target);
+        if constexpr (binary_detail::is_blittable<T>()) {
+            return copy_bytes(in, &value, sizeof(T), current.progress) ? status::done : status::need_input;
+        }
+        else if constexpr (std::is_same_v<T, bool>) {
+            // a single byte, which is validated by deserialize_binary
+            return try_read(in, value) ? status::done : status::need_input;
+        }
+        else if constexpr (binary_detail::is_string<T>::value || binary_detail::is_blittable_vector<T>()) {
+            using element_type = typename T::value_type;
+            if (!current.has_count) {
+                if (!read_count(in, current)) return status::need_input;
+                if (current.count > std::numeric_limits<size_t>::max() / sizeof(element_type)) {
+                    throw std::runtime_error("Invalid size in binary input!");
+                }
+                value.clear();
+            }
+            // the value grows with the bytes which have arrived, up to its size
+            size_t total = static_cast<size_t>(current.count) * sizeof(element_type);
+            size_t available = std::min(static_cast<size_t>(in.end - in.pos), total - static_cast<size_t>(current.progress));
+            size_t received = static_cast<size_t>(current.progress) + available;
+            if (available != 0) {
+                value.resize((received + sizeof(element_type) - 1) / sizeof(element_type));
+                std::memcpy(reinterpret_cast<unsigned char*>(value.data()) + current.progress, in.pos, available);
+                in.pos += available;
+                current.progress = received;
+            }
+            return received == total ? status::done : status::need_input;
+        }
+        else if constexpr (binary_detail::is_vector<T>::value || binary_detail::is_std_array<T>::value) {
+            if constexpr (binary_detail::is_vector<T>::value) {
+                if (!current.has_count) {
+                    if (!read_count(in, current)) return status::need_input;
+                    // existing elements are reused, new ones are added as they arrive
+                    if (value.size() > current.count) {
+                        value.resize(static_cast<size_t>(current.count));
+                    }
+                }
+            }
+            else {
+                current.count = value.size();
+            }
+            while (current.progress < current.count) {
+                size_t index = static_cast<size_t>(current.progress++);
+                if constexpr (binary_detail::is_vector<T>::value) {
+                    if (index == value.size()) value.emplace_back();
+                }
+                // current is invalidated by a push
+                if (read_or_push(in, value[index]) == status::pushed) return status::pushed;
+            }
+            return status::done;
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by binary_push_parser!");
+            static_assert(refl::util::accumulate(binary_detail::fields<T>, [](bool writable, auto member) { return writable && is_writable(member); }, true),
+                "binary_push_parser requires all fields to be writable!");
+            while (current.progress < binary_detail::fields<T>.size) {
+                // current is invalidated by a push
+                if (field_readers<T>::table[current.progress++](in, value) == status::pushed) return status::pushed;
+            }
+            return status::done;
+        }
+    }
+}
+
+/**
+ * Decodes a T written by serialize_binary from fragments of data, as they arrive.
+ * The target must outlive the parser. Existing strings and vectors of the target are reused.
+ *
+ * \code{.cpp}
+ * Message message;
+ * binary_push_parser<Message> parser(message);
+ * while (!parser.done()) {
+ *     size_t size = receive(buffer, sizeof(buffer));
+ *     size_t used = parser.feed(buffer, size);
+ *     // bytes after the end of the message (buffer + used) belong to the next one
+ * }
+ * \endcode
+ */
+template <typename T>
+class binary_push_parser
+{
+public:
+    explicit binary_push_parser(T& target)
+        : target_(&target)
+    {
+        reset();
+    }
+
+    /** Starts decoding a new message into the same target. */
+    void reset()
+    {
+        state_.stack.clear();
+        push_detail::push(state_, *target_);
+    }
+
+    /** Starts decoding a new message into target. */
+    void reset(T& target)
+    {
+        target_ = &target;
+        reset();
+    }
+
+    /** Whether the whole message has been decoded. */
+    bool done() const noexcept
+    {
+        return state_.stack.empty();
+    }
+
+    /**
+     * Decodes the next size bytes at data and returns the number of bytes which were used.
+     * That is less than size only when the message was completed before the end of the fragment.
+     * Throws std::runtime_error on invalid input.
+     */
+    size_t feed(const void* data, size_t size)
+    {
+        state_.pos = static_cast<const unsigned char*>(data);
+        state_.end = state_.pos + size;
+        while (!state_.stack.empty()) {
+            push_detail::frame& current = state_.stack.back();
+            push_detail::status result = current.step(state_, current);
+            if (result == push_detail::status::done) {
+                state_.stack.pop_back();
+            }
+            else if (result == push_detail::status::need_input) {
+                break;
+            }
+        }
+        return static_cast<size_t>(state_.pos - static_cast<const unsigned char*>(data));
+    }
+
+private:
+    T* target_;
+    push_detail::state state_;
+};
+
+#endif // REFL_EXAMPLES_PUSH_PARSER_HPP
@@ -0,0 +1,578 @@
+/**
+ * ***README***
+ * A vector which stores the readable members of its elements in separate arrays (structure of
+ * arrays), for code which scans a few members of many elements.
+ * Used by example-struct-of-arrays.cpp and bench/bench-soa-vector-scan.cpp.
+ *
+ * soa_vector<T> has one column per readable member of T (field or getter property), of the type
+ * the member returns. All columns live in a single allocation, which is replaced on growth, and
+ * each column starts on a 64-byte (cache line) boundary, so that scanning a column never loads the
+ * data of another one. data(member) returns the column of a member, as a contiguous array.
+ *
+ * Elements are accessed through proxies: v[i] and *it are a soa_vector<T>::reference, a
+ * refl::runtime::proxy of T which has the members of T. Calling a field or getter of a reference
+ * returns a reference to the value in the column, and calling it with a value (or calling the
+ * matching setter) assigns to it. A reference converts to a T and can be assigned a T, which
+ * requires every column to have a writer (the field itself or a setter property).
+ */
+#ifndef REFL_EXAMPLES_SOA_VECTOR_HPP
+#define REFL_EXAMPLES_SOA_VECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "refl.hpp"
+
+namespace soa_detail
+{
+    static constexpr size_t column_alignment = 64;
+
+    // the members which are stored (fields and getter properties)
+    template <typename T>
+    static constexpr auto members = filter(refl::member_list<T>{}, [](auto member) { return is_readable(member); });
+
+    template <typename T>
+    using members_t = std::remove_const_t<decltype(members<T>)>;
+
+    /**
+     * The type the readable member returns when invoked.
+     */
+    template <typename ReadableMember>
+    using underlying_type = refl::trait::remove_qualifiers_t<decltype(ReadableMember()(std::declval<const typename ReadableMember::declaring_type&>()))>;
+
+    template <typename ReadableMember>
+    struct make_pointer
+    {
+        using type = underlying_type<ReadableMember>*;
+    };
+
+    template <typename T>
+    using column_pointers = refl::trait::as_tuple_t<refl::trait::map_t<make_pointer, members_t<T>>>;
+
+    constexpr size_t align_up(size_t size) noexcept
+    {
+        return (size + column_alignment - 1) / column_alignment * column_alignment;
+    }
+
+    // The column which a member of a proxy refers to (setters refer to the column of their getter).
+    template <typename T, typename Member>
+    constexpr size_t column_index() noexcept
+    {
+        if constexpr (refl::descriptor::is_function(Member{}) && !refl::descriptor::is_readable(Member{})) {
+            static_assert(refl::descriptor::is_property(Member{}) && refl::descriptor::has_reader(Member{}),
+                "Only fields and properties are available through a soa_vector reference!");
+            return column_index<T, std::remove_const_t<decltype(refl::descriptor::get_reader(Member{}))>>();
+        }
+        else {
+            constexpr ptrdiff_t index = refl::trait::index_of_v<Member, members_t<T>>;
+            static_assert(index != -1, "Only fields and properties are available through a soa_vector reference!");
+            return static_cast<size_t>(index);
+        }
+    }
+
+    // Assigns a value to the member of target which is stored in the column of Member.
+    template <typename Member, typename T, typename V>
+    void write_member(T& target, V&& value)
+    {
+        if constexpr (refl::descriptor::is_field(Member{})) {
+            static_assert(refl::descriptor::is_writable(Member{}), "The field is not writable!");
+            Member{}(target) = std::forward<V>(value);
+        }
+        else {
+            static_assert(refl::descriptor::has_writer(Member{}), "The property has no setter!");
+            constexpr auto writer = refl::descriptor::get_writer(Member{});
+            writer(target, std::forward<V>(value));
+        }
+    }
+
+    // Whether the elements of the column of a member are copied rather than moved into a new allocation:
+    // moving them could throw, and they can be copied (as with std::move_if_noexcept).
+    template <typename ReadableMember>
+    static constexpr bool copy_on_growth = !std::is_nothrow_move_constructible_v<underlying_type<ReadableMember>>
+        && std::is_copy_constructible_v<underlying_type<ReadableMember>>;
+
+    struct block_deleter
+    {
+        void operator()(void* data) const noexcept
+        {
+            ::operator delete(data, std::align_val_t{ column_alignment });
+        }
+    };
+
+    /**
+     * A proxy of an element of a soa_vector or an aosoa_vector (or of a const one), which
+     * accesses the values of the element through the position<Vector> of the vector: a
+     * position(vector, index) has a get<I>() which returns the value of the I-th member.
+     */
+    template <typename Vector, typename T = typename std::remove_const_t<Vector>::value_type>
+    class proxy_reference : public refl::runtime::proxy<proxy_reference<Vector, T>, T>
+    {
+    public:
+        proxy_reference(Vector* vector, size_t index) noexcept
+            : position_(vector, index)
+        {
+        }
+
+        proxy_reference(const proxy_reference&) noexcept = default;
+
+        /** Copies the element into a T. */
+        operator T() const
+        {
+            T value{};
+            refl::util::for_each(members<T>, [&](auto member) {
+                write_member<decltype(member)>(value, position_.template get<column_index<T, decltype(member)>()>());
+            });
+            return value;
+        }
+
+        /** Assigns the members of value to the element. */
+        const proxy_reference& operator=(const T& value) const
+        {
+            static_assert(!std::is_const_v<Vector>, "Cannot assign to an element of a const vector!");
+            refl::util::for_each(members<T>, [&](auto member) {
+                position_.template get<column_index<T, decltype(member)>()>() = member(value);
+            });
+            return *this;
+        }
+
+        /** Assigns the element which other refers to (not the reference itself). */
+        const proxy_reference& operator=(const proxy_reference& other) const
+        {
+            static_assert(!std::is_const_v<Vector>, "Cannot assign to an element of a const vector!");
+            refl::util::for_each(members<T>, [&](auto member) {
+                constexpr size_t index = column_index<T, decltype(member)>();
+                position_.template get<index>() = other.position_.template get<index>();
+            });
+            return *this;
+        }
+
+        friend void swap(const proxy_reference& a, const proxy_reference& b)
+        {
+            static_assert(!std::is_const_v<Vector>, "Cannot assign to an element of a const vector!");
+            refl::util::for_each(members<T>, [&](auto member) {
+                constexpr size_t index = column_index<T, decltype(member)>();
+                using std::swap;
+                swap(a.position_.template get<index>(), b.position_.template get<index>());
+            });
+        }
+
+        template <typename Member, typename Self, typename... Args>
+        static decltype(auto) invoke_impl(Self&& self, Args&&... args)
+        {
+            static_assert(sizeof...(Args) <= 1, "Invalid number of arguments provided for property!");
+            auto& value = self.position_.template get<column_index<T, Member>()>();
+            if constexpr (sizeof...(Args) == 1) {
+                static_assert(!std::is_const_v<Vector>, "Cannot assign to an element of a const vector!");
+                value = (std::forward<Args>(args), ...);
+            }
+            else if constexpr (std::is_const_v<Vector>) {
+                return refl::util::make_const(value);
+            }
+            else {
+                return value;
+            }
+        }
+
+    private:
+        typename std::remove_const_t<Vector>::template position<Vector> position_;
+    };
+
+    /**
+     * A random-access iterator over a soa_vector or an aosoa_vector, which yields references (proxies).
+     */
+    template <typename Vector>
+    class proxy_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename std::remove_const_t<Vector>::value_type;
+        using difference_type = ptrdiff_t;
+        using reference = proxy_reference<Vector>;
+        using pointer = void;
+
+        proxy_iterator() noexcept = default;
+
+        proxy_iterator(Vector* vector, size_t index) noexcept
+            : vector_(vector), index_(index)
+        {
+        }
+
+        // iterator converts to const_iterator
+        template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Vector>>>
+        proxy_iterator(const proxy_iterator<Other>& other) noexcept
+            : vector_(other.vector_), index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept { return reference(vector_, index_); }
+        reference operator[](difference_type n) const noexcept { return reference(vector_, index_ + n); }
+
+        proxy_iterator& operator++() noexcept { index_++; return *this; }
+        proxy_iterator& operator--() noexcept { index_--; return *this; }
+        proxy_iterator operator++(int) noexcept { return proxy_iterator(vector_, index_++); }
+        proxy_iterator operator--(int) noexcept { return proxy_iterator(vector_, index_--); }
+        proxy_iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; }
+        proxy_iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; }
+
+        friend proxy_iterator operator+(proxy_iterator it, difference_type n) noexcept { return it += n; }
+        friend proxy_iterator operator+(difference_type n, proxy_iterator it) noexcept { return it += n; }
+        friend proxy_iterator operator-(proxy_iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const proxy_iterator& a, const proxy_iterator& b) noexcept
+        {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const proxy_iterator& a, const proxy_iterator& b) noexcept { return a.index_ == b.index_; }
+        friend bool operator!=(const proxy_iterator& a, const proxy_iterator& b) noexcept { return a.index_ != b.index_; }
+        friend bool operator<(const proxy_iterator& a, const proxy_iterator& b) noexcept { return a.index_ < b.index_; }
+        friend bool operator>(const proxy_iterator& a, const proxy_iterator& b) noexcept { return a.index_ > b.index_; }
+        friend bool operator<=(const proxy_iterator& a, const proxy_iterator& b) noexcept { return a.index_ <= b.index_; }
+        friend bool operator>=(const proxy_iterator& a, const proxy_iterator& b) noexcept { return a.index_ >= b.index_; }
+
+    private:
+        template <typename Other>
+        friend class proxy_iterator;
+
+        Vector* vector_ = nullptr;
+        size_t index_ = 0;
+    };
+}
+
+/**
+ * A sequence container of T, stored as one cache-line-aligned array per readable member of T.
+ *
+ * \code{.cpp}
+ * soa_vector<Particle> particles;
+ * particles.push_back(Particle{ ... });
+ * particles[0].x(1.5f);                     // assigns the x of the first particle
+ * for (auto particle : particles) {         // particle is a proxy
+ *     particle.x(particle.x() + particle.vx());
+ * }
+ * const float* xs = particles.data(refl::trait::get_t<0, refl::member_list<Particle>>{});
+ * \endcode
+ */
+template <typename T>
+class soa_vector
+{
+public:
+    using members = soa_detail::members_t<T>;
+    static_assert(members::size > 0, "Type has no readable members!");
+
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using reference = soa_detail::proxy_reference<soa_vector>;
+    using const_reference = soa_detail::proxy_reference<const soa_vector>;
+    using iterator = soa_detail::proxy_iterator<soa_vector>;
+    using const_iterator = soa_detail::proxy_iterator<const soa_vector>;
+
+    // The element at an index, which references access through get<I>() (see soa_detail::proxy_reference).
+    template <typename Vector>
+    class position
+    {
+    public:
+        position(Vector* vector, size_t index) noexcept
+            : vector_(vector), index_(index)
+        {
+        }
+
+        template <size_t I>
+        auto& get() const noexcept
+        {
+            return std::get<I>(vector_->columns_)[index_];
+        }
+
+    private:
+        Vector* vector_;
+        size_t index_;
+    };
+
+    soa_vector() noexcept = default;
+
+    explicit soa_vector(size_t count)
+    {
+        resize(count);
+    }
+
+    soa_vector(const soa_vector& other)
+    {
+        reserve(other.size_);
+        construct_columns(columns_, other.size_, members{}, [&](auto member, auto* column) {
+            const auto* source = other.column_of(member);
+            std::uninitialized_copy(source, source + other.size_, column);
+        });
+        size_ = other.size_;
+    }
+
+    soa_vector(soa_vector&& other) noexcept
+    {
+        swap(other);
+    }
+
+    soa_vector& operator=(const soa_vector& other)
+    {
+        if (this != &other) {
+            soa_vector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    soa_vector& operator=(soa_vector&& other) noexcept
+    {
+        soa_vector moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~soa_vector()
+    {
+        clear();
+    }
+
+    void swap(soa_vector& other) noexcept
+    {
+        std::swap(block_, other.block_);
+        std::swap(columns_, other.columns_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    /** The column of the member (a descriptor from members), which has size() elements. */
+    template <typename Member>
+    auto* data(Member) noexcept { return column_of(Member{}); }
+
+    template <typename Member>
+    const auto* data(Member) const noexcept { return column_of(Member{}); }
+
+    /** Makes room for count elements with a single allocation. */
+    void reserve(size_t count)
+    {
+        if (count <= capacity_) {
+            return;
+        }
+        // the columns are laid out one after another, each aligned to a cache line
+        size_t bytes = 0;
+        std::array<size_t, members::size> offsets{};
+        refl::util::for_each(members{}, [&](auto member, size_t index) {
+            using column_type = soa_detail::underlying_type<decltype(member)>;
+            offsets[index] = bytes;
+            bytes += soa_detail::align_up(count * sizeof(column_type));
+        });
+        std::unique_ptr<void, soa_detail::block_deleter> block(::operator new(bytes, std::align_val_t{ soa_detail::column_alignment }));
+        auto* base = static_cast<unsigned char*>(block.get());
+        soa_detail::column_pointers<T> columns;
+        refl::util::for_each(members{}, [&](auto member, size_t index) {
+            using column_type = soa_detail::underlying_type<decltype(member)>;
+            std::get<index_of(decltype(member){})>(columns) = reinterpret_cast<column_type*>(base + offsets[index]);
+        });
+        // The columns whose elements could throw when moved are copied first, and the other ones are
+        // moved after that, so that the vector is unchanged if a copy throws (as with std::vector,
+        // only a throwing move of a type which cannot be copied leaves moved-from elements behind).
+        constexpr auto copied = filter(members{}, [](auto member) { return soa_detail::copy_on_growth<decltype(member)>; });
+        constexpr auto moved = filter(members{}, [](auto member) { return !soa_detail::copy_on_growth<decltype(member)>; });
+        construct_columns(columns, size_, copied, [&](auto member, auto* column) {
+            auto* source = column_of(member);
+            std::uninitialized_copy(source, source + size_, column);
+        });
+        try {
+            construct_columns(columns, size_, moved, [&](auto member, auto* column) {
+                auto* source = column_of(member);
+                std::uninitialized_move(source, source + size_, column);
+            });
+        }
+        catch (...) {
+            destroy_columns(columns, size_, copied);
+            throw;
+        }
+        // every new column was constructed, so the old ones can be destroyed
+        for_each_column([&](auto, auto* column) {
+            std::destroy(column, column + size_);
+        });
+        block_ = std::move(block);
+        columns_ = columns;
+        capacity_ = count;
+    }
+
+    /** Adds or removes elements at the end (added elements are default-constructed, member by member). */
+    void resize(size_t count)
+    {
+        resize_with(count, [](auto member, auto* slot) {
+            new (slot) soa_detail::underlying_type<decltype(member)>();
+        });
+    }
+
+    /** Adds or removes elements at the end (added elements are copies of value). */
+    void resize(size_t count, const T& value)
+    {
+        resize_with(count, [&](auto member, auto* slot) {
+            new (slot) soa_detail::underlying_type<decltype(member)>(member(value));
+        });
+    }
+
+    void push_back(const T& value)
+    {
+        resize(size_ + 1, value);
+    }
+
+    void pop_back() noexcept
+    {
+        shrink(size_ - 1);
+    }
+
+    void clear() noexcept
+    {
+        shrink(0);
+    }
+
+    /** Removes the elements in [first, last) and returns an iterator to the element after them. */
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        size_t begin = static_cast<size_t>(first - cbegin());
+        size_t end = static_cast<size_t>(last - cbegin());
+        if (begin != end) {
+            for_each_column([&](auto, auto* column) {
+                std::move(column + end, column + size_, column + begin);
+            });
+            shrink(size_ - (end - begin));
+        }
+        return iterator(this, begin);
+    }
+
+    iterator erase(const_iterator position)
+    {
+        return erase(position, position + 1);
+    }
+
+    reference operator[](size_t index) noexcept { return reference(this, index); }
+    const_reference operator[](size_t index) const noexcept { return const_reference(this, index); }
+
+    /** Returns a copy of the element at index. Throws std::out_of_range if there is none. */
+    T at(size_t index) const
+    {
+        if (index >= size_) {
+            throw std::out_of_range("soa_vector::at");
+        }
+        return (*this)[index];
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+    const_reference front() const noexcept { return (*this)[0]; }
+    reference back() noexcept { return (*this)[size_ - 1]; }
+    const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size_); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, size_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    template <typename Member>
+    static constexpr size_t index_of(Member) noexcept
+    {
+        return static_cast<size_t>(refl::trait::index_of_v<Member, members>);
+    }
+
+    template <typename Member>
+    auto* column_of(Member) const noexcept
+    {
+        return std::get<index_of(Member{})>(columns_);
+    }
+
+    // Calls f(member, column) for each column.
+    template <typename F>
+    void for_each_column(F&& f) const
+    {
+        refl::util::for_each(members{}, [&](auto member) {
+            f(member, column_of(member));
+        });
+    }
+
+    // Calls construct(member, column) to construct the first count elements of the column of each of
+    // the members (a list of members), and destroys the columns which were constructed if one of the calls throws.
+    template <typename... Members, typename Construct>
+    static void construct_columns(const soa_detail::column_pointers<T>& columns, size_t count, refl::type_list<Members...> list, Construct&& construct)
+    {
+        size_t constructed = 0;
+        try {
+            refl::util::for_each(list, [&](auto member) {
+                construct(member, std::get<index_of(decltype(member){})>(columns));
+                constructed++;
+            });
+        }
+        catch (...) {
+            refl::util::for_each(list, [&](auto member, size_t index) {
+                if (index < constructed) destroy_columns(columns, count, refl::type_list<decltype(member)>{});
+            });
+            throw;
+        }
+    }
+
+    // Destroys the first count elements of the columns of the members (a list of members).
+    template <typename... Members>
+    static void destroy_columns(const soa_detail::column_pointers<T>& columns, size_t count, refl::type_list<Members...>) noexcept
+    {
+        refl::util::for_each(refl::type_list<Members...>{}, [&](auto member) {
+            auto* column = std::get<index_of(decltype(member){})>(columns);
+            std::destroy(column, column + count);
+        });
+    }
+
+    void shrink(size_t count) noexcept
+    {
+        for_each_column([&](auto, auto* column) {
+            std::destroy(column + count, column + size_);
+        });
+        size_ = count;
+    }
+
+    template <typename Construct>
+    void resize_with(size_t count, Construct&& construct)
+    {
+        if (count <= size_) {
+            shrink(count);
+            return;
+        }
+        if (count > capacity_) {
+            reserve((std::max)(count, capacity_ * 2));
+        }
+        while (size_ < count) {
+            // on an exception, the columns of the element which were constructed are destroyed
+            size_t constructed = 0;
+            try {
+                for_each_column([&](auto member, auto* column) {
+                    construct(member, column + size_);
+                    constructed++;
+                });
+            }
+            catch (...) {
+                for_each_column([&](auto member, auto* column) {
+                    if (index_of(decltype(member){}) < constructed) std::destroy_at(column + size_);
+                });
+                throw;
+            }
+            size_++;
+        }
+    }
+
+    std::unique_ptr<void, soa_detail::block_deleter> block_;
+    soa_detail::column_pointers<T> columns_{};
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+#endif // REFL_EXAMPLES_SOA_VECTOR_HPP
@@ -0,0 +1,674 @@
+/**
+ * ***README***
+ * A schema-evolvable binary format driven by the attr::tag attribute of fields.
+ * Used by example-tagged-binary.cpp and bench/bench-deserialize-tagged.cpp.
+ *
+ * serialize_tagged(value, out) writes every field marked with tag(N) as a key followed by
+ * its value, in the style of Protocol Buffers. The key is the varint (LEB128) encoding of
+ * N << 3 | wire type, and it is encoded at compile-time. The wire types are:
+ *   - varint: bool, unsigned integers, signed integers (zigzag-encoded) and enums
+ *   - fixed32/fixed64: float and double, little-endian
+ *   - length-delimited: strings, containers and reflected types, prefixed with their size in bytes
+ * The elements of containers are written one after another, without keys.
+ * Empty std::optional fields are not written at all.
+ *
+ * deserialize_tagged(data, size, value) first matches the keys against the compile-time keys
+ * of the fields in declaration order (the order they are written in) and decodes them inline.
+ * From the first key which does not match on, it dispatches on the tag of each key through
+ * a dense jump table (indexed by the tag) generated at compile-time. Unknown tags, and known tags
+ * with a different wire type, are skipped, and fields which are not present keep their value,
+ * so writers and readers can use different versions of a type, as long as tags are never reused.
+ * Integers may be widened between versions, since their encoding does not depend on their size.
+ */
+#ifndef REFL_EXAMPLES_TAGGED_BINARY_HPP
+#define REFL_EXAMPLES_TAGGED_BINARY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "refl.hpp"
+
+namespace tagged_detail
+{
+    using byte = unsigned char;
+
+    enum wire_type : byte
+    {
+        varint = 0,
+        fixed64 = 1,
+        length_delimited = 2,
+        fixed32 = 5
+    };
+
+    template <typename T>
+    struct is_optional : std::false_type {};
+
+    template <typename T>
+    struct is_optional<std::optional<T>> : std::true_type {};
+
+    template <typename T>
+    struct is_std_array : std::false_type {};
+
+    template <typename T, size_t N>
+    struct is_std_array<std::array<T, N>> : std::true_type {};
+
+    template <typename T, typename = void>
+    struct is_key_value_container : std::false_type {};
+
+    template <typename T>
+    struct is_key_value_container<T, std::void_t<typename T::key_type, typename T::mapped_type>> : std::true_type {};
+
+    // the fields which are serialized
+    template <typename T>
+    static constexpr auto fields = filter(refl::member_list<T>{}, [](auto member) {
+        if constexpr (refl::descriptor::is_field(member)) {
+            return !member.is_static && refl::descriptor::has_tag(member);
+        }
+        else {
+            return false;
+        }
+    });
+
+    template <typename T>
+    using fields_t = std::remove_const_t<decltype(fields<T>)>;
+
+    template <typename Member>
+    using field_type = refl::trait::remove_qualifiers_t<typename Member::value_type>;
+
+    template <typename T>
+    static constexpr auto tags = refl::util::map_to_array<uint32_t>(fields<T>, [](auto member) {
+        return refl::descriptor::get_tag(member);
+    });
+
+    // tags are used as indices into the jump table of the decoder
+    constexpr uint32_t max_tag = 1u << 16;
+
+    template <size_t N>
+    constexpr bool are_valid_tags(const std::array<uint32_t, N>& tags) noexcept
+    {
+        for (size_t i = 0; i < N; i++) {
+            if (tags[i] == 0 || tags[i] > max_tag) {
+                return false;
+            }
+            for (size_t j = 0; j < i; j++) {
+                if (tags[i] == tags[j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <size_t N>
+    constexpr uint32_t largest_tag(const std::array<uint32_t, N>& tags) noexcept
+    {
+        uint32_t result = 0;
+        for (size_t i = 0; i < N; i++) {
+            if (tags[i] > result) result = tags[i];
+        }
+        return result;
+    }
+
+    template <typename T>
+    constexpr wire_type wire_type_of() noexcept
+    {
+        if constexpr (is_optional<T>::value) {
+            return wire_type_of<typename T::value_type>();
+        }
+        else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            return varint;
+        }
+        else if constexpr (std::is_same_v<T, float>) {
+            return fixed32;
+        }
+        else if constexpr (std::is_same_v<T, double>) {
+            return fixed64;
+        }
+        else {
+            return length_delimited;
+        }
+    }
+
+    constexpr size_t encode_varint(byte* out, uint64_t value) noexcept
+    {
+        size_t size = 0;
+        while (value >= 0x80) {
+            out[size++] = static_cast<byte>(value | 0x80);
+            value >>= 7;
+        }
+        out[size++] = static_cast<byte>(value);
+        return size;
+    }
+
+    constexpr uint64_t zigzag(int64_t value) noexcept
+    {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    constexpr int64_t unzigzag(uint64_t value) noexcept
+    {
+        return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    struct encoded_key
+    {
+        std::array<byte, 5> bytes{};
+        size_t size{};
+    };
+
+    constexpr encoded_key make_key(uint32_t tag, wire_type type) noexcept
+    {
+        encoded_key key{};
+        key.size = encode_varint(key.bytes.data(), static_cast<uint64_t>(tag) << 3 | type);
+        return key;
+    }
+
+    // The key written before the value of a field.
+    template <typename Member>
+    static constexpr encoded_key key_of = make_key(refl::descriptor::get_tag(Member{}), wire_type_of<field_type<Member>>());
+
+    constexpr size_t max_varint_size = 10;
+
+    /**
+     * The buffer written to by serialize_tagged (and encode_protobuf). The size of a length-delimited
+     * value is only known after its contents are written, so write_delimited reserves the longest
+     * varint for it and records the bytes it does not use as a gap. finish removes all gaps in one
+     * pass at the end, so that writing stays linear in the size of the output at any nesting depth.
+     */
+    template <typename Buffer>
+    class output
+    {
+    public:
+        using value_type = typename Buffer::value_type;
+
+        // The position of a reserved size prefix and the number of unused bytes before its contents.
+        struct prefix
+        {
+            size_t index;
+            size_t unused;
+        };
+
+        explicit output(Buffer& out) noexcept
+            : out_(out)
+        {
+        }
+
+        void push_back(value_type value)
+        {
+            out_.push_back(value);
+        }
+
+        void append(const byte* data, size_t size)
+        {
+            out_.insert(out_.end(), data, data + size);
+        }
+
+        prefix begin_delimited()
+        {
+            static constexpr byte reserved[max_varint_size]{};
+            gaps_.push_back({ out_.size(), 0 });
+            append(reserved, max_varint_size);
+            return { gaps_.size() - 1, unused_ };
+        }
+
+        // Writes the size of the contents written since begin_delimited into the reserved bytes.
+        void end_delimited(prefix p)
+        {
+            const size_t pos = gaps_[p.index].pos;
+            const size_t size = out_.size() - (pos + max_varint_size) - (unused_ - p.unused);
+            byte bytes[max_varint_size];
+            const size_t count = encode_varint(bytes, size);
+            for (size_t i = 0; i < count; i++) {
+                out_[pos + i] = static_cast<value_type>(bytes[i]);
+            }
+            gaps_[p.index] = { pos + count, max_varint_size - count };
+            unused_ += max_varint_size - count;
+        }
+
+        // Moves the bytes after each gap down to close it. The gaps are recorded in the order of their positions.
+        void finish()
+        {
+            if (gaps_.empty()) {
+                return;
+            }
+            size_t to = gaps_.front().pos;
+            for (size_t i = 0; i < gaps_.size(); i++) {
+                const size_t from = gaps_[i].pos + gaps_[i].size;
+                const size_t until = i + 1 < gaps_.size() ? gaps_[i + 1].pos : out_.size();
+                std::copy(at(from), at(until), at(to));
+                to += until - from;
+            }
+            out_.resize(to);
+        }
+
+    private:
+        struct gap
+        {
+            size_t pos;
+            size_t size;
+        };
+
+        auto at(size_t pos)
+        {
+            return out_.begin() + static_cast<std::ptrdiff_t>(pos);
+        }
+
+        Buffer& out_;
+        std::vector<gap> gaps_;
+        size_t unused_ = 0;
+    };
+
+    template <typename Buffer>
+    void append(Buffer& out, const byte* data, size_t size)
+    {
+        out.insert(out.end(), data, data + size);
+    }
+
+    template <typename Buffer>
+    void append(output<Buffer>& out, const byte* data, size_t size)
+    {
+        out.append(data, size);
+    }
+
+    template <typename Buffer>
+    void write_varint(Buffer& out, uint64_t value)
+    {
+        byte bytes[max_varint_size];
+        append(out, bytes, encode_varint(bytes, value));
+    }
+
+    template <typename Buffer>
+    void write_fixed(Buffer& out, uint64_t bits, size_t size)
+    {
+        byte bytes[8];
+        for (size_t i = 0; i < size; i++) {
+            bytes[i] = static_cast<byte>(bits >> (8 * i));
+        }
+        append(out, bytes, size);
+    }
+
+    // Writes the contents produced by write_contents prefixed by their size.
+    template <typename Buffer, typename F>
+    void write_delimited(output<Buffer>& out, F&& write_contents)
+    {
+        auto prefix = out.begin_delimited();
+        write_contents();
+        out.end_delimited(prefix);
+    }
+
+    template <typename Buffer, typename T>
+    void write_message(Buffer& out, const T& value);
+
+    // Writes a value without its key.
+    template <typename Buffer, typename T>
+    void write_value(Buffer& out, const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            out.push_back(static_cast<typename Buffer::value_type>(value ? 1 : 0));
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            write_varint(out, zigzag(static_cast<int64_t>(value)));
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            write_varint(out, static_cast<uint64_t>(value));
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            write_value(out, static_cast<std::underlying_type_t<T>>(value));
+        }
+        else if constexpr (std::is_same_v<T, float>) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            write_fixed(out, bits, 4);
+        }
+        else if constexpr (std::is_same_v<T, double>) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            write_fixed(out, bits, 8);
+        }
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            std::string_view str(value);
+            write_varint(out, str.size());
+            append(out, reinterpret_cast<const byte*>(str.data()), str.size());
+        }
+        else if constexpr (is_key_value_container<T>::value) {
+            write_delimited(out, [&] {
+                for (const auto& [key, element] : value) {
+                    write_value(out, key);
+                    write_value(out, element);
+                }
+            });
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            static_assert(!is_optional<typename T::value_type>::value, "Containers of std::optional are not supported!");
+            write_delimited(out, [&] {
+                for (const auto& element : value) {
+                    write_value(out, element);
+                }
+            });
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by serialize_tagged!");
+            write_delimited(out, [&] { write_message(out, value); });
+        }
+    }
+
+    template <typename Buffer, typename T>
+    void write_message(Buffer& out, const T& value)
+    {
+        static_assert(are_valid_tags(tags<T>), "Tags must be unique and between 1 and 65536!");
+        for_each(fields<T>, [&](auto member) {
+            using member_type = decltype(member);
+            const auto& field = member(value);
+            if constexpr (is_optional<field_type<member_type>>::value) {
+                if (field) {
+                    append(out, key_of<member_type>.bytes.data(), key_of<member_type>.size);
+                    write_value(out, *field);
+                }
+            }
+            else {
+                append(out, key_of<member_type>.bytes.data(), key_of<member_type>.size);
+                write_value(out, field);
+            }
+        });
+    }
+
+    class reader
+    {
+    public:
+        reader(const byte* begin, const byte* pos, const byte* end) noexcept
+            : begin_(begin), pos_(pos), end_(end)
+        {
+        }
+
+        [[noreturn]] void fail(const char* message) const
+        {
+            throw std::runtime_error(std::string("Decoding error at offset ") + std::to_string(pos_ - begin_) + ": " + message);
+        }
+
+        bool at_end() const noexcept
+        {
+            return pos_ == end_;
+        }
+
+        size_t remaining() const noexcept
+        {
+            return static_cast<size_t>(end_ - pos_);
+        }
+
+        // The next size bytes, without consuming them, or nullptr if there are fewer.
+        const byte* peek(size_t size) const noexcept
+        {
+            return remaining() < size ? nullptr : pos_;
+        }
+
+        const byte* take(uint64_t size)
+        {
+            if (static_cast<uint64_t>(end_ - pos_) < size) {
+                fail("unexpected end of input");
+            }
+            const byte* result = pos_;
+            pos_ += size;
+            return result;
+        }
+
+        // Consumes the specified bytes if they come next.
+        bool consume(const byte* bytes, size_t size) noexcept
+        {
+            if (static_cast<size_t>(end_ - pos_) < size || std::memcmp(pos_, bytes, size) != 0) {
+                return false;
+            }
+            pos_ += size;
+            return true;
+        }
+
+        uint64_t read_varint()
+        {
+            // fast path: single-byte varints
+            if (pos_ != end_ && *pos_ < 0x80) {
+                return *pos_++;
+            }
+            uint64_t value = 0;
+            // no bounds checks are needed when the longest varint fits
+            const byte* pos = pos_;
+            bool checked = end_ - pos_ < 10;
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (checked && pos == end_) {
+                    fail("unexpected end of input");
+                }
+                byte next = *pos++;
+                value |= static_cast<uint64_t>(next & 0x7f) << shift;
+                if (next < 0x80) {
+                    pos_ = pos;
+                    return value;
+                }
+            }
+            fail("varint is too long");
+        }
+
+        uint64_t read_fixed(size_t size)
+        {
+            const byte* bytes = take(size);
+            uint64_t bits = 0;
+            for (size_t i = 0; i < size; i++) {
+                bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+            }
+            return bits;
+        }
+
+        // A reader of the next length-delimited value, which is skipped by this reader.
+        reader read_delimited()
+        {
+            uint64_t size = read_varint();
+            const byte* start = take(size);
+            return reader(begin_, start, pos_);
+        }
+
+        size_t offset() const noexcept
+        {
+            return static_cast<size_t>(pos_ - begin_);
+        }
+
+    private:
+        const byte* begin_;
+        const byte* pos_;
+        const byte* end_;
+    };
+
+    inline void skip(reader& in, uint64_t type)
+    {
+        switch (type) {
+        case varint: in.read_varint(); break;
+        case fixed64: in.take(8); break;
+        case length_delimited: in.read_delimited(); break;
+        case fixed32: in.take(4); break;
+        default: in.fail("invalid wire type");
+        }
+    }
+
+    template <typename T, typename U>
+    T narrow(reader& in, U value)
+    {
+        if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) {
+            in.fail("integer out of range");
+        }
+        return static_cast<T>(value);
+    }
+
+    template <typename T>
+    void read_message(reader& in, T& value);
+
+    // Reads a value without its key.
+    template <typename T>
+    void read_value(reader& in, T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            value = in.read_varint() != 0;
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            value = narrow<T>(in, unzigzag(in.read_varint()));
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            value = narrow<T>(in, in.read_varint());
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            std::underlying_type_t<T> underlying{};
+            read_value(in, underlying);
+            value = static_cast<T>(underlying);
+        }
+        else if constexpr (std::is_same_v<T, float>) {
+            uint32_t bits = static_cast<uint32_t>(in.read_fixed(4));
+            std::memcpy(&value, &bits, sizeof(bits));
+        }
+        else if constexpr (std::is_same_v<T, double>) {
+            uint64_t bits = in.read_fixed(8);
+            std::memcpy(&value, &bits, sizeof(bits));
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            uint64_t size = in.read_varint();
+            value.assign(reinterpret_cast<const char*>(in.take(size)), size);
+        }
+        else if constexpr (is_optional<T>::value) {
+            if (!value) value.emplace();
+            read_value(in, *value);
+        }
+        else if constexpr (is_key_value_container<T>::value) {
+            reader contents = in.read_delimited();
+            value.clear();
+            while (!contents.at_end()) {
+                typename T::key_type key{};
+                typename T::mapped_type element{};
+                read_value(contents, key);
+                read_value(contents, element);
+                value.emplace(std::move(key), std::move(element));
+            }
+        }
+        else if constexpr (is_std_array<T>::value) {
+            reader contents = in.read_delimited();
+            for (auto& element : value) {
+                read_value(contents, element);
+            }
+            if (!contents.at_end()) {
+                contents.fail("array size mismatch");
+            }
+        }
+        else if constexpr (refl::trait::is_container_v<T>) {
+            reader contents = in.read_delimited();
+            value.clear();
+            while (!contents.at_end()) {
+                read_value(contents, value.emplace_back());
+            }
+        }
+        else {
+            static_assert(refl::trait::is_reflectable_v<T>, "Type is not supported by deserialize_tagged!");
+            reader contents = in.read_delimited();
+            read_message(contents, value);
+        }
+    }
+
+    template <typename T, size_t I>
+    void read_field(reader& in, T& value)
+    {
+        using member = refl::trait::get_t<I, fields_t<T>>;
+        read_value(in, member{}(value));
+    }
+
+    template <typename T>
+    struct field_entry
+    {
+        void (*read)(reader&, T&);
+        wire_type type;
+    };
+
+    /** The dense jump table of the decoder of T, indexed by tag. */
+    template <typename T>
+    struct field_table
+    {
+        static_assert(are_valid_tags(tags<T>), "Tags must be unique and between 1 and 65536!");
+
+        static constexpr size_t size = largest_tag(tags<T>) + 1;
+
+        template <size_t... I>
+        static constexpr std::array<field_entry<T>, size> make(std::index_sequence<I...>) noexcept
+        {
+            std::array<field_entry<T>, size> table{};
+            ((table[tags<T>[I]] = field_entry<T>{ &read_field<T, I>, wire_type_of<field_type<refl::trait::get_t<I, fields_t<T>>>>() }), ...);
+            return table;
+        }
+
+        static constexpr std::array<field_entry<T>, size> entries = make(std::make_index_sequence<fields<T>.size>{});
+    };
+
+    // Reads the field I if it comes next, which avoids the indirect call of the jump table.
+    template <typename T, size_t I>
+    bool read_expected_field(reader& in, T& value)
+    {
+        using member = refl::trait::get_t<I, fields_t<T>>;
+        if (!in.consume(key_of<member>.bytes.data(), key_of<member>.size)) {
+            return false;
+        }
+        read_value(in, member{}(value));
+        return true;
+    }
+
+    template <typename T, size_t... I>
+    void read_message(reader& in, T& value, std::index_sequence<I...>)
+    {
+        // writers usually emit the fields in declaration order, try that first
+        (read_expected_field<T, I>(in, value) && ...);
+
+        const auto& table = field_table<T>::entries;
+        while (!in.at_end()) {
+            uint64_t key = in.read_varint();
+            uint64_t tag = key >> 3;
+            uint64_t type = key & 7;
+            if (tag < table.size() && table[tag].read != nullptr && table[tag].type == type) {
+                table[tag].read(in, value);
+            }
+            else {
+                skip(in, type);
+            }
+        }
+    }
+
+    template <typename T>
+    void read_message(reader& in, T& value)
+    {
+        read_message(in, value, std::make_index_sequence<fields<T>.size>{});
+    }
+}
+
+/**
+ * Appends the fields of value which have a tag attribute to out
+ * (a std::vector<unsigned char> or another random-access container of bytes with resize).
+ */
+template <typename T, typename Buffer>
+void serialize_tagged(const T& value, Buffer& out)
+{
+    tagged_detail::output<Buffer> writer(out);
+    tagged_detail::write_message(writer, value);
+    writer.finish();
+}
+
+/**
+ * Reads the fields present in data into value, skipping unknown tags.
+ * Fields which are not present keep their value.
+ * Throws std::runtime_error on malformed input or integers which do not fit into their field.
+ */
+template <typename T>
+void deserialize_tagged(const void* data, size_t size, T& value)
+{
+    const auto* begin = static_cast<const unsigned char*>(data);
+    tagged_detail::reader in(begin, begin, begin + size);
+    tagged_detail::read_message(in, value);
+}
+
+#endif // REFL_EXAMPLES_TAGGED_BINARY_HPP
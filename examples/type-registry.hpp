@@ -0,0 +1,256 @@
+/**
+ * ***README***
+ * A process-wide registry of runtime type records built from refl-cpp type_descriptors.
+ * Used by example-type-registry.cpp and bench/bench-type-registry-startup.cpp.
+ *
+ * Every registered type gets a dense integer id (0, 1, 2, ...), which can be used
+ * to look up its record in O(1), and the records can also be looked up by name
+ * through an open-addressing hash table keyed by the FNV-1a hash of the name
+ * (the same hash which refl-cpp computes at compile-time in type_descriptor::name_hash).
+ *
+ * Registration is serialized by a mutex. Lookups never lock and never wait:
+ * records live in fixed-size chunks which are never moved, and the name index is
+ * replaced (not resized in place) when it grows, so readers only ever see
+ * fully-constructed, immutable data through acquire loads.
+ */
+#ifndef REFL_EXAMPLES_TYPE_REGISTRY_HPP
+#define REFL_EXAMPLES_TYPE_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "refl.hpp"
+
+/** The runtime information stored for each registered type. */
+struct TypeRecord
+{
+    uint32_t id;
+    std::string name;
+    uint64_t name_hash;
+    size_t size;
+    size_t align;
+    size_t member_count;
+};
+
+class TypeRegistry
+{
+public:
+
+    /** The id returned for types which are not registered. */
+    static constexpr uint32_t invalid_id = static_cast<uint32_t>(-1);
+
+    /** The maximum number of types that can be registered. */
+    static constexpr size_t max_types = size_t(1) << 20;
+
+    /** The process-wide registry. */
+    static TypeRegistry& Instance()
+    {
+        static TypeRegistry registry;
+        return registry;
+    }
+
+    TypeRegistry(const TypeRegistry&) = delete;
+    TypeRegistry& operator=(const TypeRegistry&) = delete;
+
+    ~TypeRegistry()
+    {
+        for (auto& chunk : chunks_) {
+            delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Registers T under its reflected name and returns its id.
+     * Registering the same type again returns the existing id.
+     */
+    template <typename T>
+    uint32_t Register()
+    {
+        constexpr auto td = refl::reflect<T>();
+        return Register<T>(std::string_view(td.name.c_str(), td.name.size), td.name_hash);
+    }
+
+    /**
+     * Registers T under the specified name and returns its id.
+     * Useful for template instances, whose reflected name is the name of the template.
+     */
+    template <typename T>
+    uint32_t Register(std::string_view name)
+    {
+        return Register<T>(name, NameHash(name));
+    }
+
+    /** Returns the id of T, or invalid_id if T is not registered. Wait-free. */
+    template <typename T>
+    static uint32_t IdOf() noexcept
+    {
+        return TypeIdSlot<T>::id.load(std::memory_order_acquire);
+    }
+
+    /** Returns the record of T, or nullptr if T is not registered. Wait-free. */
+    template <typename T>
+    const TypeRecord* Find() const noexcept
+    {
+        return Find(IdOf<T>());
+    }
+
+    /** Returns the record with the specified id, or nullptr if there is no such record. Wait-free. */
+    const TypeRecord* Find(uint32_t id) const noexcept
+    {
+        if (id >= count_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        const Chunk* chunk = chunks_[id / chunk_size].load(std::memory_order_acquire);
+        return &chunk->records[id % chunk_size];
+    }
+
+    /** Returns the record with the specified name, or nullptr if there is no such record. Wait-free. */
+    const TypeRecord* Find(std::string_view name) const noexcept
+    {
+        const uint64_t hash = NameHash(name);
+        const NameIndex* index = index_.load(std::memory_order_acquire);
+        // Probing is bounded, since the index is never more than half full.
+        for (size_t i = hash & index->mask;; i = (i + 1) & index->mask) {
+            uint32_t slot = index->slots[i].load(std::memory_order_acquire);
+            if (slot == 0) {
+                return nullptr;
+            }
+            const TypeRecord* record = Find(slot - 1);
+            if (record->name_hash == hash && record->name == name) {
+                return record;
+            }
+        }
+    }
+
+    /** The number of registered types. */
+    size_t Size() const noexcept
+    {
+        return count_.load(std::memory_order_acquire);
+    }
+
+private:
+
+    // Ids are stored in per-type static slots, so there can only be a single registry.
+    TypeRegistry()
+        : index_(nullptr)
+    {
+        for (auto& chunk : chunks_) {
+            chunk.store(nullptr, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        Reindex(initial_index_size);
+    }
+
+    static constexpr size_t chunk_size = 1024;
+    static constexpr size_t initial_index_size = 64;
+
+    struct Chunk
+    {
+        std::array<TypeRecord, chunk_size> records;
+    };
+
+    struct NameIndex
+    {
+        size_t mask;
+        // id + 1 of the record in the slot, 0 when empty
+        std::unique_ptr<std::atomic<uint32_t>[]> slots;
+    };
+
+    template <typename T>
+    struct TypeIdSlot
+    {
+        static inline std::atomic<uint32_t> id{ invalid_id };
+    };
+
+    // the hash of type_descriptor::name_hash and refl::const_string::hash()
+    static uint64_t NameHash(std::string_view name) noexcept
+    {
+        return refl::util::detail::fnv1a(name.data(), name.size());
+    }
+
+    template <typename T>
+    uint32_t Register(std::string_view name, uint64_t hash)
+    {
+        // Keep the per-type part small, there might be thousands of registered types.
+        return Register(TypeIdSlot<T>::id, name, hash, sizeof(T), alignof(T), refl::member_list<T>::size);
+    }
+
+    uint32_t Register(std::atomic<uint32_t>& slot, std::string_view name, uint64_t hash, size_t size, size_t align, size_t member_count)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        uint32_t existing = slot.load(std::memory_order_relaxed);
+        if (existing != invalid_id) {
+            return existing;
+        }
+
+        uint32_t id = count_.load(std::memory_order_relaxed);
+        if (id >= max_types) {
+            throw std::length_error("TypeRegistry is full!");
+        }
+
+        Chunk* chunk = chunks_[id / chunk_size].load(std::memory_order_relaxed);
+        if (chunk == nullptr) {
+            chunk = new Chunk();
+            chunks_[id / chunk_size].store(chunk, std::memory_order_release);
+        }
+
+        chunk->records[id % chunk_size] = TypeRecord{ id, std::string(name), hash, size, align, member_count };
+
+        // Publish the record before it becomes reachable by id or by name.
+        count_.store(id + 1, std::memory_order_release);
+        slot.store(id, std::memory_order_release);
+
+        const NameIndex* index = index_.load(std::memory_order_relaxed);
+        if ((id + 1) * 2 > index->mask + 1) {
+            Reindex((index->mask + 1) * 2);
+        }
+        else {
+            Insert(*index, hash, id);
+        }
+        return id;
+    }
+
+    static void Insert(const NameIndex& index, uint64_t hash, uint32_t id) noexcept
+    {
+        size_t i = hash & index.mask;
+        while (index.slots[i].load(std::memory_order_relaxed) != 0) {
+            i = (i + 1) & index.mask;
+        }
+        index.slots[i].store(id + 1, std::memory_order_release);
+    }
+
+    // Builds a new index containing all published records and swaps it in.
+    // The old index is kept alive, since readers might still be using it.
+    void Reindex(size_t size)
+    {
+        auto index = std::make_unique<NameIndex>();
+        index->mask = size - 1;
+        index->slots.reset(new std::atomic<uint32_t>[size]);
+        for (size_t i = 0; i < size; i++) {
+            index->slots[i].store(0, std::memory_order_relaxed);
+        }
+
+        uint32_t count = count_.load(std::memory_order_relaxed);
+        for (uint32_t id = 0; id < count; id++) {
+            Insert(*index, Find(id)->name_hash, id);
+        }
+
+        index_.store(index.get(), std::memory_order_release);
+        indices_.push_back(std::move(index));
+    }
+
+    std::mutex mutex_;
+    std::array<std::atomic<Chunk*>, max_types / chunk_size> chunks_;
+    std::atomic<uint32_t> count_{ 0 };
+    std::atomic<const NameIndex*> index_;
+    std::vector<std::unique_ptr<NameIndex>> indices_;
+};
+
+#endif // REFL_EXAMPLES_TYPE_REGISTRY_HPP
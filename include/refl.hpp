@@ -24,14 +24,17 @@
 #define REFL_INCLUDE_HPP
 
 #include <stddef.h> // size_t
+#include <cstdint>
 #include <cstring>
 #include <array>
 #include <utility> // std::move, std::forward
 #include <optional>
 #include <tuple>
 #include <type_traits>
+#include <string_view>
 #include <ostream>
 #include <sstream>
+#include <charconv> // std::to_chars
 #include <iomanip> // std::quoted
 #include <memory>
 #include <complex>
@@ -90,6 +93,39 @@ namespace refl
 #define REFL_MAKE_CONST_STRING(CString) \
     (::refl::util::detail::copy_from_unsized<::refl::util::detail::strlen(CString)>(CString))
 
+        namespace detail
+        {
+            /** The offset basis of the 64-bit FNV-1a hash. */
+            static constexpr uint64_t fnv1a_offset_basis = 14695981039346656037ull;
+
+            /** The prime of the 64-bit FNV-1a hash. */
+            static constexpr uint64_t fnv1a_prime = 1099511628211ull;
+
+            /**
+             * Computes the 64-bit FNV-1a hash of the first len characters of str.
+             */
+            constexpr uint64_t fnv1a(const char* const str, size_t len) noexcept
+            {
+                uint64_t hash = fnv1a_offset_basis;
+                for (size_t i = 0; i < len; i++) {
+                    hash = (hash ^ static_cast<unsigned char>(str[i])) * fnv1a_prime;
+                }
+                return hash;
+            }
+
+            /**
+             * Continues the 64-bit FNV-1a hash with the 8 bytes of value (least significant first,
+             * so that the result does not depend on the byte order of the platform).
+             */
+            constexpr uint64_t fnv1a_append(uint64_t hash, uint64_t value) noexcept
+            {
+                for (size_t i = 0; i < sizeof(value); i++) {
+                    hash = (hash ^ ((value >> (i * 8)) & 0xff)) * fnv1a_prime;
+                }
+                return hash;
+            }
+        } // namespace detail
+
         /**
          * Represents a compile-time string. Used in refl-cpp
          * for representing names of reflected types and members.
@@ -192,6 +228,21 @@ namespace refl
                 return const_string<NewSize>(buf);
             }
 
+            /**
+             * Returns the 64-bit FNV-1a hash of the string.
+             * The result is stable across compilers, platforms and program runs,
+             * which makes it suitable for use in wire formats and switch-based dispatch.
+             *
+             * \code{.cpp}
+             * make_const_string("").hash() -> 0xcbf29ce484222325
+             * make_const_string("a").hash() -> 0xaf63dc4c8601ec8c
+             * \endcode
+             */
+            constexpr uint64_t hash() const noexcept
+            {
+                return detail::fnv1a(data, N);
+            }
+
             /**
              * Searches the string for the first occurrence of the character and returns its position.
              *
@@ -2009,6 +2060,21 @@ namespace refl
             }
         };
 
+        /**
+         * Used to assign a field a number which identifies it independently of its name
+         * and position, as used by schema-evolvable (tag-based) serialization formats.
+         * Tags should be positive and unique within a type.
+         */
+        struct tag : public usage::field
+        {
+            const uint32_t number;
+
+            constexpr tag(uint32_t number) noexcept
+                : number(number)
+            {
+            }
+        };
+
         /**
          * Used to specify how a type should be displayed in debugging contexts.
          */
@@ -2051,6 +2117,7 @@ namespace refl
             using attr::property;
             using attr::debug;
             using attr::bases;
+            using attr::tag;
         }
     }
 
@@ -2380,6 +2447,12 @@ namespace refl
              */
             static constexpr auto name{ member::name };
 
+            /**
+             * The 64-bit FNV-1a hash of the name of the reflected member.
+             * \copydetails refl::descriptor::get_name_hash
+             */
+            static constexpr uint64_t name_hash{ name.hash() };
+
             /**
              * The attributes of the reflected member.
              * \copydetails refl::descriptor::get_attributes
@@ -2628,6 +2701,12 @@ namespace refl
              */
             static constexpr const auto name{ type_info::name };
 
+            /**
+             * The 64-bit FNV-1a hash of the name of the reflected type.
+             * \copydetails refl::descriptor::get_name_hash
+             */
+            static constexpr uint64_t name_hash{ name.hash() };
+
             /**
              * The attributes of the reflected type.
              * \copydetails refl::descriptor::get_attributes
@@ -2658,6 +2737,24 @@ namespace refl
             return d.name;
         }
 
+        /**
+         * Returns the 64-bit FNV-1a hash of the full name of the descriptor.
+         * The hash is computed at compile-time and is stable across compilers and platforms.
+         *
+         * \code{.cpp}
+         * REFL_AUTO(type(Foo), field(x))
+         *
+         * get_name_hash(reflect<Foo>()) -> make_const_string("Foo").hash()
+         * get_name_hash(get_t<0, member_list<Foo>>()) -> make_const_string("x").hash()
+         * \endcode
+         */
+        template <typename Descriptor>
+        constexpr uint64_t get_name_hash(Descriptor d) noexcept
+        {
+            static_assert(trait::is_descriptor_v<Descriptor>);
+            return d.name_hash;
+        }
+
         /**
          * Returns a const reference to the descriptor's attribute tuple.
          *
@@ -3106,6 +3203,43 @@ namespace refl
             return get_attribute<attr::property>(d);
         }
 
+        /**
+         * Checks whether T is a field descriptor marked with the tag attribute.
+         *
+         * @see refl::attr::tag
+         * @see refl::descriptor::get_tag
+         *
+         * \code{.cpp}
+         * REFL_AUTO(type(Point), field(x, tag(1)), field(y))
+         * has_tag(get_t<0, member_list<Point>>{}) -> true
+         * has_tag(get_t<1, member_list<Point>>{}) -> false
+         * \endcode
+         */
+        template <typename MemberDescriptor>
+        constexpr bool has_tag(MemberDescriptor d) noexcept
+        {
+            static_assert(trait::is_member_v<MemberDescriptor>);
+            return has_attribute<attr::tag>(d);
+        }
+
+        /**
+         * Gets the number of the tag attribute of a field.
+         *
+         * @see refl::attr::tag
+         * @see refl::descriptor::has_tag
+         *
+         * \code{.cpp}
+         * REFL_AUTO(type(Point), field(x, tag(1)), field(y))
+         * get_tag(get_t<0, member_list<Point>>{}) -> 1
+         * \endcode
+         */
+        template <typename FieldDescriptor>
+        constexpr uint32_t get_tag(FieldDescriptor d) noexcept
+        {
+            static_assert(trait::is_field_v<FieldDescriptor>);
+            return get_attribute<attr::tag>(d).number;
+        }
+
         namespace detail
         {
             struct placeholder
@@ -3255,6 +3389,14 @@ namespace refl
             return d.declarator.name + "::" + d.name;
         }
 
+        namespace detail
+        {
+            // Constant-initialized storage for the debug name of a member.
+            // Does not require a guard variable or any dynamic allocation.
+            template <typename MemberDescriptor>
+            static constexpr auto debug_name_v = descriptor::get_debug_name_const(MemberDescriptor{});
+        } // namespace detail
+
         /**
          * Returns the debug name of T. (In the form of 'declaring_type::member_name').
          * \code{.cpp}
@@ -3263,11 +3405,22 @@ namespace refl
          * \endcode
          */
         template <typename MemberDescriptor>
-        const char* get_debug_name(MemberDescriptor d)
+        constexpr const char* get_debug_name(MemberDescriptor) noexcept
+        {
+            static_assert(trait::is_member_v<MemberDescriptor>);
+            return detail::debug_name_v<MemberDescriptor>.c_str();
+        }
+
+        /**
+         * Returns the debug name of T as a std::string_view. (In the form of 'declaring_type::member_name').
+         * The view refers to a null-terminated constant string with static storage duration.
+         * @see get_debug_name
+         */
+        template <typename MemberDescriptor>
+        constexpr std::string_view get_debug_name_view(MemberDescriptor) noexcept
         {
             static_assert(trait::is_member_v<MemberDescriptor>);
-            static const std::string name(get_debug_name_const(d).str());
-            return name.c_str();
+            return { detail::debug_name_v<MemberDescriptor>.c_str(), detail::debug_name_v<MemberDescriptor>.size };
         }
 
         namespace detail
@@ -3424,6 +3577,14 @@ namespace refl
             }
         } // namespace detail
 
+        namespace detail
+        {
+            // Constant-initialized storage for the display name of a descriptor.
+            // Does not require a guard variable or any dynamic allocation.
+            template <typename Descriptor>
+            static constexpr auto display_name_v = detail::get_display_name(Descriptor{});
+        } // namespace detail
+
         /**
          * Returns the display name of T.
          * Uses the friendly_name of the property attribute, or the normalized name if no friendly_name was provided.
@@ -3450,11 +3611,10 @@ namespace refl
          * \endcode
          */
         template <typename Descriptor>
-        const char* get_display_name(Descriptor d) noexcept
+        constexpr const char* get_display_name(Descriptor) noexcept
         {
             static_assert(trait::is_descriptor_v<Descriptor>);
-            static const std::string name(detail::get_display_name(d));
-            return name.c_str();
+            return detail::display_name_v<Descriptor>.c_str();
         }
 
         /**
@@ -3469,6 +3629,18 @@ namespace refl
             return detail::get_display_name(d);
         }
 
+        /**
+         * Returns the display name of T as a std::string_view.
+         * The view refers to a null-terminated constant string with static storage duration.
+         * @see get_display_name
+         */
+        template <typename Descriptor>
+        constexpr std::string_view get_display_name_view(Descriptor) noexcept
+        {
+            static_assert(trait::is_descriptor_v<Descriptor>);
+            return { detail::display_name_v<Descriptor>.c_str(), detail::display_name_v<Descriptor>.size };
+        }
+
         /**
          * Checks if there exists a member that has the same display name as the one provied and is writable.
          * For getter methods with a property attribute, the return value will be true if there exists a
@@ -3655,6 +3827,224 @@ namespace refl
             }
         }
 
+        namespace detail
+        {
+            // The kinds of values and members which make up a fingerprint.
+            enum class fingerprint_kind : uint64_t
+            {
+                boolean = 1,
+                character,
+                signed_integer,
+                unsigned_integer,
+                floating_point,
+                enumeration,
+                pointer,
+                array,
+                recursion,
+                type,
+                field,
+                static_field,
+                function,
+                property
+            };
+
+            constexpr uint64_t fingerprint_start(fingerprint_kind kind) noexcept
+            {
+                return util::detail::fnv1a_append(util::detail::fnv1a_offset_basis, static_cast<uint64_t>(kind));
+            }
+
+            template <typename T>
+            struct is_character : std::false_type {};
+            template <> struct is_character<char> : std::true_type {};
+            template <> struct is_character<wchar_t> : std::true_type {};
+            template <> struct is_character<char16_t> : std::true_type {};
+            template <> struct is_character<char32_t> : std::true_type {};
+#ifdef __cpp_char8_t
+            template <> struct is_character<char8_t> : std::true_type {};
+#endif
+
+            // Describes C arrays and std::array, which are fingerprinted alike.
+            template <typename T>
+            struct array_extent
+            {
+                static constexpr bool value = false;
+            };
+
+            template <typename T, size_t N>
+            struct array_extent<T[N]>
+            {
+                static constexpr bool value = true;
+                static constexpr size_t extent = N;
+                typedef T element_type;
+            };
+
+            template <typename T, size_t N>
+            struct array_extent<std::array<T, N>> : array_extent<T[N]>
+            {
+            };
+
+            // The type arguments of a class template specialization (e.g. std::vector<T, Alloc>).
+            template <typename T>
+            struct template_arguments
+            {
+                typedef type_list<> type;
+            };
+
+            template <template <typename...> typename Template, typename... Args>
+            struct template_arguments<Template<Args...>>
+            {
+                typedef type_list<Args...> type;
+            };
+
+            // The position of T in Visiting (the types whose fingerprints are being computed, innermost first),
+            // or sizeof...(Visiting) if T is not there.
+            template <typename T, typename... Visiting>
+            constexpr size_t visiting_depth() noexcept
+            {
+                constexpr bool matches[]{ std::is_same_v<T, Visiting>..., true };
+                size_t depth = 0;
+                while (!matches[depth]) depth++;
+                return depth;
+            }
+
+            template <typename T, typename... Visiting>
+            constexpr uint64_t value_fingerprint() noexcept;
+
+            template <typename... Visiting, typename... Ts>
+            constexpr uint64_t append_fingerprints(uint64_t hash, type_list<Ts...>) noexcept
+            {
+                ((hash = util::detail::fnv1a_append(hash, value_fingerprint<Ts, Visiting...>())), ...);
+                return hash;
+            }
+
+            template <typename Member, typename... Visiting>
+            constexpr uint64_t member_fingerprint() noexcept
+            {
+                if constexpr (trait::is_field_v<Member>) {
+                    uint64_t hash = fingerprint_start(is_static(Member{}) ? fingerprint_kind::static_field : fingerprint_kind::field);
+                    hash = util::detail::fnv1a_append(hash, Member::name_hash);
+                    if constexpr (has_tag(Member{})) {
+                        hash = util::detail::fnv1a_append(hash, get_tag(Member{}));
+                    }
+                    return util::detail::fnv1a_append(hash, value_fingerprint<typename Member::value_type, Visiting...>());
+                }
+                else if constexpr (is_property(Member{})) {
+                    uint64_t hash = util::detail::fnv1a_append(fingerprint_start(fingerprint_kind::property), display_name_v<Member>.hash());
+                    if constexpr (is_readable(Member{})) {
+                        using value_type = trait::remove_qualifiers_t<typename Member::template return_type<const typename Member::declaring_type&>>;
+                        hash = util::detail::fnv1a_append(hash, value_fingerprint<value_type, Visiting...>());
+                    }
+                    return hash;
+                }
+                else {
+                    return util::detail::fnv1a_append(fingerprint_start(fingerprint_kind::function), Member::name_hash);
+                }
+            }
+
+            // Only the members which hold the data of an instance (non-static fields and property getters)
+            // make up the fingerprint of a type, so that adding e.g. a helper method does not change it.
+            template <typename Member>
+            constexpr bool is_fingerprinted() noexcept
+            {
+                if constexpr (trait::is_field_v<Member>) {
+                    return !is_static(Member{});
+                }
+                else {
+                    return is_property(Member{}) && is_readable(Member{});
+                }
+            }
+
+            template <typename... Visiting, typename... Members>
+            constexpr uint64_t append_member_fingerprints(uint64_t hash, type_list<Members...>) noexcept
+            {
+                ((hash = is_fingerprinted<Members>() ? util::detail::fnv1a_append(hash, member_fingerprint<Members, Visiting...>()) : hash), ...);
+                return hash;
+            }
+
+            template <typename T, typename... Visiting>
+            constexpr uint64_t value_fingerprint() noexcept
+            {
+                using type = std::remove_cv_t<T>;
+                constexpr size_t depth = visiting_depth<type, Visiting...>();
+                if constexpr (depth != sizeof...(Visiting)) {
+                    // a recursive type refers to an enclosing type by its distance
+                    return util::detail::fnv1a_append(fingerprint_start(fingerprint_kind::recursion), depth);
+                }
+                else if constexpr (std::is_arithmetic_v<type>) {
+                    // the names of the integer types are not portable (e.g. int64_t is long long on Windows)
+                    fingerprint_kind kind = std::is_same_v<type, bool> ? fingerprint_kind::boolean
+                        : is_character<type>::value ? fingerprint_kind::character
+                        : std::is_floating_point_v<type> ? fingerprint_kind::floating_point
+                        : std::is_signed_v<type> ? fingerprint_kind::signed_integer
+                        : fingerprint_kind::unsigned_integer;
+                    return util::detail::fnv1a_append(fingerprint_start(kind), sizeof(type));
+                }
+                else if constexpr (std::is_enum_v<type>) {
+                    uint64_t hash = fingerprint_start(fingerprint_kind::enumeration);
+                    if constexpr (trait::is_reflectable_v<type>) {
+                        hash = util::detail::fnv1a_append(hash, type_descriptor<type>::name_hash);
+                    }
+                    return util::detail::fnv1a_append(hash, value_fingerprint<std::underlying_type_t<type>>());
+                }
+                else if constexpr (std::is_pointer_v<type> || std::is_reference_v<type>) {
+                    using pointee = std::remove_pointer_t<std::remove_reference_t<type>>;
+                    return util::detail::fnv1a_append(fingerprint_start(fingerprint_kind::pointer), value_fingerprint<pointee, Visiting...>());
+                }
+                else if constexpr (array_extent<type>::value) {
+                    uint64_t hash = util::detail::fnv1a_append(fingerprint_start(fingerprint_kind::array), array_extent<type>::extent);
+                    return util::detail::fnv1a_append(hash, value_fingerprint<typename array_extent<type>::element_type, Visiting...>());
+                }
+                else {
+                    uint64_t hash = fingerprint_start(fingerprint_kind::type);
+                    if constexpr (trait::is_reflectable_v<type>) {
+                        hash = util::detail::fnv1a_append(hash, type_descriptor<type>::name_hash);
+                    }
+                    else if constexpr (std::is_trivially_copyable_v<type>) {
+                        hash = util::detail::fnv1a_append(hash, sizeof(type));
+                    }
+                    hash = append_fingerprints<type, Visiting...>(hash, typename template_arguments<type>::type{});
+                    if constexpr (trait::is_reflectable_v<type>) {
+                        hash = append_member_fingerprints<type, Visiting...>(hash, typename type_descriptor<type>::member_types{});
+                    }
+                    return hash;
+                }
+            }
+        } // namespace detail
+
+        /**
+         * Returns a 64-bit fingerprint of the schema of the reflected type or member, computed at compile-time.
+         * Only the members which hold data make up the fingerprint of a type: non-static fields, and
+         * properties through their getters. Two types have the same fingerprint when they have the same name
+         * and the same such members in the same order, with the same names, tags and value types (for properties,
+         * the return type of the getter). Member functions, setters and static fields are not part of it.
+         * The value types are compared recursively through their members, arithmetic types by kind (bool,
+         * character, signed, unsigned, floating-point) and size, and types which are not reflected by their
+         * template arguments (and size, if they are trivially copyable) only.
+         * The fingerprints of reflected types only depend on their reflection metadata and on the sizes of the
+         * arithmetic types, so they can be stored with serialized data and compared to that of the reading program
+         * at load time. The fingerprints of types which are not reflected (e.g. std::string) depend on their size
+         * and on the arguments of standard library templates (e.g. allocators), which can differ between standard
+         * libraries and platforms.
+         *
+         * \code{.cpp}
+         * REFL_AUTO(type(Point), field(x), field(y))
+         * REFL_AUTO(type(Line), field(from), field(to))
+         *
+         * static_assert(get_fingerprint(reflect<Line>()) != get_fingerprint(reflect<Point>()));
+         * \endcode
+         */
+        template <typename Descriptor>
+        constexpr uint64_t get_fingerprint(Descriptor) noexcept
+        {
+            static_assert(trait::is_descriptor_v<Descriptor>);
+            if constexpr (trait::is_type_v<Descriptor>) {
+                return detail::value_fingerprint<typename Descriptor::type>();
+            }
+            else {
+                return detail::member_fingerprint<Descriptor, typename Descriptor::declaring_type>();
+            }
+        }
+
     } // namespace descriptor
 
     using descriptor::member_list;
@@ -3691,98 +4081,419 @@ namespace refl
         return {};
     }
 
-#ifndef REFL_DETAIL_FORCE_EBO
-#ifdef _MSC_VER
-#define REFL_DETAIL_FORCE_EBO __declspec(empty_bases)
-#else
-#define REFL_DETAIL_FORCE_EBO
-#endif
-#endif
-
     /**
-     * @brief Contains utilities that can have runtime-overhead (like proxy, debug, invoke)
+     * @brief Contains compile-time utilities for inspecting the memory layout of reflected types.
+     *
+     * The layout is computed from the value types of the reflected non-static fields of a type, which
+     * are assumed to be reflected in declaration order. The computed offsets are those of a standard-layout
+     * type without base classes, which is_complete() checks against the actual size and alignment of the type.
      */
-    namespace runtime
+    namespace layout
     {
-        template <typename Derived, typename Target>
-        struct REFL_DETAIL_FORCE_EBO proxy;
+        /** The placement of a field within an object, as computed by fields<T>(). */
+        struct field_layout
+        {
+            /** The name of the field. */
+            const char* name;
+            /** The offset of the field from the start of the object. */
+            size_t offset;
+            /** The size of the value of the field. */
+            size_t size;
+            /** The alignment of the value of the field. */
+            size_t alignment;
+            /** The number of bytes of padding between the previous field (or the start of the object) and the field. */
+            size_t padding_before;
+        };
 
         namespace detail
         {
-            template <typename T>
-            struct get_member_info;
-
-            template <typename T, size_t N>
-            struct get_member_info<refl::function_descriptor<T, N>>
+            template <typename Member, typename = void>
+            struct is_instance_field : std::false_type
             {
-                using type = refl::detail::member_info<T, N>;
             };
 
-            template <typename T, size_t N>
-            struct get_member_info<refl::field_descriptor<T, N>>
+            template <typename Member>
+            struct is_instance_field<Member, std::enable_if_t<trait::is_field_v<Member>>>
+                : std::bool_constant<!Member::is_static>
             {
-                using type = refl::detail::member_info<T, N>;
             };
 
-            template <typename T, typename U>
-            constexpr T& static_ref_cast(U& value) noexcept
-            {
-                return static_cast<T&>(value);
-            }
+            template <typename T>
+            using fields_t = trait::filter_t<is_instance_field, member_list<T>>;
 
-            template <typename T, typename U>
-            constexpr const T& static_ref_cast(const U& value) noexcept
+            template <typename Field>
+            using value_type_t = std::remove_const_t<typename Field::value_type>;
+
+            constexpr size_t align_up(size_t offset, size_t alignment) noexcept
             {
-                return static_cast<const T&>(value);
+                return (offset + alignment - 1) / alignment * alignment;
             }
 
-            template <typename... Results>
-            constexpr type_list<Results...> get_members_skip_shadowed(type_list<>, type_list<Results...>)
+            template <typename... Fields>
+            constexpr std::array<field_layout, sizeof...(Fields)> make_fields(type_list<Fields...>) noexcept
             {
-                return {};
+                std::array<field_layout, sizeof...(Fields)> result{};
+                if constexpr (sizeof...(Fields) > 0) {
+                    const char* names[] = { Fields::name.c_str()... };
+                    size_t sizes[] = { sizeof(value_type_t<Fields>)... };
+                    size_t alignments[] = { alignof(value_type_t<Fields>)... };
+                    size_t end = 0;
+                    for (size_t i = 0; i < sizeof...(Fields); i++) {
+                        size_t offset = align_up(end, alignments[i]);
+                        result[i] = { names[i], offset, sizes[i], alignments[i], offset - end };
+                        end = offset + sizes[i];
+                    }
+                }
+                return result;
             }
 
-            template <typename Member, typename... Members, typename... Results>
-            constexpr auto get_members_skip_shadowed(type_list<Member, Members...>, type_list<Results...>)
+            // The position of each field in packed<T>: by decreasing alignment, then in order.
+            template <typename... Fields>
+            constexpr std::array<size_t, sizeof...(Fields)> packed_positions(type_list<Fields...>) noexcept
             {
-                if constexpr ((... || (Results::name == Member::name))) {
-                    return get_members_skip_shadowed(type_list<Members...>{}, type_list<Results...>{});
-                }
-                else {
-                    return get_members_skip_shadowed(type_list<Members...>{}, type_list<Results..., Member>{});
+                std::array<size_t, sizeof...(Fields)> result{};
+                if constexpr (sizeof...(Fields) > 0) {
+                    size_t alignments[] = { alignof(value_type_t<Fields>)... };
+                    for (size_t i = 0; i < sizeof...(Fields); i++) {
+                        for (size_t j = 0; j < sizeof...(Fields); j++) {
+                            result[i] += alignments[j] > alignments[i] || (alignments[j] == alignments[i] && j < i);
+                        }
+                    }
                 }
+                return result;
             }
 
-            template <typename T>
-            using members_skip_shadowed = decltype(get_members_skip_shadowed(member_list<T>{}, type_list<>{}));
-
-            /** Implements a proxy for a reflected function. */
-            template <typename Derived, typename Func>
-            struct REFL_DETAIL_FORCE_EBO function_proxy : public get_member_info<Func>::type::template remap<function_proxy<Derived, Func>>
+            // The index of the field at each position in packed<T>.
+            template <typename Fields>
+            constexpr std::array<size_t, Fields::size> packed_order() noexcept
             {
-                function_proxy()
-                {
+                constexpr auto positions = packed_positions(Fields{});
+                std::array<size_t, Fields::size> result{};
+                for (size_t i = 0; i < Fields::size; i++) {
+                    result[positions[i]] = i;
                 }
+                return result;
+            }
 
-                template <typename Self, typename... Args>
-                static constexpr decltype(auto) invoke_impl(Self&& self, Args&& ... args)
-                {
-                    return Derived::template invoke_impl<Func>(static_ref_cast<Derived>(self), std::forward<Args>(args)...);
-                }
+            /**
+             * Stores the values of Fields one after the other. Since the fields are
+             * sorted by decreasing alignment, the nesting adds no padding.
+             */
+            template <typename... Fields>
+            struct packed_storage
+            {
             };
 
-            template <typename, typename>
-            struct REFL_DETAIL_FORCE_EBO function_proxies;
-
-            /** Implements a proxy for all reflected functions. */
-            template <typename Derived, typename... Members>
-            struct REFL_DETAIL_FORCE_EBO function_proxies<Derived, type_list<Members...>> : public function_proxy<Derived, Members>...
+            template <typename Field>
+            struct packed_storage<Field>
             {
+                value_type_t<Field> value;
             };
 
-            /** Implements a proxy for a reflected field. */
-            template <typename Derived, typename Field>
-            struct REFL_DETAIL_FORCE_EBO field_proxy : public get_member_info<Field>::type::template remap<field_proxy<Derived, Field>>
+            template <typename Field, typename... Fields>
+            struct packed_storage<Field, Fields...>
+            {
+                value_type_t<Field> value;
+                packed_storage<Fields...> rest;
+            };
+
+            template <typename Fields, size_t... Idx>
+            packed_storage<trait::get_t<packed_order<Fields>()[Idx], Fields>...> make_packed_storage(std::index_sequence<Idx...>);
+
+            template <size_t Position, typename Storage>
+            constexpr auto& get_packed(Storage& storage) noexcept
+            {
+                if constexpr (Position == 0) {
+                    return storage.value;
+                }
+                else {
+                    return get_packed<Position - 1>(storage.rest);
+                }
+            }
+
+            template <typename V>
+            constexpr void copy_value(V& target, const V& source)
+            {
+                target = source;
+            }
+
+            template <typename V, size_t N>
+            constexpr void copy_value(V (&target)[N], const V (&source)[N])
+            {
+                for (size_t i = 0; i < N; i++) {
+                    copy_value(target[i], source[i]);
+                }
+            }
+        } // namespace detail
+
+        /**
+         * Returns the offset, size, alignment and preceding padding of each reflected non-static field of T,
+         * in the order in which they are reflected.
+         *
+         * \code{.cpp}
+         * struct Entry { bool valid; double value; int id; };
+         * REFL_AUTO(type(Entry), field(valid), field(value), field(id))
+         *
+         * static_assert(fields<Entry>()[1].offset == 8 && fields<Entry>()[1].padding_before == 7);
+         * \endcode
+         */
+        template <typename T>
+        constexpr auto fields() noexcept
+        {
+            return detail::make_fields(detail::fields_t<T>{});
+        }
+
+        /**
+         * Returns true if the reflected fields account for the whole of T, that is, if the layout computed
+         * by fields<T>() has the size and alignment of T. This is not the case when T has fields which are
+         * not reflected (or are reflected out of order), base classes or virtual functions.
+         */
+        template <typename T>
+        constexpr bool is_complete() noexcept
+        {
+            constexpr auto layout = fields<T>();
+            if constexpr (layout.size() == 0) {
+                return std::is_empty_v<T>;
+            }
+            else {
+                size_t alignment = 1;
+                for (const field_layout& field : layout) {
+                    alignment = field.alignment > alignment ? field.alignment : alignment;
+                }
+                const field_layout& last = layout[layout.size() - 1];
+                return alignment == alignof(T) && detail::align_up(last.offset + last.size, alignment) == sizeof(T);
+            }
+        }
+
+        /**
+         * Returns the number of bytes of T which do not belong to the value of a reflected field:
+         * the holes between fields and the padding at the end (and any fields which are not reflected).
+         */
+        template <typename T>
+        constexpr size_t padding() noexcept
+        {
+            size_t size = 0;
+            for (const field_layout& field : fields<T>()) {
+                size += field.size;
+            }
+            return std::is_empty_v<T> ? 0 : sizeof(T) - size;
+        }
+
+        /** Returns the number of bytes of padding after the last reflected field of T. */
+        template <typename T>
+        constexpr size_t tail_padding() noexcept
+        {
+            constexpr auto layout = fields<T>();
+            if constexpr (layout.size() == 0) {
+                return std::is_empty_v<T> ? 0 : sizeof(T);
+            }
+            else {
+                const field_layout& last = layout[layout.size() - 1];
+                return sizeof(T) - (last.offset + last.size);
+            }
+        }
+
+        /**
+         * Returns true if every byte of T belongs to the value of a reflected field.
+         *
+         * \code{.cpp}
+         * static_assert(refl::layout::has_no_padding<Entry>(), "Entry has padding!");
+         * \endcode
+         */
+        template <typename T>
+        constexpr bool has_no_padding() noexcept
+        {
+            return padding<T>() == 0;
+        }
+
+        /**
+         * Returns the smallest size of an object which holds the reflected fields of T, in any order.
+         * That is the size of packed<T>, which orders the fields by decreasing alignment, so that
+         * only the padding at the end remains.
+         */
+        template <typename T>
+        constexpr size_t packed_size() noexcept
+        {
+            size_t size = 0;
+            size_t alignment = 1;
+            for (const field_layout& field : fields<T>()) {
+                size += field.size;
+                alignment = field.alignment > alignment ? field.alignment : alignment;
+            }
+            return detail::align_up(size, alignment);
+        }
+
+        /**
+         * A mirror of T which stores the values of the reflected non-static fields of T by decreasing
+         * alignment, which leaves no holes between them (see packed_size<T>()). The values are accessed
+         * through the field descriptors of T.
+         *
+         * \code{.cpp}
+         * packed<Entry> p(entry);             // sizeof(p) == 16, sizeof(entry) == 24
+         * p.get(get_t<2, member_list<Entry>>{}) = 5;
+         * Entry copy = p.unpack();
+         * \endcode
+         */
+        template <typename T>
+        class packed
+        {
+        public:
+            /** The descriptors of the stored fields (in the order in which they are reflected). */
+            using fields = detail::fields_t<T>;
+
+            /** Value-initializes each field. */
+            constexpr packed() noexcept(std::is_nothrow_default_constructible_v<storage_type>)
+                : storage_{}
+            {
+            }
+
+            /** Copies the value of each reflected field of value. */
+            constexpr explicit packed(const T& value)
+                : storage_{}
+            {
+                util::for_each(fields{}, [&](auto field) {
+                    detail::copy_value(get(field), field(value));
+                });
+            }
+
+            /** Returns the value of the field (a descriptor from fields). */
+            template <typename Field>
+            constexpr auto& get(Field) noexcept
+            {
+                return detail::get_packed<position<Field>()>(storage_);
+            }
+
+            template <typename Field>
+            constexpr const auto& get(Field) const noexcept
+            {
+                return detail::get_packed<position<Field>()>(storage_);
+            }
+
+            /** Copies the value of each field to the corresponding writable field of target. */
+            constexpr void unpack(T& target) const
+            {
+                util::for_each(fields{}, [&](auto field) {
+                    if constexpr (decltype(field)::is_writable) {
+                        detail::copy_value(field(target), get(field));
+                    }
+                });
+            }
+
+            /** Returns a default-constructed T with the values of the fields. */
+            constexpr T unpack() const
+            {
+                T target{};
+                unpack(target);
+                return target;
+            }
+
+        private:
+            using storage_type = decltype(detail::make_packed_storage<fields>(std::make_index_sequence<fields::size>{}));
+
+            template <typename Field>
+            static constexpr size_t position() noexcept
+            {
+                static_assert(trait::contains_v<Field, fields>, "Field is not a non-static field of T!");
+                return detail::packed_positions(fields{})[trait::index_of_v<Field, fields>];
+            }
+
+            storage_type storage_;
+        };
+
+    } // namespace layout
+
+#ifndef REFL_DETAIL_FORCE_EBO
+#ifdef _MSC_VER
+#define REFL_DETAIL_FORCE_EBO __declspec(empty_bases)
+#else
+#define REFL_DETAIL_FORCE_EBO
+#endif
+#endif
+
+    /**
+     * @brief Contains utilities that can have runtime-overhead (like proxy, debug, invoke)
+     */
+    namespace runtime
+    {
+        template <typename Derived, typename Target>
+        struct REFL_DETAIL_FORCE_EBO proxy;
+
+        namespace detail
+        {
+            template <typename T>
+            struct get_member_info;
+
+            template <typename T, size_t N>
+            struct get_member_info<refl::function_descriptor<T, N>>
+            {
+                using type = refl::detail::member_info<T, N>;
+            };
+
+            template <typename T, size_t N>
+            struct get_member_info<refl::field_descriptor<T, N>>
+            {
+                using type = refl::detail::member_info<T, N>;
+            };
+
+            template <typename T, typename U>
+            constexpr T& static_ref_cast(U& value) noexcept
+            {
+                return static_cast<T&>(value);
+            }
+
+            template <typename T, typename U>
+            constexpr const T& static_ref_cast(const U& value) noexcept
+            {
+                return static_cast<const T&>(value);
+            }
+
+            template <typename... Results>
+            constexpr type_list<Results...> get_members_skip_shadowed(type_list<>, type_list<Results...>)
+            {
+                return {};
+            }
+
+            template <typename Member, typename... Members, typename... Results>
+            constexpr auto get_members_skip_shadowed(type_list<Member, Members...>, type_list<Results...>)
+            {
+                if constexpr ((... || (Results::name == Member::name))) {
+                    return get_members_skip_shadowed(type_list<Members...>{}, type_list<Results...>{});
+                }
+                else {
+                    return get_members_skip_shadowed(type_list<Members...>{}, type_list<Results..., Member>{});
+                }
+            }
+
+            template <typename T>
+            using members_skip_shadowed = decltype(get_members_skip_shadowed(member_list<T>{}, type_list<>{}));
+
+            /** Implements a proxy for a reflected function. */
+            template <typename Derived, typename Func>
+            struct REFL_DETAIL_FORCE_EBO function_proxy : public get_member_info<Func>::type::template remap<function_proxy<Derived, Func>>
+            {
+                function_proxy()
+                {
+                }
+
+                template <typename Self, typename... Args>
+                static constexpr decltype(auto) invoke_impl(Self&& self, Args&& ... args)
+                {
+                    return Derived::template invoke_impl<Func>(static_ref_cast<Derived>(self), std::forward<Args>(args)...);
+                }
+            };
+
+            template <typename, typename>
+            struct REFL_DETAIL_FORCE_EBO function_proxies;
+
+            /** Implements a proxy for all reflected functions. */
+            template <typename Derived, typename... Members>
+            struct REFL_DETAIL_FORCE_EBO function_proxies<Derived, type_list<Members...>> : public function_proxy<Derived, Members>...
+            {
+            };
+
+            /** Implements a proxy for a reflected field. */
+            template <typename Derived, typename Field>
+            struct REFL_DETAIL_FORCE_EBO field_proxy : public get_member_info<Field>::type::template remap<field_proxy<Derived, Field>>
             {
                 field_proxy()
                 {
@@ -4090,49 +4801,893 @@ namespace refl
         }
 
         /**
-         * Invokes the specified member with the provided arguments.
-         * When used with a member that is a field, the function gets or sets the value of the field.
-         * The list of members is initially filtered by the type of the arguments provided.
-         * THe filtered list is then searched at runtime by member name for the specified member
-         * and that member is then invoked by operator(). If no match is found,
-         * an std::runtime_error is thrown.
+         * Limits the output of debug_stream.
          */
-        template <typename U, typename T, typename... Args>
-        U invoke(T&& target, const char* name, Args&&... args)
+        struct debug_limits
         {
-            using type = std::remove_reference_t<T>;
-            static_assert(refl::trait::is_reflectable_v<type>, "Unsupported type!");
-            typedef type_descriptor<type> type_descriptor;
+            /** The maximum number of elements printed for each container. The rest are replaced by an ellipsis. */
+            size_t max_elements = static_cast<size_t>(-1);
+            /** The maximum number of bytes passed to the sink. When exceeded, the output is cut short and ends with an ellipsis. */
+            size_t max_bytes = static_cast<size_t>(-1);
+            /** The size of the chunks passed to the sink (only the last chunk can be smaller). */
+            size_t chunk_size = 4096;
+        };
+
+        namespace detail
+        {
+            template <typename T>
+            struct is_char_string : std::false_type {};
 
-            std::conditional_t<std::is_void_v<U>, bool, std::optional<U>> result{};
+            template <typename Traits, typename Allocator>
+            struct is_char_string<std::basic_string<char, Traits, Allocator>> : std::true_type {};
 
-            for_each(type_descriptor::members, [&](auto member) {
-                using member_t = decltype(member);
-                if (result) return;
+            template <typename Traits>
+            struct is_char_string<std::basic_string_view<char, Traits>> : std::true_type {};
 
-                if constexpr (std::is_invocable_r_v<U, decltype(member), T, Args...>) {
-                    if constexpr (trait::is_member_v<member_t>) {
-                        if (std::strcmp(member.name.c_str(), name) == 0) {
-                            if constexpr (std::is_void_v<U>) {
-                                member(target, std::forward<Args>(args)...);
-                                result = true;
-                            }
-                            else {
-                                result.emplace(member(target, std::forward<Args>(args)...));
-                            }
-                        }
+            // The constant fragments written by debug_to, rendered at compile-time.
+            template <typename T>
+            static constexpr auto debug_type_prefix_v = type_descriptor<T>::name + make_const_string(" { ");
+
+            template <typename MemberDescriptor>
+            static constexpr auto debug_member_prefix_v = descriptor::get_display_name_const(MemberDescriptor{}) + make_const_string(" = ");
+
+            template <typename Buffer>
+            void buffer_append(Buffer& buffer, const char* str, size_t len)
+            {
+                buffer.insert(buffer.end(), str, str + len);
+            }
+
+            template <typename Buffer, size_t N>
+            void buffer_append(Buffer& buffer, const const_string<N>& str)
+            {
+                buffer_append(buffer, str.data, N);
+            }
+
+            template <typename Buffer>
+            void buffer_append(Buffer& buffer, char ch)
+            {
+                buffer.push_back(ch);
+            }
+
+            template <typename Buffer>
+            void buffer_indent(Buffer& buffer, int depth)
+            {
+                static constexpr char spaces[] = "                                ";
+                for (size_t count = depth > 0 ? depth * 4 : 0; count > 0;) {
+                    size_t chunk = count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+                    buffer_append(buffer, spaces, chunk);
+                    count -= chunk;
+                }
+            }
+
+            /** Writes the result of a function taking an std::ostream (used for debug<F> and operator<<). */
+            template <typename Buffer, typename F>
+            void buffer_append_streamed(Buffer& buffer, F&& write)
+            {
+                std::basic_ostringstream<char> ss;
+                write(ss);
+                const auto& str = ss.str();
+                buffer_append(buffer, str.data(), str.size());
+            }
+
+            template <typename Buffer, typename T>
+            void buffer_append_number(Buffer& buffer, T value)
+            {
+                if constexpr (std::is_floating_point_v<T>) {
+#ifdef __cpp_lib_to_chars
+                    // %g with the default precision of std::ostream
+                    char str[64];
+                    auto result = std::to_chars(str, str + sizeof(str), value, std::chars_format::general, 6);
+                    buffer_append(buffer, str, static_cast<size_t>(result.ptr - str));
+#else
+                    buffer_append_streamed(buffer, [&](auto& os) { os << value; });
+#endif
+                }
+                else {
+                    char str[32];
+                    auto result = std::to_chars(str, str + sizeof(str), value);
+                    buffer_append(buffer, str, static_cast<size_t>(result.ptr - str));
+                }
+            }
+
+            /** Same output as std::quoted. Only the quotes and the escaped characters are written separately. */
+            template <typename Buffer>
+            void buffer_append_quoted(Buffer& buffer, std::string_view str)
+            {
+                buffer_append(buffer, '"');
+                size_t run = 0;
+                for (size_t i = 0; i < str.size(); i++) {
+                    if (str[i] == '"' || str[i] == '\\') {
+                        buffer_append(buffer, str.data() + run, i - run);
+                        buffer_append(buffer, '\\');
+                        run = i;
                     }
                 }
-            });
+                buffer_append(buffer, str.data() + run, str.size() - run);
+                buffer_append(buffer, '"');
+            }
 
-            if (!result) {
-                throw std::runtime_error(std::string("The member ")
-                    + type_descriptor::name.str() + "::" + name
-                    + " is not compatible with the provided parameters or return type, is not reflected or does not exist!");
+            /** Whether a container should stop printing elements after count elements. */
+            template <typename Buffer>
+            constexpr bool buffer_limit_reached(const Buffer&, size_t) noexcept
+            {
+                return false;
             }
-            if constexpr (!std::is_void_v<U>) {
-                return std::move(*result);
+
+            /**
+             * The buffer used by debug_stream. Collects the output in a single chunk
+             * which is passed to the sink whenever it fills up and drops everything
+             * past the byte limit.
+             */
+            template <typename Sink>
+            class debug_stream_buffer
+            {
+            public:
+
+                debug_stream_buffer(Sink& sink, const debug_limits& limits)
+                    : sink_(sink)
+                    , limits_(limits)
+                    , chunk_size_(limits.chunk_size > 0 ? limits.chunk_size : 1)
+                    , chunk_(new char[chunk_size_])
+                {
+                }
+
+                void write(const char* str, size_t len)
+                {
+                    if (len > limits_.max_bytes - written_) {
+                        len = limits_.max_bytes - written_;
+                        cut_ = true;
+                    }
+                    written_ += len;
+                    write_unbounded(str, len);
+                }
+
+                bool limit_reached(size_t count) noexcept
+                {
+                    if (count >= limits_.max_elements) {
+                        elided_ = true;
+                        return true;
+                    }
+                    return written_ >= limits_.max_bytes;
+                }
+
+                /** Writes the final ellipsis (if needed) and the last chunk. Returns whether the output is complete. */
+                bool finish()
+                {
+                    if (cut_) {
+                        write_unbounded("...", 3);
+                    }
+                    if (used_ > 0) {
+                        sink_(static_cast<const char*>(chunk_.get()), used_);
+                        used_ = 0;
+                    }
+                    return !cut_ && !elided_;
+                }
+
+            private:
+
+                void write_unbounded(const char* str, size_t len)
+                {
+                    while (len > 0) {
+                        size_t count = len < chunk_size_ - used_ ? len : chunk_size_ - used_;
+                        std::memcpy(chunk_.get() + used_, str, count);
+                        used_ += count;
+                        str += count;
+                        len -= count;
+                        if (used_ == chunk_size_) {
+                            sink_(static_cast<const char*>(chunk_.get()), used_);
+                            used_ = 0;
+                        }
+                    }
+                }
+
+                Sink& sink_;
+                debug_limits limits_;
+                size_t chunk_size_;
+                std::unique_ptr<char[]> chunk_;
+                size_t used_{ 0 };
+                size_t written_{ 0 };
+                bool cut_{ false };
+                bool elided_{ false };
+            };
+
+            template <typename Sink>
+            void buffer_append(debug_stream_buffer<Sink>& buffer, const char* str, size_t len)
+            {
+                buffer.write(str, len);
+            }
+
+            template <typename Sink>
+            void buffer_append(debug_stream_buffer<Sink>& buffer, char ch)
+            {
+                buffer.write(&ch, 1);
+            }
+
+            template <typename Sink>
+            bool buffer_limit_reached(debug_stream_buffer<Sink>& buffer, size_t count) noexcept
+            {
+                return buffer.limit_reached(count);
+            }
+
+            template <typename Buffer, typename T>
+            void debug_to_impl(Buffer& buffer, const T& value, [[maybe_unused]] int depth);
+
+            template <typename Buffer, typename T>
+            void debug_to_detailed(Buffer& buffer, const T& value, int depth)
+            {
+                using type_descriptor = type_descriptor<T>;
+                bool compact = depth == -1;
+                buffer_append(buffer, debug_type_prefix_v<T>);
+                if (!compact) buffer_append(buffer, '\n');
+
+                constexpr auto readable_members = filter(type_descriptor::members, [](auto member) { return is_readable(member); });
+                for_each(readable_members, [&](auto member, [[maybe_unused]] auto index) {
+                    int new_depth = next_depth(depth);
+
+                    buffer_indent(buffer, new_depth);
+                    buffer_append(buffer, debug_member_prefix_v<decltype(member)>);
+
+                    if constexpr (util::contains_instance<attr::debug>(member.attributes)) {
+                        auto debug_attr = util::get_instance<attr::debug>(member.attributes);
+                        buffer_append_streamed(buffer, [&](auto& os) { debug_attr.write(os, value); });
+                    }
+                    else {
+                        debug_to_impl(buffer, member(value), new_depth);
+                    }
+
+                    if (!compact || index + 1 != readable_members.size) {
+                        buffer_append(buffer, ", ", 2);
+                    }
+                    if (!compact) {
+                        buffer_indent(buffer, depth);
+                        buffer_append(buffer, '\n');
+                    }
+                });
+
+                if (compact) buffer_append(buffer, ' ');
+                buffer_indent(buffer, depth);
+                buffer_append(buffer, '}');
+            }
+
+            template <typename Buffer, typename T>
+            void debug_to_reflectable(Buffer& buffer, const T& value, [[maybe_unused]] int depth)
+            {
+                using type_descriptor = type_descriptor<T>;
+                // the standard types supported out-of-the-box are written directly
+                if constexpr (is_char_string<T>::value) {
+                    std::string_view str(value.data(), value.size());
+                    if constexpr (std::is_same_v<T, std::basic_string_view<char, typename T::traits_type>>) {
+                        if (!str.empty() && !str.back()) {
+                            // same as write_basic_string_view (strings are written in full)
+                            str = str.substr(0, str.find('\0'));
+                        }
+                    }
+                    buffer_append_quoted(buffer, str);
+                }
+                else if constexpr (trait::is_instance_of_v<std::tuple, T> || trait::is_instance_of_v<std::pair, T>) {
+                    buffer_append(buffer, '(');
+                    std::apply([&](const auto&... elements) {
+                        int index = 0;
+                        ((index++ != 0 ? buffer_append(buffer, ", ", 2) : void(), debug_to_impl(buffer, elements, 0)), ...);
+                    }, value);
+                    buffer_append(buffer, ')');
+                }
+                else if constexpr (trait::is_instance_of_v<std::unique_ptr, T> || trait::is_instance_of_v<std::shared_ptr, T>) {
+                    debug_to_impl(buffer, value.get(), -1);
+                }
+                else if constexpr (trait::is_instance_of_v<std::complex, T>) {
+                    debug_to_impl(buffer, value.real(), 0);
+                    buffer_append(buffer, '+');
+                    debug_to_impl(buffer, value.imag(), 0);
+                    buffer_append(buffer, 'i');
+                }
+                else if constexpr (trait::contains_instance_v<attr::debug, typename type_descriptor::attribute_types>) {
+                    auto debug_attr = util::get_instance<attr::debug>(type_descriptor::attributes);
+                    buffer_append_streamed(buffer, [&](auto& os) { debug_attr.write(os, value); });
+                }
+                else if constexpr (detail::is_ostream_printable_v<char, T>) {
+                    buffer_append_streamed(buffer, [&](auto& os) { os << value; });
+                }
+                else {
+                    debug_to_detailed(buffer, value, depth);
+                }
+            }
+
+            template <typename Buffer, typename T>
+            void debug_to_container(Buffer& buffer, const T& value, int depth)
+            {
+                bool compact = depth == -1;
+                buffer_append(buffer, '[');
+
+                auto end = value.end();
+                size_t count = 0;
+                for (auto it = value.begin(); it != end; ++it, ++count)
+                {
+                    if (!compact) buffer_append(buffer, '\n');
+                    int new_depth = next_depth(depth);
+                    buffer_indent(buffer, new_depth);
+
+                    if (buffer_limit_reached(buffer, count)) {
+                        buffer_append(buffer, "...", 3);
+                        if (!compact) buffer_append(buffer, '\n');
+                        break;
+                    }
+
+                    debug_to_impl(buffer, *it, new_depth);
+                    if (std::next(it, 1) != end) {
+                        buffer_append(buffer, ", ", 2);
+                    }
+                    else if (!compact) {
+                        buffer_append(buffer, '\n');
+                    }
+                }
+
+                buffer_indent(buffer, depth);
+                buffer_append(buffer, ']');
+            }
+
+            // Mirrors debug_impl, but only falls back to an std::ostream for user-provided printing functions.
+            template <typename Buffer, typename T>
+            void debug_to_impl(Buffer& buffer, const T& value, [[maybe_unused]] int depth)
+            {
+                using no_pointer_t = std::remove_pointer_t<T>;
+
+                if constexpr (std::is_same_v<bool, T>) {
+                    if (value) buffer_append(buffer, "true", 4);
+                    else buffer_append(buffer, "false", 5);
+                }
+                else if constexpr (std::is_pointer_v<T> && !std::is_void_v<no_pointer_t> && trait::is_reflectable_v<no_pointer_t>) {
+                    if (value == nullptr) {
+                        buffer_append(buffer, "nullptr", 7);
+                    }
+                    else {
+                        buffer_append(buffer, '&');
+                        debug_to_impl(buffer, *value, -1);
+                    }
+                }
+                else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+                    buffer_append(buffer, static_cast<char>(value));
+                }
+                else if constexpr (std::is_floating_point_v<T>
+                    || (std::is_integral_v<T> && !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>)) {
+                    buffer_append_number(buffer, value);
+                }
+                else if constexpr (trait::is_reflectable_v<T>) {
+                    debug_to_reflectable(buffer, value, depth);
+                }
+                else if constexpr (detail::is_ostream_printable_v<char, T>) {
+                    buffer_append_streamed(buffer, [&](auto& os) { os << value; });
+                }
+                else if constexpr (trait::is_container_v<T>) {
+                    debug_to_container(buffer, value, depth);
+                }
+                else {
+                    buffer_append(buffer, "(not printable)", 15);
+                }
+            }
+        }
+
+        /**
+         * Appends the debug representation of value to a growable contiguous char buffer
+         * (std::string, std::vector<char> or any other container with insert(end, first, last) and push_back).
+         * Produces the same output as debug/debug_str, but writes numbers with std::to_chars and copies
+         * type names, field names, separators and braces in bulk instead of going through an std::ostream.
+         * Only the functions specified by a debug<F> attribute and types which are printable
+         * solely through operator<<(std::ostream&, T) are still written through an std::ostream.
+         * Takes an optional arguments specifying whether to print a compact representation.
+         * The compact representation contains no newlines.
+         *
+         * \code{.cpp}
+         * std::string buffer;
+         * for (const auto& point : points) {
+         *     buffer.clear();
+         *     debug_to(buffer, point, true);
+         *     log(buffer);
+         * }
+         * \endcode
+         */
+        template <typename Buffer, typename T>
+        void debug_to(Buffer& buffer, const T& value, bool compact = false)
+        {
+            static_assert(std::is_same_v<typename Buffer::value_type, char>, "debug_to only supports char buffers!");
+            static_assert(trait::is_reflectable_v<T> || trait::is_container_v<T> || detail::is_ostream_printable_v<char, T>,
+                "Type is not reflectable, not a container of reflectable types and does not support operator<<(std::ostream&, T)!");
+
+            detail::debug_to_impl(buffer, value, compact ? -1 : 0);
+        }
+
+        /**
+         * Writes the debug representation of value to sink in chunks of limits.chunk_size bytes,
+         * by calling sink(const char* data, size_t size) for each chunk.
+         * Uses the same format as debug_to, but containers stop after limits.max_elements elements
+         * and the whole output stops after limits.max_bytes bytes (followed by an ellipsis).
+         * Traversal stops as soon as a limit is reached, and no memory proportional to the size of
+         * value is allocated (except by debug<F> attributes and operator<< overloads), so even
+         * huge containers can be dumped safely.
+         * Returns true when the complete representation was written.
+         *
+         * \code{.cpp}
+         * debug_limits limits;
+         * limits.max_elements = 100;
+         * limits.max_bytes = 1 << 20;
+         * debug_stream([](const char* data, size_t size) { fwrite(data, 1, size, stderr); }, entities, limits);
+         * \endcode
+         */
+        template <typename Sink, typename T>
+        bool debug_stream(Sink&& sink, const T& value, const debug_limits& limits = {}, bool compact = false)
+        {
+            static_assert(trait::is_reflectable_v<T> || trait::is_container_v<T> || detail::is_ostream_printable_v<char, T>,
+                "Type is not reflectable, not a container of reflectable types and does not support operator<<(std::ostream&, T)!");
+
+            detail::debug_stream_buffer<std::remove_reference_t<Sink>> buffer(sink, limits);
+            detail::debug_to_impl(buffer, value, compact ? -1 : 0);
+            return buffer.finish();
+        }
+
+        namespace detail
+        {
+            /** The finalizer of MurmurHash3. Used to derive bucket and slot indices from a name hash. */
+            constexpr uint64_t mix_hash(uint64_t h) noexcept
+            {
+                h ^= h >> 33;
+                h *= 0xff51afd7ed558ccdull;
+                h ^= h >> 33;
+                h *= 0xc4ceb9fe1a85ec53ull;
+                h ^= h >> 33;
+                return h;
+            }
+
+            constexpr size_t next_pow2(size_t n) noexcept
+            {
+                size_t result = 1;
+                while (result < n) {
+                    result <<= 1;
+                }
+                return result;
+            }
+
+            struct member_name_info
+            {
+                const char* data;
+                size_t size;
+                uint64_t hash;
+            };
+
+            template <typename Member>
+            constexpr member_name_info make_member_name_info() noexcept
+            {
+                return { Member::name.c_str(), Member::name.size, Member::name_hash };
+            }
+
+            template <typename... Members>
+            constexpr std::array<member_name_info, sizeof...(Members)> make_member_name_infos(type_list<Members...>) noexcept
+            {
+                return { make_member_name_info<Members>()... };
+            }
+
+            constexpr bool names_equal(const member_name_info& a, const member_name_info& b) noexcept
+            {
+                if (a.hash != b.hash || a.size != b.size) {
+                    return false;
+                }
+                for (size_t i = 0; i < a.size; i++) {
+                    if (a.data[i] != b.data[i]) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * A perfect hash table over the distinct member names of a type, built by the
+             * hash-and-displace method: the name hash selects a bucket, and each bucket stores
+             * the displacement that sends all of its names to otherwise unoccupied slots.
+             */
+            template <size_t N, size_t M>
+            struct perfect_hash_layout
+            {
+                static constexpr size_t npos = static_cast<size_t>(-1);
+
+                /** For each member, the index of the next member with the same name (or npos). */
+                std::array<size_t, N> next{};
+                /** The displacement of each bucket. */
+                std::array<uint32_t, M> seeds{};
+                /** The index of the first member with the name that hashes to the slot (or npos). */
+                std::array<size_t, M> slots{};
+                /** Whether a displacement was found for every bucket. */
+                bool complete = true;
+
+                static constexpr size_t bucket_of(uint64_t hash) noexcept
+                {
+                    return static_cast<size_t>(mix_hash(hash) & (M - 1));
+                }
+
+                static constexpr size_t slot_of(uint64_t hash, uint32_t seed) noexcept
+                {
+                    return static_cast<size_t>(mix_hash(hash + seed * 0x9e3779b97f4a7c15ull) & (M - 1));
+                }
+            };
+
+            template <size_t N>
+            constexpr size_t count_unique_names(const std::array<member_name_info, N>& names) noexcept
+            {
+                size_t count = 0;
+                for (size_t i = 0; i < N; i++) {
+                    bool seen = false;
+                    for (size_t j = 0; j < i && !seen; j++) {
+                        seen = names_equal(names[i], names[j]);
+                    }
+                    count += seen ? 0 : 1;
+                }
+                return count;
+            }
+
+            template <size_t M, size_t N>
+            constexpr perfect_hash_layout<N, M> make_perfect_hash_layout(const std::array<member_name_info, N>& names) noexcept
+            {
+                using layout_type = perfect_hash_layout<N, M>;
+                constexpr size_t npos = layout_type::npos;
+                constexpr uint32_t max_seed = 1u << 16;
+
+                layout_type layout{};
+                // Only the first member with a given name gets a slot, the others are chained via next.
+                std::array<bool, N> is_first{};
+                std::array<size_t, M> bucket_sizes{};
+                size_t max_bucket_size = 0;
+
+                for (size_t i = 0; i < N; i++) {
+                    layout.next[i] = npos;
+                    is_first[i] = true;
+                    for (size_t j = i; j-- > 0;) {
+                        if (names_equal(names[i], names[j])) {
+                            is_first[i] = false;
+                            layout.next[j] = layout.next[j] == npos ? i : layout.next[j];
+                            break;
+                        }
+                    }
+                    if (is_first[i]) {
+                        size_t size = ++bucket_sizes[layout_type::bucket_of(names[i].hash)];
+                        max_bucket_size = size > max_bucket_size ? size : max_bucket_size;
+                    }
+                }
+
+                for (size_t i = 0; i < M; i++) {
+                    layout.slots[i] = npos;
+                }
+
+                // Place the largest buckets first, while most of the slots are still free.
+                std::array<size_t, N> placed{};
+                for (size_t size = max_bucket_size; size > 0; size--) {
+                    for (size_t bucket = 0; bucket < M; bucket++) {
+                        if (bucket_sizes[bucket] != size) {
+                            continue;
+                        }
+
+                        bool found = false;
+                        for (uint32_t seed = 0; seed < max_seed && !found; seed++) {
+                            size_t placed_count = 0;
+                            found = true;
+                            for (size_t i = 0; i < N && found; i++) {
+                                if (!is_first[i] || layout_type::bucket_of(names[i].hash) != bucket) {
+                                    continue;
+                                }
+                                size_t slot = layout_type::slot_of(names[i].hash, seed);
+                                found = layout.slots[slot] == npos;
+                                for (size_t j = 0; j < placed_count && found; j++) {
+                                    found = layout_type::slot_of(names[placed[j]].hash, seed) != slot;
+                                }
+                                placed[placed_count++] = i;
+                            }
+
+                            if (found) {
+                                layout.seeds[bucket] = seed;
+                                for (size_t j = 0; j < placed_count; j++) {
+                                    layout.slots[layout_type::slot_of(names[placed[j]].hash, seed)] = placed[j];
+                                }
+                            }
+                        }
+                        layout.complete = layout.complete && found;
+                    }
+                }
+
+                return layout;
+            }
+
+            /**
+             * A compile-time perfect hash table mapping the names of the members of T
+             * to their indices in member_list<T>. A lookup hashes the name once and
+             * compares it against a single candidate.
+             */
+            template <typename T>
+            struct member_name_table
+            {
+                static constexpr size_t npos = static_cast<size_t>(-1);
+
+                static constexpr std::array<member_name_info, member_list<T>::size> names{
+                    make_member_name_infos(member_list<T>{}) };
+
+                static constexpr size_t unique_count = count_unique_names(names);
+
+                static constexpr size_t table_size = next_pow2(unique_count);
+
+                static constexpr auto layout = make_perfect_hash_layout<table_size>(names);
+
+                static_assert(layout.complete, "Could not build a perfect hash table for the member names of this type!");
+
+                /**
+                 * Returns the index of the first member with the specified name, or npos if there is no such member.
+                 */
+                static size_t find(const char* name) noexcept
+                {
+                    uint64_t hash = util::detail::fnv1a_offset_basis;
+                    size_t size = 0;
+                    for (; name[size]; size++) {
+                        hash = (hash ^ static_cast<unsigned char>(name[size])) * util::detail::fnv1a_prime;
+                    }
+                    return find(name, size, hash);
+                }
+
+                /**
+                 * Returns the index of the first member with the specified name, or npos if there is no such member.
+                 * The hash must be the FNV-1a hash of the first size characters of name.
+                 */
+                static size_t find(const char* name, size_t size, uint64_t hash) noexcept
+                {
+                    if constexpr (unique_count == 0) {
+                        return npos;
+                    }
+                    else {
+                        size_t index = layout.slots[layout.slot_of(hash, layout.seeds[layout.bucket_of(hash)])];
+                        if (index != npos && names[index].size == size && std::memcmp(names[index].data, name, size) == 0) {
+                            return index;
+                        }
+                        return npos;
+                    }
+                }
+            };
+
+            /**
+             * Provides a jump table from member index to a function which invokes
+             * the first member with that name which is compatible with U(T, Args...).
+             */
+            template <typename U, typename T, typename... Args>
+            struct invoke_dispatch
+            {
+                using type = std::remove_reference_t<T>;
+                using result_type = std::conditional_t<std::is_void_v<U>, bool, std::optional<U>>;
+                using table = member_name_table<type>;
+                using thunk_type = void(*)(result_type&, type&, Args&&...);
+
+                template <size_t I>
+                static void invoke_member(result_type& result, type& target, Args&&... args)
+                {
+                    using member_t = trait::get_t<I, member_list<type>>;
+                    constexpr member_t member{};
+
+                    if constexpr (std::is_invocable_r_v<U, member_t, T, Args...>) {
+                        if constexpr (std::is_void_v<U>) {
+                            member(target, std::forward<Args>(args)...);
+                            result = true;
+                        }
+                        else {
+                            result.emplace(member(target, std::forward<Args>(args)...));
+                        }
+                    }
+                    else if constexpr (table::layout.next[I] != table::npos) {
+                        // Try the next member (e.g. a shadowed base member) with the same name.
+                        invoke_member<table::layout.next[I]>(result, target, std::forward<Args>(args)...);
+                    }
+                    else {
+                        util::ignore(member, target, args...);
+                    }
+                }
+
+                template <size_t... Idx>
+                static constexpr std::array<thunk_type, sizeof...(Idx)> make_thunks(std::index_sequence<Idx...>) noexcept
+                {
+                    return { &invoke_member<Idx>... };
+                }
+
+                static constexpr std::array<thunk_type, member_list<type>::size> thunks{
+                    make_thunks(std::make_index_sequence<member_list<type>::size>{}) };
+            };
+        } // namespace detail
+
+        /**
+         * Invokes the specified member with the provided arguments.
+         * When used with a member that is a field, the function gets or sets the value of the field.
+         * The member is looked up by name in a perfect hash table built at compile-time
+         * and is then invoked by operator(). When several members share the name, the first one
+         * compatible with the types of the arguments provided and the return type is used.
+         * If no match is found, an std::runtime_error is thrown.
+         */
+        template <typename U, typename T, typename... Args>
+        U invoke(T&& target, const char* name, Args&&... args)
+        {
+            using type = std::remove_reference_t<T>;
+            static_assert(refl::trait::is_reflectable_v<type>, "Unsupported type!");
+            typedef type_descriptor<type> type_descriptor;
+            using dispatch = detail::invoke_dispatch<U, T, Args...>;
+
+            typename dispatch::result_type result{};
+
+            size_t index = dispatch::table::find(name);
+            if (index != dispatch::table::npos) {
+                dispatch::thunks[index](result, target, std::forward<Args>(args)...);
+            }
+
+            if (!result) {
+                throw std::runtime_error(std::string("The member ")
+                    + type_descriptor::name.str() + "::" + name
+                    + " is not compatible with the provided parameters or return type, is not reflected or does not exist!");
+            }
+            if constexpr (!std::is_void_v<U>) {
+                return std::move(*result);
+            }
+        }
+
+        /**
+         * Specifies the kind of member a member_handle refers to.
+         */
+        enum class member_kind : uint8_t
+        {
+            /** The handle does not refer to any member. */
+            none,
+            /** The handle refers to a reflected field. */
+            field,
+            /** The handle refers to a reflected function. */
+            function,
+        };
+
+        /**
+         * A small, trivially-copyable handle to a member of T, as returned by find_member.
+         * Handles can be stored and then used with visit_member to reach
+         * the member without any further string operations.
+         */
+        template <typename T>
+        class member_handle
+        {
+        public:
+
+            /** The index used by handles which do not refer to any member. */
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            /**
+             * Creates a handle which does not refer to any member.
+             */
+            constexpr member_handle() noexcept
+                : index_(npos), kind_(member_kind::none)
+            {
+            }
+
+            /**
+             * Creates a handle to the member at the specified index in member_list<T>.
+             */
+            constexpr member_handle(size_t index, member_kind kind) noexcept
+                : index_(index), kind_(kind)
+            {
+            }
+
+            /** Returns the index of the member in member_list<T>. */
+            constexpr size_t index() const noexcept
+            {
+                return index_;
+            }
+
+            /** Returns the kind of the member. */
+            constexpr member_kind kind() const noexcept
+            {
+                return kind_;
+            }
+
+            /** Returns true if the handle refers to a member. */
+            explicit constexpr operator bool() const noexcept
+            {
+                return index_ != npos;
+            }
+
+            constexpr bool operator==(const member_handle& other) const noexcept
+            {
+                return index_ == other.index_ && kind_ == other.kind_;
+            }
+
+            constexpr bool operator!=(const member_handle& other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+        private:
+
+            size_t index_;
+            member_kind kind_;
+        };
+
+        namespace detail
+        {
+            template <typename T, size_t... Idx>
+            constexpr std::array<member_kind, sizeof...(Idx)> make_member_kinds(std::index_sequence<Idx...>) noexcept
+            {
+                return { (trait::is_field_v<trait::get_t<Idx, member_list<T>>> ? member_kind::field : member_kind::function)... };
+            }
+
+            template <typename T>
+            static constexpr auto member_kinds = make_member_kinds<T>(std::make_index_sequence<member_list<T>::size>{});
+
+            /**
+             * Provides a jump table from member index to a function which
+             * calls the visitor with the descriptor of that member.
+             */
+            template <typename T, typename F>
+            struct visit_dispatch
+            {
+                using type = std::remove_cv_t<T>;
+                using result_type = decltype(std::declval<F&>()(trait::get_t<0, member_list<type>>{}, std::declval<T&>()));
+                using thunk_type = result_type(*)(T&, F&);
+
+                template <size_t I>
+                static result_type visit_member(T& target, F& f)
+                {
+                    using member_t = trait::get_t<I, member_list<type>>;
+                    static_assert(std::is_same_v<decltype(f(member_t{}, target)), result_type>,
+                        "The visitor must return the same type for all members!");
+                    return f(member_t{}, target);
+                }
+
+                template <size_t... Idx>
+                static constexpr std::array<thunk_type, sizeof...(Idx)> make_thunks(std::index_sequence<Idx...>) noexcept
+                {
+                    return { &visit_member<Idx>... };
+                }
+
+                static constexpr std::array<thunk_type, member_list<type>::size> thunks{
+                    make_thunks(std::make_index_sequence<member_list<type>::size>{}) };
+            };
+        } // namespace detail
+
+        /**
+         * Looks up a member of T by name and returns a handle to it.
+         * The lookup uses the perfect hash table which runtime::invoke uses.
+         * When several members share the name, the handle refers to the first one in member_list<T>.
+         * If there is no such member, the returned handle evaluates to false.
+         *
+         * \code{.cpp}
+         * auto handle = find_member<Point>("x");
+         * visit_member(pt, handle, [](auto member, auto& target) { ... });
+         * \endcode
+         */
+        template <typename T>
+        member_handle<T> find_member(std::string_view name) noexcept
+        {
+            static_assert(std::is_same_v<T, std::remove_cv_t<T>>, "find_member expects an unqualified type!");
+            static_assert(refl::trait::is_reflectable_v<T>, "Unsupported type!");
+            using table = detail::member_name_table<T>;
+
+            size_t index = table::find(name.data(), name.size(), util::detail::fnv1a(name.data(), name.size()));
+            if (index == table::npos) {
+                return {};
+            }
+            return { index, detail::member_kinds<T>[index] };
+        }
+
+        /**
+         * Calls f(member, target), where member is the descriptor of the member referred to by the handle.
+         * The member is reached through a jump table without any string operations.
+         * f must return the same type for all members of T (as with std::visit).
+         * If the handle does not refer to a member, an std::runtime_error is thrown.
+         */
+        template <typename T, typename F>
+        decltype(auto) visit_member(T& target, member_handle<std::remove_cv_t<T>> handle, F&& f)
+        {
+            using type = std::remove_cv_t<T>;
+            static_assert(refl::trait::is_reflectable_v<type>, "Unsupported type!");
+            static_assert(member_list<type>::size > 0, "Type does not have any reflected members!");
+            using dispatch = detail::visit_dispatch<T, std::remove_reference_t<F>>;
+
+            if (handle.index() >= member_list<type>::size) {
+                throw std::runtime_error(std::string("The member handle does not refer to a member of ")
+                    + type_descriptor<type>::name.str() + "!");
             }
+            return dispatch::thunks[handle.index()](target, f);
         }
 
     } // namespace runtime
@@ -6,3 +6,4 @@
 #include "070-Descriptors.hpp"
 #include "080-Runtime.hpp"
 #include "090-StdTypes.hpp"
+#include "100-Layout.hpp"
@@ -55,4 +55,12 @@ TEST_CASE( "const string" ) {
         REQUIRE( make_const_string("Hello").rfind('l', 3) == 3 );
     }
 
+    SECTION( "hashing" ) {
+        static_assert( make_const_string().hash() == 0xcbf29ce484222325ull );
+        static_assert( make_const_string("a").hash() == 0xaf63dc4c8601ec8cull );
+        REQUIRE( hello.hash() == 0x63f0bfacf2c00f6bull );
+        REQUIRE( hello.hash() == (make_const_string("Hel") + "lo").hash() );
+        REQUIRE( hello.hash() != make_const_string("hello").hash() );
+    }
+
 }
\ No newline at end of file
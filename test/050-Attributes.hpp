@@ -77,6 +77,19 @@ REFL_AUTO(
     func(set_foo, property())
 )
 
+struct Tagged {
+    int id;
+    int name;
+    int untagged;
+};
+
+REFL_AUTO(
+    type(Tagged),
+    field(id, tag(1)),
+    field(name, tag{ 7 }),
+    field(untagged)
+)
+
 struct UnorderedProperties {
     int get_foo() const { return 0; }
     void set_foo(int) { }
@@ -208,6 +221,20 @@ TEST_CASE( "attributes" ) {
                 std::remove_const_t<decltype(get_foo_u)>> );
         }
 
+        SECTION( "tag" ) {
+            using id_t = trait::get_t<0, member_list<Tagged>>;
+            using name_t = trait::get_t<1, member_list<Tagged>>;
+            using untagged_t = trait::get_t<2, member_list<Tagged>>;
+
+            REQUIRE( has_tag(id_t{}) );
+            REQUIRE( has_tag(name_t{}) );
+            REQUIRE( !has_tag(untagged_t{}) );
+
+            static_assert(get_tag(id_t{}) == 1);
+            static_assert(get_tag(name_t{}) == 7);
+            REQUIRE( descriptor::get_attribute<attr::tag>(name_t{}).number == 7 );
+        }
+
     }
 
 }
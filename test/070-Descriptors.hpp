@@ -1,3 +1,5 @@
+#include <string>
+#include <vector>
 #include "refl.hpp"
 #include "extern/catch2/catch.hpp"
 
@@ -78,6 +80,48 @@ struct ShadowingDerived : public ShadowingBase {
 
 REFL_AUTO(type(ShadowingDerived, bases<ShadowingBase>), func(foo), field(bar))
 
+template <typename T>
+struct Versioned
+{
+    T value;
+    int32_t count;
+};
+
+REFL_AUTO(template((typename T), (Versioned<T>)), field(value), field(count))
+
+struct Tree
+{
+    int32_t value;
+    std::vector<Tree> children;
+    Tree* parent;
+};
+
+REFL_AUTO(type(Tree), field(value), field(children), field(parent))
+
+struct FingerprintTagged
+{
+    int32_t value;
+    int32_t count;
+    int32_t total;
+};
+
+REFL_AUTO(type(FingerprintTagged), field(value, attr::tag(1)), field(count), field(total, attr::tag(2)))
+
+// Wide only changes the types of the members which hold no data
+template <typename T, bool Wide>
+struct FingerprintRecord
+{
+    using wide_type = std::conditional_t<Wide, int64_t, int32_t>;
+
+    T get_value() const { return {}; }
+    void set_value(wide_type) {}
+    int32_t count;
+    static constexpr wide_type limit = 0;
+    wide_type twice() const { return count * 2; }
+};
+
+REFL_AUTO(template((typename T, bool Wide), (FingerprintRecord<T, Wide>)), func(get_value, property()), func(set_value, property()), field(count), field(limit), func(twice))
+
 TEST_CASE( "descriptors" ) {
     using namespace std::string_literals;
 
@@ -178,6 +222,15 @@ TEST_CASE( "descriptors" ) {
         REQUIRE( get_display_name_const(y_member) == "y" );
         REQUIRE( get_debug_name(y_member) == "Foo::y"s );
         REQUIRE( get_debug_name_const(y_member) == "Foo::y" );
+        REQUIRE( get_display_name_view(y_member) == "y" );
+        REQUIRE( get_debug_name_view(y_member) == "Foo::y" );
+        REQUIRE( get_debug_name_view(y_member).data() == get_debug_name(y_member) );
+        static_assert( get_name_hash(y_member) == make_const_string("y").hash() );
+        static_assert( decltype(y_member)::name_hash == get_name_hash(y_member) );
+        static_assert( type_descriptor<Foo>::name_hash == make_const_string("Foo").hash() );
+        static_assert( get_name_hash(trait::get_t<3, member_list<Foo>>{}) == trait::get_t<3, member_list<Foo>>::name.hash() );
+        static_assert( get_display_name_view(y_member) == "y" );
+        static_assert( get_display_name_view(type_descriptor<Foo>{}) == "Foo" );
         REQUIRE( std::is_same_v<decltype(get_reader(y_member)), std::remove_cv_t<decltype(y_member)>> );
         REQUIRE( std::is_same_v<decltype(get_writer(y_member)), std::remove_cv_t<decltype(y_member)>> );
         REQUIRE( invoke(y_member, Foo{}) == 0 );
@@ -225,4 +278,40 @@ TEST_CASE( "descriptors" ) {
         REQUIRE( m_td{}(0) == 3 );
     }
 
+    SECTION( "get_fingerprint" ) {
+        static_assert( get_fingerprint(reflect<Versioned<int32_t>>()) == get_fingerprint(reflect<Versioned<int32_t>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<int32_t>>()) == get_fingerprint(reflect<Versioned<const int32_t>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<int32_t>>()) != get_fingerprint(reflect<Versioned<uint32_t>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<int32_t>>()) != get_fingerprint(reflect<Versioned<int64_t>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<int32_t>>()) != get_fingerprint(reflect<Versioned<float>>()) );
+        // int64_t is long on some platforms and long long on others
+        static_assert( get_fingerprint(reflect<Versioned<long long>>()) == get_fingerprint(reflect<Versioned<int64_t>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<int32_t[3]>>()) == get_fingerprint(reflect<Versioned<std::array<int32_t, 3>>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<int32_t[3]>>()) != get_fingerprint(reflect<Versioned<int32_t[4]>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<std::vector<int16_t>>>()) != get_fingerprint(reflect<Versioned<std::vector<int32_t>>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<std::string>>()) != get_fingerprint(reflect<Versioned<std::wstring>>()) );
+        // the value types are compared through their members
+        static_assert( get_fingerprint(reflect<Versioned<ns::InNamespace>>()) != get_fingerprint(reflect<Versioned<ns::TemplateInNamespace<int>>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<ns::TemplateInNamespace<int>>>()) != get_fingerprint(reflect<Versioned<ns::TemplateInNamespace<short>>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<Versioned<int32_t>>>()) != get_fingerprint(reflect<Versioned<Versioned<uint32_t>>>()) );
+
+        // the fingerprint of a member depends on its name, tag and value type, but not on the type which declares it
+        constexpr auto versioned_count = trait::get_t<1, member_list<Versioned<float>>>{};
+        static_assert( get_fingerprint(versioned_count) == get_fingerprint(trait::get_t<1, member_list<Versioned<double>>>{}) );
+        static_assert( get_fingerprint(versioned_count) == get_fingerprint(trait::get_t<1, member_list<FingerprintTagged>>{}) );
+        static_assert( get_fingerprint(versioned_count) != get_fingerprint(trait::get_t<0, member_list<Tree>>{}) );
+        static_assert( get_fingerprint(trait::get_t<0, member_list<Versioned<int32_t>>>{}) == get_fingerprint(trait::get_t<0, member_list<Tree>>{}) );
+        static_assert( get_fingerprint(trait::get_t<0, member_list<Versioned<int32_t>>>{}) != get_fingerprint(trait::get_t<0, member_list<FingerprintTagged>>{}) );
+
+        // only fields and property getters (with their value types) make up the fingerprint
+        static_assert( get_fingerprint(reflect<FingerprintRecord<int32_t, false>>()) == get_fingerprint(reflect<FingerprintRecord<int32_t, true>>()) );
+        static_assert( get_fingerprint(reflect<FingerprintRecord<int32_t, false>>()) != get_fingerprint(reflect<FingerprintRecord<int64_t, false>>()) );
+        static_assert( get_fingerprint(reflect<FingerprintRecord<int32_t, false>>()) != get_fingerprint(reflect<FingerprintRecord<std::string, false>>()) );
+
+        // recursive types refer to themselves by depth
+        constexpr uint64_t tree = get_fingerprint(reflect<Tree>());
+        static_assert( tree != get_fingerprint(reflect<Versioned<Tree>>()) );
+        static_assert( get_fingerprint(reflect<Versioned<Tree>>()) != get_fingerprint(reflect<Versioned<Versioned<Tree>>>()) );
+        REQUIRE( tree != 0 );
+    }
 }
@@ -75,9 +75,138 @@ TEST_CASE( "runtime utils" ) {
         REQUIRE( runtime::debug_str(Bar{}).find("y = ") != std::string::npos );
     }
 
+    SECTION( "debug_to" ) {
+        BarBar bb;
+        bb.str = "\"quoted\\\"";
+        bb.bars[1].x = -42;
+        for (bool compact : { false, true }) {
+            std::string str;
+            runtime::debug_to(str, bb, compact);
+            REQUIRE( str == runtime::debug_str(bb, compact) );
+
+            std::vector<char> chars;
+            runtime::debug_to(chars, bb, compact);
+            REQUIRE( std::string(chars.begin(), chars.end()) == str );
+        }
+
+        std::string str = "> ";
+        runtime::debug_to(str, std::make_tuple(1.5, 0.1f, 1e-7, 123456789.0, true, 'c'));
+        REQUIRE( str == "> (1.5, 0.1, 1e-07, 1.23457e+08, true, c)" );
+
+        // strings are written in full, even when they end with a NUL, but string_views are cut at their first NUL
+        std::string nul("a\0b\0", 4);
+        str.clear();
+        runtime::debug_to(str, nul);
+        REQUIRE( str == runtime::debug_str(nul) );
+        REQUIRE( str.size() == 6 );
+        str.clear();
+        runtime::debug_to(str, std::string_view(nul));
+        REQUIRE( str == runtime::debug_str(std::string_view(nul)) );
+        REQUIRE( str == "\"a\"" );
+    }
+
+    SECTION( "debug_stream" ) {
+        std::vector<int> values(1000);
+        for (int i = 0; i < 1000; i++) values[i] = i;
+
+        std::string out;
+        std::vector<size_t> chunks;
+        auto sink = [&](const char* data, size_t size) {
+            out.append(data, size);
+            chunks.push_back(size);
+        };
+
+        runtime::debug_limits limits;
+        limits.chunk_size = 16;
+        REQUIRE( runtime::debug_stream(sink, values, limits, true) );
+        REQUIRE( out == runtime::debug_str(values, true) );
+        for (size_t i = 0; i + 1 < chunks.size(); i++) {
+            REQUIRE( chunks[i] == 16 );
+        }
+
+        out.clear();
+        limits.max_elements = 3;
+        REQUIRE( !runtime::debug_stream(sink, values, limits, true) );
+        REQUIRE( out == "[0, 1, 2, ...]" );
+
+        out.clear();
+        REQUIRE( !runtime::debug_stream(sink, values, limits) );
+        REQUIRE( out == "[\n    0, \n    1, \n    2, \n    ...\n]" );
+
+        out.clear();
+        limits.max_elements = static_cast<size_t>(-1);
+        limits.max_bytes = 100;
+        REQUIRE( !runtime::debug_stream(sink, values, limits, true) );
+        REQUIRE( out == runtime::debug_str(values, true).substr(0, 100) + "..." );
+
+        out.clear();
+        std::vector<BarBar> nested(2);
+        limits.max_bytes = static_cast<size_t>(-1);
+        limits.max_elements = 1;
+        REQUIRE( !runtime::debug_stream(sink, nested, limits, true) );
+        REQUIRE( out.find("bars = [Bar { x = 0, y = nullptr, z =") != std::string::npos );
+        REQUIRE( out.find(" }, ...] }, ...]") == out.size() - 16 );
+    }
+
     SECTION( "invoke" ) {
         REQUIRE( runtime::invoke<int>(Bar{}, "x", 1) == 1 );
+        REQUIRE( runtime::invoke<int>(Bar{}, "g", 1) == 0 );
         runtime::invoke<void>(Bar{}, "f");
+        runtime::invoke<void>(Bar{}, "f", 1);
+
+        REQUIRE_THROWS( runtime::invoke<int>(Bar{}, "w") );
+        REQUIRE_THROWS( runtime::invoke<int>(Bar{}, "xx") );
+        REQUIRE_THROWS( runtime::invoke<int>(Bar{}, "") );
+        REQUIRE_THROWS( runtime::invoke<int>(Bar{}, "g") );
+
+        // shadowed members are found in declaration order
+        REQUIRE( runtime::invoke<int>(ShadowingDerived{}, "bar") == 1 );
+        REQUIRE( runtime::invoke<int>(ShadowingDerived{}, "baz") == 0 );
+        REQUIRE( runtime::invoke<int>(ShadowingDerived{}, "foo") == 1 );
+    }
+
+    SECTION( "find_member" ) {
+        auto x = runtime::find_member<Bar>("x");
+        REQUIRE( x );
+        REQUIRE( x.index() == 0 );
+        REQUIRE( x.kind() == runtime::member_kind::field );
+
+        auto g = runtime::find_member<Bar>(std::string("g"));
+        REQUIRE( g.index() == 4 );
+        REQUIRE( g.kind() == runtime::member_kind::function );
+
+        REQUIRE( !runtime::find_member<Bar>("w") );
+        REQUIRE( !runtime::find_member<Bar>("") );
+        REQUIRE( runtime::find_member<Bar>("w").kind() == runtime::member_kind::none );
+        REQUIRE( runtime::find_member<ShadowingDerived>("bar").index() == 1 );
+    }
+
+    SECTION( "visit_member" ) {
+        Bar bar{};
+        auto z = runtime::find_member<Bar>("z");
+        auto name = runtime::visit_member(bar, z, [](auto member, auto&) { return get_debug_name_view(member); });
+        REQUIRE( name == "Bar::z" );
+
+        auto x = runtime::find_member<Bar>("x");
+        runtime::visit_member(bar, x, [](auto member, Bar& target) {
+            if constexpr (std::is_invocable_v<decltype(member), Bar&, int>) {
+                member(target, 42);
+            }
+        });
+        REQUIRE( bar.x == 42 );
+
+        const Bar& cbar = bar;
+        int value = runtime::visit_member(cbar, x, [](auto member, const Bar& target) {
+            if constexpr (std::is_same_v<decltype(member), field_descriptor<Bar, 0>>) {
+                return member(target);
+            }
+            else {
+                return -1;
+            }
+        });
+        REQUIRE( value == 42 );
+
+        REQUIRE_THROWS( runtime::visit_member(bar, runtime::member_handle<Bar>{}, [](auto, auto&) {}) );
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "refl.hpp"
+#include "extern/catch2/catch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+using namespace refl;
+
+struct LayoutEntry
+{
+    bool valid;
+    double value;
+    int32_t id;
+    char code[3];
+};
+
+REFL_AUTO(type(LayoutEntry), field(valid), field(value), field(id), field(code))
+
+struct LayoutDense
+{
+    int64_t a;
+    int32_t b;
+    int16_t c;
+    uint8_t d, e;
+    static int count;
+};
+
+int LayoutDense::count = 0;
+
+REFL_AUTO(type(LayoutDense), field(a), field(b), field(c), field(d), field(e), field(count))
+
+struct LayoutPartial
+{
+    int32_t reflected;
+    int32_t hidden;
+};
+
+REFL_AUTO(type(LayoutPartial), field(reflected))
+
+struct LayoutWithString
+{
+    char tag;
+    std::string text;
+    const int16_t version = 3;
+};
+
+REFL_AUTO(type(LayoutWithString), field(tag), field(text), field(version))
+
+TEST_CASE( "layout" ) {
+
+    SECTION( "fields" ) {
+        constexpr auto entry = layout::fields<LayoutEntry>();
+        static_assert(entry.size() == 4);
+        static_assert(entry[0].offset == offsetof(LayoutEntry, valid) && entry[0].padding_before == 0);
+        static_assert(entry[1].offset == offsetof(LayoutEntry, value) && entry[1].padding_before == 7);
+        static_assert(entry[2].offset == offsetof(LayoutEntry, id) && entry[2].size == 4 && entry[2].alignment == 4);
+        static_assert(entry[3].offset == offsetof(LayoutEntry, code) && entry[3].size == 3 && entry[3].alignment == 1);
+        REQUIRE(std::strcmp(entry[1].name, "value") == 0);
+
+        // static fields are not part of the layout
+        static_assert(layout::fields<LayoutDense>().size() == 5);
+        static_assert(layout::fields<LayoutDense>()[4].offset == offsetof(LayoutDense, e));
+        static_assert(layout::fields<LayoutWithString>()[1].offset == offsetof(LayoutWithString, text));
+    }
+
+    SECTION( "is_complete" ) {
+        static_assert(layout::is_complete<LayoutEntry>());
+        static_assert(layout::is_complete<LayoutDense>());
+        static_assert(layout::is_complete<LayoutWithString>());
+        static_assert(!layout::is_complete<LayoutPartial>());
+    }
+
+    SECTION( "padding" ) {
+        static_assert(layout::padding<LayoutEntry>() == sizeof(LayoutEntry) - 16);
+        static_assert(layout::tail_padding<LayoutEntry>() == sizeof(LayoutEntry) - 23);
+        static_assert(!layout::has_no_padding<LayoutEntry>());
+        static_assert(layout::has_no_padding<LayoutDense>());
+        static_assert(layout::tail_padding<LayoutDense>() == 0);
+        // fields which are not reflected count as padding
+        static_assert(layout::padding<LayoutPartial>() == 4 && !layout::has_no_padding<LayoutPartial>());
+    }
+
+    SECTION( "packed_size" ) {
+        static_assert(layout::packed_size<LayoutEntry>() == 16);
+        static_assert(layout::packed_size<LayoutDense>() == sizeof(LayoutDense));
+        static_assert(sizeof(layout::packed<LayoutEntry>) == layout::packed_size<LayoutEntry>());
+        static_assert(sizeof(layout::packed<LayoutDense>) == sizeof(LayoutDense));
+        static_assert(sizeof(layout::packed<LayoutWithString>) == layout::packed_size<LayoutWithString>());
+    }
+
+    SECTION( "packed" ) {
+        using entry_fields = layout::packed<LayoutEntry>::fields;
+        LayoutEntry entry{ true, 2.5, 42, { 'a', 'b', 'c' } };
+        layout::packed<LayoutEntry> packed(entry);
+        REQUIRE(packed.get(trait::get_t<0, entry_fields>{}) == true);
+        REQUIRE(packed.get(trait::get_t<1, entry_fields>{}) == 2.5);
+        REQUIRE(packed.get(trait::get_t<3, entry_fields>{})[2] == 'c');
+
+        packed.get(trait::get_t<2, entry_fields>{}) = 7;
+        LayoutEntry copy = packed.unpack();
+        REQUIRE(copy.valid == true);
+        REQUIRE(copy.value == 2.5);
+        REQUIRE(copy.id == 7);
+        REQUIRE(std::memcmp(copy.code, "abc", 3) == 0);
+
+        // the fields are stored by decreasing alignment
+        const auto& stored = packed;
+        auto base = reinterpret_cast<uintptr_t>(&stored);
+        REQUIRE(reinterpret_cast<uintptr_t>(&stored.get(trait::get_t<1, entry_fields>{})) - base == 0);
+        REQUIRE(reinterpret_cast<uintptr_t>(&stored.get(trait::get_t<2, entry_fields>{})) - base == 8);
+        REQUIRE(reinterpret_cast<uintptr_t>(&stored.get(trait::get_t<0, entry_fields>{})) - base == 12);
+
+        // const fields are copied in, but not out
+        using string_fields = layout::packed<LayoutWithString>::fields;
+        LayoutWithString value;
+        value.tag = 'x';
+        value.text = "text";
+        layout::packed<LayoutWithString> packed_string(value);
+        REQUIRE(packed_string.get(trait::get_t<1, string_fields>{}) == "text");
+        REQUIRE(packed_string.get(trait::get_t<2, string_fields>{}) == 3);
+        LayoutWithString target;
+        packed_string.unpack(target);
+        REQUIRE(target.tag == 'x');
+        REQUIRE(target.text == "text");
+    }
+}